@@ -0,0 +1,233 @@
+#include "AllpassDiffuser.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+/**
+ * @brief Constructs the nested allpass cascade.
+ *
+ * Delay selection mirrors the DVN it replaces:
+ * - Inner delays start at the DVN grid spacing Td = fs / p, so the first
+ *   echoes arrive with the same spacing as the velvet pulses.
+ * - Outer delays grow geometrically from L/16 to L/4, where L = M / p is the
+ *   length of the DVN sequence, so the diffuse build-up covers a similar span.
+ *
+ * Each lane jitters every delay by up to ±15% to keep channels decorrelated.
+ *
+ * The cascade is lossless, while DVNConvolver scales its M pulses (each a
+ * run of width w in [Td / 2, Td] at amplitude 1) by 1 / (M * W)^(19/30),
+ * W = Td / 2 + 1 widths. The output gain is that scale times the square root
+ * of the sequence energy M * (Td / 2 + Td) / 2, so both engines pass noise
+ * at the same level; the RRS leak (1 / 4096 per sample) is neglected.
+ *
+ * @param N Number of audio channels.
+ * @param M Number of pulses of the equivalent DVN sequence.
+ * @param p Pulse density (pulses per second) of the equivalent DVN.
+ * @param blockSize Maximum audio block size (chunk length of process()).
+ * @param fs Sample rate in Hz.
+ * @param seed Seed for the per-lane delay jitter.
+ * @throws std::invalid_argument if N < 1 or p < 1.
+ */
+AllpassDiffuser::AllpassDiffuser(int N, int M, int p, int blockSize, double fs, uint32_t seed)
+    : N(N), maxBlockSize(std::max(1, blockSize))
+{
+    if (N < 1)
+        throw std::invalid_argument("Number of channels must be at least 1.");
+    if (p < 1)
+        throw std::invalid_argument("Pulse density must be at least 1.");
+
+    numLanes = ((N + lanes - 1) / lanes) * lanes;
+
+    outerGain = 0.6f;
+    innerGain = 0.5f;
+
+    // Same grid as DVNConvolver
+    const int grid = static_cast<int>(fs / static_cast<double>(p));
+    const int wmin = grid / 2;
+    const int wmax = grid;
+    const double dvnScale = 1.0 / std::pow(static_cast<double>(M) * (wmax - wmin + 1), 19.0 / 30.0);
+    outputGain = static_cast<float>(dvnScale * std::sqrt(static_cast<double>(M) * 0.5 * (wmin + wmax)));
+
+    const double Td = fs / static_cast<double>(p);
+    const double span = static_cast<double>(M) / static_cast<double>(p) * fs;
+
+    static constexpr double innerRatios[numSections] = { 1.00, 1.37, 1.83, 2.41 };
+    const double outerStep = std::pow(4.0, 1.0 / (numSections - 1));
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> jitter(0.85, 1.15);
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        const double outerBase = std::max(span / 16.0 * std::pow(outerStep, s), 2.0 * Td);
+        const double innerBase = Td * innerRatios[s];
+
+        outerDelay[s].assign(numLanes, 1);
+        innerDelay[s].assign(numLanes, 1);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            outerDelay[s][lane] = std::max(1, static_cast<int>(std::round(outerBase * jitter(gen))));
+            innerDelay[s][lane] = std::max(1, static_cast<int>(std::round(innerBase * jitter(gen))));
+        }
+
+        outer[s] = makeRing(*std::max_element(outerDelay[s].begin(), outerDelay[s].end()));
+        inner[s] = makeRing(*std::max_element(innerDelay[s].begin(), innerDelay[s].end()));
+    }
+
+    group.resize(static_cast<size_t>(maxBlockSize) * lanes, 0.0f);
+}
+
+/**
+ * @brief Allocates a power-of-two ring holding at least maxDelay + 1 frames.
+ * @param maxDelay Largest delay that will be read from the ring.
+ * @return Zero-initialized ring.
+ */
+AllpassDiffuser::Ring AllpassDiffuser::makeRing(int maxDelay) const
+{
+    int size = 1;
+    while (size < maxDelay + 1)
+        size <<= 1;
+
+    Ring ring;
+    ring.data.resize(static_cast<size_t>(size) * numLanes, 0.0f);
+    ring.mask = size - 1;
+    ring.write = 0;
+    return ring;
+}
+
+/**
+ * @brief Processes an audio buffer through the nested allpass cascade.
+ *
+ * The buffer is processed in chunks of up to maxBlockSize frames. For each
+ * group of 8 channels the chunk is copied into the group buffer, then every
+ * section runs over the whole chunk before the next one starts:
+ * 1. Read the outer delay output v[n - D] and pass it through the inner allpass.
+ * 2. Outer allpass: v[n] = x[n] + g·u[n], y[n] = u[n] - g·v[n].
+ * 3. The section output overwrites its input and feeds the next section.
+ * Each section only depends on its own past and on the previous section's
+ * output at the same frame, so this gives the same bits as running all
+ * sections sample by sample. Lanes beyond N are processed with silent
+ * input and discarded; the output is scaled by outputGain.
+ *
+ * @param buffer Audio buffer to process in-place. Must contain at least N channels.
+ */
+void AllpassDiffuser::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    float* const* channels = buffer.getArrayOfWritePointers();
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int count = std::min(maxBlockSize, numSamples - start);
+
+        for (int base = 0; base < numLanes; base += lanes)
+        {
+            float* x = group.data();
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const float* in = base + lane < N ? channels[base + lane] + start : nullptr;
+                for (int n = 0; n < count; ++n)
+                    x[n * lanes + lane] = in != nullptr ? in[n] : 0.0f;
+            }
+
+            for (int s = 0; s < numSections; ++s)
+            {
+                float* outerData = outer[s].data.data();
+                float* innerData = inner[s].data.data();
+                const int* dOuter = outerDelay[s].data() + base;
+                const int* dInner = innerDelay[s].data() + base;
+                const int outerMask = outer[s].mask;
+                const int innerMask = inner[s].mask;
+                int outerWrite = outer[s].write;
+                int innerWrite = inner[s].write;
+
+                for (int n = 0; n < count; ++n)
+                {
+                    float* xn = x + n * lanes;
+                    float* outerOut = outerData + static_cast<size_t>(outerWrite) * numLanes + base;
+                    float* innerOut = innerData + static_cast<size_t>(innerWrite) * numLanes + base;
+
+                    for (int lane = 0; lane < lanes; ++lane)
+                    {
+                        const float vD = outerData[static_cast<size_t>((outerWrite - dOuter[lane]) & outerMask) * numLanes + base + lane];
+                        const float wD = innerData[static_cast<size_t>((innerWrite - dInner[lane]) & innerMask) * numLanes + base + lane];
+
+                        // Inner allpass on the outer delay output
+                        const float w = vD + innerGain * wD;
+                        const float u = wD - innerGain * w;
+                        innerOut[lane] = w;
+
+                        // Outer allpass
+                        const float v = xn[lane] + outerGain * u;
+                        xn[lane] = u - outerGain * v;
+                        outerOut[lane] = v;
+                    }
+
+                    outerWrite = (outerWrite + 1) & outerMask;
+                    innerWrite = (innerWrite + 1) & innerMask;
+                }
+            }
+
+            for (int lane = 0; lane < lanes && base + lane < N; ++lane)
+            {
+                float* out = channels[base + lane] + start;
+                for (int n = 0; n < count; ++n)
+                    out[n] = x[n * lanes + lane] * outputGain;
+            }
+        }
+
+        // Advance all rings (shared write position across lane groups)
+        for (int s = 0; s < numSections; ++s)
+        {
+            outer[s].write = (outer[s].write + count) & outer[s].mask;
+            inner[s].write = (inner[s].write + count) & inner[s].mask;
+        }
+    }
+}
+
+/**
+ * @brief Zeroes the outer and inner rings of every section.
+ */
+void AllpassDiffuser::reset()
+{
+    for (int s = 0; s < numSections; ++s)
+    {
+        for (Ring* ring : { &outer[s], &inner[s] })
+        {
+            std::fill(ring->data.begin(), ring->data.end(), 0.0f);
+            ring->write = 0;
+        }
+    }
+}
+
+/**
+ * @brief Reports the section rings and delay tables.
+ */
+void AllpassDiffuser::visitMemory(const EngineMemory::Visitor& visit)
+{
+    for (int s = 0; s < numSections; ++s)
+    {
+        EngineMemory::visit(visit, outer[s].data);
+        EngineMemory::visit(visit, inner[s].data);
+        EngineMemory::visit(visit, outerDelay[s]);
+        EngineMemory::visit(visit, innerDelay[s]);
+    }
+    EngineMemory::visit(visit, group);
+}
+
+/**
+ * @brief Reports both rings of every section with their write positions.
+ */
+void AllpassDiffuser::visitState(const EngineState::Visitor& visit)
+{
+    for (int s = 0; s < numSections; ++s)
+    {
+        for (Ring* ring : { &outer[s], &inner[s] })
+        {
+            EngineState::visit(visit, ring->data);
+            EngineState::visit(visit, ring->write);
+        }
+    }
+}
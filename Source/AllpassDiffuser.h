@@ -0,0 +1,117 @@
+#pragma once
+
+// Standard library
+#include <vector>
+#include <cstdint>
+
+// JUCE
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Project headers
+#include "EngineMemory.h"
+#include "EngineState.h"
+
+/**
+ * @class AllpassDiffuser
+ * @brief Low-cost diffuser built from nested Schroeder allpass sections.
+ *
+ * Drop-in alternative to the DVN engine of Diffuser. Every channel runs the
+ * same cascade of nested allpass sections (an outer allpass whose delay
+ * contains an inner allpass), with per-channel jittered delays for
+ * decorrelation. Channels run in groups of 8 with their delay memory
+ * interleaved, one section at a time over the whole block, so a section's
+ * rings stay in cache. Every lane has its own delays, so the reads of a
+ * group are gathers rather than vector loads; the engine is cheap because
+ * it does a few operations per sample, not because of vector width.
+ *
+ * Delays are derived from the DVN parameters it replaces: inner delays start
+ * at the DVN grid spacing Td = fs / p (same initial echo spacing), and outer
+ * delays span up to the DVN sequence length M / p. The output is scaled to
+ * the energy gain of that DVN (an allpass cascade has unit gain), so
+ * switching engines keeps the wet level.
+ */
+class AllpassDiffuser
+{
+public:
+    static constexpr int lanes = 8;     ///< Channels processed together per group
+    static constexpr int numSections = 4; ///< Nested allpass sections in the cascade
+
+    /**
+     * @brief Constructs the allpass cascade.
+     * @param N Number of audio channels.
+     * @param M Number of pulses of the equivalent DVN sequence.
+     * @param p Pulse density (pulses per second) of the equivalent DVN.
+     * @param blockSize Maximum audio block size (longer buffers are processed in chunks).
+     * @param fs Sample rate in Hz.
+     * @param seed Seed for the per-lane delay jitter.
+     * @throws std::invalid_argument if N < 1 or p < 1.
+     */
+    AllpassDiffuser(int N, int M, int p, int blockSize, double fs, uint32_t seed = 0);
+
+    /** @brief Default constructor (produces an empty, uninitialized diffuser). */
+    AllpassDiffuser() = default;
+
+    /** @brief Destructor. */
+    ~AllpassDiffuser() = default;
+
+    // Copy operations are deleted to prevent accidental deep copies
+    AllpassDiffuser(const AllpassDiffuser&) = delete;
+    AllpassDiffuser& operator=(const AllpassDiffuser&) = delete;
+
+    // Move operations are defaulted (safe for internal buffers)
+    AllpassDiffuser(AllpassDiffuser&&) noexcept = default;
+    AllpassDiffuser& operator=(AllpassDiffuser&&) noexcept = default;
+
+    /**
+     * @brief Processes an audio buffer in-place.
+     * @param buffer Audio buffer with at least N channels.
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Clears the delay memory of every section (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this diffuser.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the section rings and their write positions (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+private:
+    /**
+     * @struct Ring
+     * @brief Power-of-two ring buffer interleaved as [position][lane].
+     */
+    struct Ring
+    {
+        std::vector<float> data; ///< Interleaved samples (size * numLanes)
+        int mask = 0;            ///< size - 1
+        int write = 0;           ///< Current write position
+    };
+
+    /** @brief Allocates a ring able to hold maxDelay samples per lane. */
+    Ring makeRing(int maxDelay) const;
+
+    int N = 0;            ///< Number of channels
+    int numLanes = 0;     ///< N rounded up to a multiple of lanes
+    int maxBlockSize = 0; ///< Frames per chunk of the group buffer
+
+    float outerGain = 0.0f; ///< Outer allpass coefficient
+    float innerGain = 0.0f; ///< Inner allpass coefficient
+    float outputGain = 0.0f; ///< Energy gain of the equivalent DVN
+
+    Ring outer[numSections];                 ///< Outer section delay memory
+    Ring inner[numSections];                 ///< Inner section delay memory
+    std::vector<int> outerDelay[numSections]; ///< Per-lane outer delays
+    std::vector<int> innerDelay[numSections]; ///< Per-lane inner delays
+
+    std::vector<float> group; ///< One lane group over a chunk, interleaved as [frame][lane]
+};
@@ -0,0 +1,170 @@
+#include "Autotuner.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief CPU model plus logical core count, e.g. "AMD Ryzen 9 7950X / 32".
+ */
+juce::String Autotuner::getMachineKey()
+{
+    return juce::SystemStats::getCpuModel().trim() + " / " + juce::String(juce::SystemStats::getNumCpus());
+}
+
+/**
+ * @brief Per-user "Umbra/Autotune.settings".
+ */
+juce::PropertiesFile::Options Autotuner::getFileOptions()
+{
+    juce::PropertiesFile::Options options;
+    options.applicationName = "Autotune";
+    options.folderName = "Umbra";
+    options.filenameSuffix = ".settings";
+    options.osxLibrarySubFolder = "Application Support";
+    options.commonToAllUsers = false;
+    options.processLock = nullptr;
+    return options;
+}
+
+/**
+ * @brief Renders automated noise through each candidate.
+ *
+ * Steps:
+ * 1. Build the candidate list. Thread counts only matter for DVN
+ *    diffusers, so other engines get a single serial candidate.
+ * 2. Per candidate, build a Reverb (fixed seed) and process config.seconds
+ *    of noise in host callbacks with process(), switching room size,
+ *    dampening and mix every 8 callbacks so the coefficient updates are
+ *    included. process() hands the diffusers whole blocks; the control-rate
+ *    sub-blocks of processRamp() always run them serially (see
+ *    Diffuser::minParallelSamples), so they would not tell the candidates
+ *    apart. The first 10 callbacks are not timed.
+ * 3. Rank by p99 callback time (mean as tie-breaker).
+ *
+ * @param config Benchmark setup.
+ * @return Measured candidates and the winner.
+ * @throws std::invalid_argument if the block size or length is not positive.
+ */
+Autotuner::Result Autotuner::run(const Config& config)
+{
+    const int callbacks = static_cast<int>(config.seconds * config.fs / config.blockSize);
+    if (config.blockSize < 1 || callbacks < 1)
+        throw std::invalid_argument("Autotune block size and length must be positive.");
+
+    // Step 1: candidates
+    const bool usesDvn = config.options.d1Engine == Diffuser::Engine::DVN
+        || config.options.d2Engine == Diffuser::Engine::DVN
+        || config.options.d3Engine == Diffuser::Engine::DVN;
+
+    std::vector<int> threadCounts = config.threadCounts;
+    if (!usesDvn)
+        threadCounts = { 1 };
+    else if (threadCounts.empty())
+    {
+        const int cpus = juce::jmax(1, juce::SystemStats::getNumCpus());
+        for (int n = 1; n < cpus && n < 8; n *= 2)
+            threadCounts.push_back(n);
+        threadCounts.push_back(juce::jmin(cpus, 8)); // one per channel at most
+    }
+
+    Result result;
+    result.machine = getMachineKey();
+
+    // Shared input, generated once
+    const int warmup = 10;
+    juce::AudioBuffer<float> noise(2, config.blockSize * (callbacks + warmup));
+    juce::Random random(1);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int n = 0; n < noise.getNumSamples(); ++n)
+            noise.setSample(ch, n, random.nextFloat() * 0.5f - 0.25f);
+
+    ReverbParameters low, high;
+    low.roomSize = 0.5f;
+    low.dampening = 3000.0f;
+    low.mix = 0.3f;
+    high.roomSize = 1.5f;
+    high.dampening = 12000.0f;
+    high.mix = 0.7f;
+
+    // Step 2: measure
+    juce::AudioBuffer<float> block(2, config.blockSize);
+    std::vector<double> times(static_cast<size_t>(callbacks));
+
+    for (int threads : threadCounts)
+    {
+        if (juce::Thread::currentThreadShouldExit())
+            return result;
+
+        ReverbOptions options = config.options;
+        options.seed = 1;
+        options.diffuserThreads = threads;
+        Reverb reverb(static_cast<float>(config.fs), config.blockSize, options);
+        reverb.waitForFrozenGrid();
+
+        for (int i = 0; i < callbacks + warmup; ++i)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                block.copyFrom(ch, 0, noise, ch, i * config.blockSize, config.blockSize);
+
+            const bool up = (i / 8) % 2 == 0;
+            const auto before = juce::Time::getHighResolutionTicks();
+            reverb.process(block, up ? high : low);
+            const auto after = juce::Time::getHighResolutionTicks();
+
+            if (i >= warmup)
+                times[static_cast<size_t>(i - warmup)] = juce::Time::highResolutionTicksToSeconds(after - before);
+        }
+
+        Candidate candidate;
+        candidate.diffuserThreads = threads;
+
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+        candidate.meanMicros = 1.0e6 * sum / callbacks;
+
+        const auto p99 = times.begin() + (callbacks - 1) * 99 / 100;
+        std::nth_element(times.begin(), p99, times.end());
+        candidate.p99Micros = 1.0e6 * *p99;
+
+        result.candidates.push_back(candidate);
+    }
+
+    // Step 3: rank
+    result.best = *std::min_element(result.candidates.begin(), result.candidates.end(),
+        [](const Candidate& a, const Candidate& b)
+        {
+            return a.p99Micros != b.p99Micros ? a.p99Micros < b.p99Micros : a.meanMicros < b.meanMicros;
+        });
+    result.complete = true;
+    return result;
+}
+
+/**
+ * @brief Writes "<machine>.diffuserThreads".
+ */
+bool Autotuner::save(const Result& result)
+{
+    if (!result.complete)
+        return false;
+
+    juce::PropertiesFile file(getFileOptions());
+    file.setValue(result.machine + ".diffuserThreads", result.best.diffuserThreads);
+    return file.saveIfNeeded();
+}
+
+/**
+ * @brief Reads this machine's entry, if present.
+ *
+ * Files written before the sub-block length was dropped from the search
+ * may also hold "<machine>.microBlockSize"; it is ignored.
+ */
+bool Autotuner::load(ReverbOptions& options)
+{
+    juce::PropertiesFile file(getFileOptions());
+    const auto machine = getMachineKey();
+    if (!file.containsKey(machine + ".diffuserThreads"))
+        return false;
+
+    options.diffuserThreads = file.getIntValue(machine + ".diffuserThreads");
+    return true;
+}
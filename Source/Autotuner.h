@@ -0,0 +1,107 @@
+#pragma once
+
+// Standard library
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "Reverb.h"
+
+/**
+ * @class Autotuner
+ * @brief Picks the fastest DVN diffuser thread count for this machine.
+ *
+ * The OpenMP team size leaves the sound unchanged, but which size is
+ * fastest depends on the core count and cache layout. The autotuner
+ * renders the same automated noise through every candidate
+ * ReverbOptions::diffuserThreads in host-sized callbacks, and keeps the one
+ * with the lowest 99th percentile callback time.
+ *
+ * The winner is stored in a per-user settings file (Umbra/Autotune.settings)
+ * under a key made of the CPU model and core count, and load() applies it
+ * to the options before a Reverb is built. Runs are started explicitly
+ * (UmbraCLI autotune), never by the plugin. The sub-block length is not
+ * tuned: longer sub-blocks always measure faster but coarsen automation,
+ * and deterministic renders fix it anyway. Engine and storage choices are
+ * not tuned either, since they change the sound.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class Autotuner
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    Autotuner() = delete;
+
+    /**
+     * @struct Config
+     * @brief Benchmark setup.
+     */
+    struct Config
+    {
+        double fs = 48000.0;     ///< Sample rate in Hz
+        int blockSize = 512;     ///< Host callback size
+        double seconds = 1.0;    ///< Audio rendered per candidate
+        ReverbOptions options;   ///< Engine options the candidates start from
+        std::vector<int> threadCounts;  ///< Candidates (empty = 1, 2, 4, ... up to the CPU count)
+    };
+
+    /**
+     * @struct Candidate
+     * @brief One measured configuration.
+     */
+    struct Candidate
+    {
+        int diffuserThreads = 0; ///< ReverbOptions::diffuserThreads
+        double meanMicros = 0.0; ///< Mean callback time
+        double p99Micros = 0.0;  ///< 99th percentile callback time (ranking key)
+    };
+
+    /**
+     * @struct Result
+     * @brief All candidates and the winner.
+     */
+    struct Result
+    {
+        juce::String machine;              ///< Settings key of this machine
+        std::vector<Candidate> candidates; ///< Measured configurations
+        Candidate best;                    ///< Lowest p99 callback time
+        bool complete = false;             ///< False if the run was cancelled
+    };
+
+    /**
+     * @brief Key the results are stored under (CPU model and core count).
+     */
+    static juce::String getMachineKey();
+
+    /**
+     * @brief Benchmarks every candidate.
+     * @param config Benchmark setup.
+     * @return Measured candidates; stops early (complete = false) if the
+     *         calling juce::Thread is asked to exit.
+     * @throws std::invalid_argument if the block size or length is not positive.
+     */
+    static Result run(const Config& config);
+
+    /**
+     * @brief Stores the winner for this machine.
+     * @param result Completed autotune run.
+     * @return True if the settings file was written.
+     */
+    static bool save(const Result& result);
+
+    /**
+     * @brief Applies this machine's stored winner.
+     * @param options Options to update (diffuserThreads).
+     * @return False if nothing is stored for this machine (options unchanged).
+     */
+    static bool load(ReverbOptions& options);
+
+private:
+    /** @brief Settings file location shared by load() and save(). */
+    static juce::PropertiesFile::Options getFileOptions();
+};
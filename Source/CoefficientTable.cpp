@@ -0,0 +1,68 @@
+#include "CoefficientTable.h"
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Designs the low-pass, high-pass and one-pole tables.
+ *
+ * Grid point i sits at the float whose bit pattern is minFrequency's plus
+ * i grid steps, i.e. pointsPerOctave points per octave, evenly spaced in
+ * the mantissa within each octave. The table runs one point past the
+ * interval holding 0.49 * fs; points above it are designed at 0.49 * fs,
+ * so lookups at the clamp are exact and nothing is designed at or beyond
+ * Nyquist.
+ *
+ * @param fs Sample rate in Hz.
+ * @throws std::invalid_argument if fs is too low for the grid.
+ */
+CoefficientTable::CoefficientTable(double fs)
+    : fs(fs), maxFrequency(static_cast<float>(0.49 * fs))
+{
+    if (!(maxFrequency > 2.0f * minFrequency))
+        throw std::invalid_argument("Sample rate is too low for the coefficient table.");
+
+    const int size = locate(maxFrequency).index + 2;
+    lowPassTable.resize(size);
+    highPassTable.resize(size);
+    onePoleTable.resize(size);
+
+    const double invQ = juce::MathConstants<double>::sqrt2; // Butterworth: 1 / Q = sqrt(2)
+
+    for (int i = 0; i < size; ++i)
+    {
+        const double f = juce::jmin(static_cast<double>(gridFrequency(i)), static_cast<double>(maxFrequency));
+        const double K = std::tan(juce::MathConstants<double>::pi * f / fs);
+
+        // juce::IIRCoefficients::makeLowPass with n = 1 / K, kept in double
+        const double n = 1.0 / K;
+        const double lp = 1.0 / (1.0 + invQ * n + n * n);
+        lowPassTable[i] = { lp, 2.0 * lp, lp, 2.0 * lp * (1.0 - n * n), lp * (1.0 - invQ * n + n * n) };
+
+        // juce::IIRCoefficients::makeHighPass with n = K
+        const double hp = 1.0 / (1.0 + invQ * K + K * K);
+        highPassTable[i] = { hp, -2.0 * hp, hp, 2.0 * hp * (K * K - 1.0), hp * (1.0 - invQ * K + K * K) };
+
+        onePoleTable[i] = (K - 1.0) / (K + 1.0);
+    }
+}
+
+/**
+ * @brief Frequency of grid point i (the inverse of locate() at fraction 0).
+ */
+float CoefficientTable::gridFrequency(int i)
+{
+    const uint32_t bits = bitsOf(minFrequency) + (static_cast<uint32_t>(i) << fractionBits);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief Reports the three tables.
+ */
+void CoefficientTable::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, lowPassTable);
+    EngineMemory::visit(visit, highPassTable);
+    EngineMemory::visit(visit, onePoleTable);
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "EngineMemory.h"
+
+/**
+ * @class CoefficientTable
+ * @brief Filter coefficients precomputed over a log-frequency grid for one sample rate.
+ *
+ * Designing a biquad takes a tan and several divisions per call, which makes
+ * fast modulation of the cutoffs expensive. The table designs the filters
+ * the engine uses once, when the engine is built, at pointsPerOctave
+ * frequencies per octave from minFrequency up to 0.49 * fs:
+ * - Butterworth low-pass and high-pass biquads (the designs of
+ *   juce::IIRCoefficients::makeLowPass / makeHighPass, normalized to a0 = 1);
+ * - the bilinear one-pole coefficient (K - 1) / (K + 1), K = tan(pi f / fs),
+ *   shared by first-order shelves. Unlike K it stays within [-1, 1] and is
+ *   smooth up to Nyquist, so it interpolates well; shelves follow from it
+ *   without K (see FDN).
+ *
+ * A lookup linearly interpolates between the two neighbouring grid points.
+ * The grid position comes straight from the float's bit pattern (exponent
+ * = octave, top mantissa bits = step within the octave), so a lookup is a
+ * clamp, a few integer ops and one lerp per coefficient: no transcendental
+ * math, no division, no allocation. The tables hold doubles and a lookup
+ * rounds to float once, as a direct design would; at low cutoffs the poles
+ * sit so close to z = 1 that a float lerp's extra rounding would be
+ * audible. Grid points give the exact designs. Between them the
+ * coefficients are a convex combination of two stable biquads, which is
+ * stable again (the stability triangle is convex).
+ */
+class CoefficientTable
+{
+public:
+    static constexpr float minFrequency = 8.0f; ///< Lowest grid frequency in Hz (a power of two)
+    static constexpr int octaveBits = 5;        ///< log2 of the grid points per octave
+    static constexpr int pointsPerOctave = 1 << octaveBits; ///< Grid resolution
+
+    /**
+     * @struct Biquad
+     * @brief Normalized biquad coefficients (a0 = 1).
+     */
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; ///< Coefficients (a0 = 1)
+    };
+
+    /**
+     * @brief Designs every table for one sample rate.
+     * @param fs Sample rate in Hz.
+     * @throws std::invalid_argument if 0.49 * fs is not above 2 * minFrequency.
+     */
+    explicit CoefficientTable(double fs);
+
+    /** @brief Default constructor (empty table; lookups must not be called). */
+    CoefficientTable() = default;
+
+    /** @brief Sample rate the tables were designed for. */
+    double getSampleRate() const { return fs; }
+
+    /** @brief Highest frequency a lookup resolves (0.49 * fs); higher values are clamped. */
+    float getMaxFrequency() const { return maxFrequency; }
+
+    /**
+     * @brief Butterworth low-pass at a cutoff.
+     * @param frequency Cutoff in Hz (clamped to [minFrequency, getMaxFrequency()]; NaN gives minFrequency).
+     */
+    Biquad lowPass(float frequency) const { return lerp(lowPassTable, locate(frequency)); }
+
+    /**
+     * @brief Butterworth high-pass at a cutoff.
+     * @param frequency Cutoff in Hz (clamped to [minFrequency, getMaxFrequency()]; NaN gives minFrequency).
+     */
+    Biquad highPass(float frequency) const { return lerp(highPassTable, locate(frequency)); }
+
+    /**
+     * @brief Bilinear one-pole coefficient a1 = (K - 1) / (K + 1), K = tan(pi f / fs).
+     * @param frequency Corner frequency in Hz (clamped to [minFrequency, getMaxFrequency()]; NaN gives minFrequency).
+     */
+    float onePole(float frequency) const
+    {
+        const Position p = locate(frequency);
+        const double lo = onePoleTable[p.index];
+        return static_cast<float>(lo + p.fraction * (onePoleTable[p.index + 1] - lo));
+    }
+
+    /**
+     * @brief Reports the tables (see EngineMemory).
+     * @param visit Receives each region.
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+private:
+    static constexpr int fractionBits = 23 - octaveBits; ///< Mantissa bits below one grid step
+
+    /**
+     * @struct Position
+     * @brief Grid interval of a frequency and the position within it.
+     */
+    struct Position
+    {
+        int index = 0;          ///< Lower grid point
+        double fraction = 0.0;  ///< Position between index and index + 1, in [0, 1)
+    };
+
+    /** @brief Bit pattern of a float. */
+    static uint32_t bitsOf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /** @brief Frequency of grid point i. */
+    static float gridFrequency(int i);
+
+    /**
+     * @brief Finds the grid interval of a frequency from its bit pattern.
+     *
+     * NaN fails the comparison and maps to minFrequency (jlimit would pass
+     * it through and its bit pattern would index far past the tables);
+     * infinities clamp to the grid ends.
+     */
+    Position locate(float frequency) const
+    {
+        const float f = frequency >= minFrequency ? juce::jmin(frequency, maxFrequency) : minFrequency;
+        const uint32_t offset = bitsOf(f) - bitsOf(minFrequency);
+        return { static_cast<int>(offset >> fractionBits),
+            static_cast<double>(offset & ((1u << fractionBits) - 1)) * (1.0 / static_cast<double>(1u << fractionBits)) };
+    }
+
+    /**
+     * @struct Design
+     * @brief One tabulated biquad in double precision.
+     */
+    struct Design
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0; ///< Coefficients (a0 = 1)
+    };
+
+    /** @brief Interpolates a biquad table at a grid position, rounding once. */
+    static Biquad lerp(const std::vector<Design>& table, Position p)
+    {
+        const Design& lo = table[p.index];
+        const Design& hi = table[p.index + 1];
+        const double t = p.fraction;
+        return { static_cast<float>(lo.b0 + t * (hi.b0 - lo.b0)),
+            static_cast<float>(lo.b1 + t * (hi.b1 - lo.b1)),
+            static_cast<float>(lo.b2 + t * (hi.b2 - lo.b2)),
+            static_cast<float>(lo.a1 + t * (hi.a1 - lo.a1)),
+            static_cast<float>(lo.a2 + t * (hi.a2 - lo.a2)) };
+    }
+
+    double fs = 0.0;                    ///< Sample rate in Hz
+    float maxFrequency = minFrequency;  ///< Upper clamp (0.49 * fs)
+
+    std::vector<Design> lowPassTable;   ///< Low-pass designs per grid point
+    std::vector<Design> highPassTable;  ///< High-pass designs per grid point
+    std::vector<double> onePoleTable;   ///< One-pole coefficients per grid point
+};
@@ -15,8 +15,9 @@
  * @param p Number of pulses per second (controls temporal density).
  * @param maxBlockSize Maximum audio block size.
  * @param fs Sample rate in Hz (used for timing grid calculation).
+ * @param seed Seed for the pulse sequence (same seed, same sequence).
  */
-DVNConvolver::DVNConvolver(int N, int M, int p, int maxBlockSize, double fs)
+DVNConvolver::DVNConvolver(int N, int M, int p, int maxBlockSize, double fs, uint32_t seed)
     : M(M), p(p)
 {
     // Calculate segment length based on pulse density
@@ -30,7 +31,7 @@ DVNConvolver::DVNConvolver(int N, int M, int p, int maxBlockSize, double fs)
     w.resize(M);
     s.resize(M);
 
-    juce::Random rng;
+    juce::Random rng(static_cast<juce::int64>(seed));
     RRS.resize(wmax - wmin + 1); // One RRSFilter per possible pulse width
 
     // Generate randomized pulses
@@ -62,6 +63,18 @@ DVNConvolver::DVNConvolver(int N, int M, int p, int maxBlockSize, double fs)
         RRS[w].first = RRSFilter(wmin + w, 1.0f / 4096.0f, maxBlockSize);
     }
 
+    // Taps of each group laid out contiguously, in group order
+    tapDelays.reserve(M);
+    tapGains.reserve(M);
+    for (const auto& group : RRS)
+    {
+        for (int m : group.second)
+        {
+            tapDelays.push_back(k[m]);
+            tapGains.push_back(static_cast<float>(s[m]));
+        }
+    }
+
     // Temporary buffers for summing pulses
     sum1.resize(maxBlockSize, 0.0f);
     sum2.resize(maxBlockSize, 0.0f);
@@ -75,7 +88,8 @@ DVNConvolver::DVNConvolver(int N, int M, int p, int maxBlockSize, double fs)
  * 2. Clear the accumulator buffer sum2.
  * 3. For each RRSFilter group (pulses of the same width):
  *    - Clear sum1 buffer.
- *    - Read each pulse from the delay line, multiply by its sign, and accumulate into sum1.
+ *    - Accumulate every pulse of the group times its sign into sum1 in one
+ *      pass over sum1 (DelayLine::accumulateTaps).
  *    - Process sum1 through the corresponding RRSFilter.
  *    - Accumulate the result into sum2.
  * 4. Copy sum2 back to the input block.
@@ -93,22 +107,16 @@ void DVNConvolver::process(float* block, int blockSize)
     juce::FloatVectorOperations::clear(sum2.data(), blockSize);
 
     // Process each RRSFilter group by pulse width
+    int first = 0;
     for (int w = 0; w <= wmax - wmin; ++w)
     {
         // Clear temporary sum for this group
         juce::FloatVectorOperations::clear(sum1.data(), blockSize);
 
-        // Sum pulses for this RRSFilter group
-        for (int m : RRS[w].second)
-        {
-            // Read delayed pulse, multiply by its sign, and accumulate
-            juce::FloatVectorOperations::addWithMultiply(
-                sum1.data(),
-                z->readBlock(k[m], blockSize),
-                static_cast<float>(s[m]),
-                blockSize
-            );
-        }
+        // Sum pulses for this RRSFilter group (signed taps, sum1 stays in registers)
+        const int numPulses = static_cast<int>(RRS[w].second.size());
+        z->accumulateTaps(tapDelays.data() + first, tapGains.data() + first, numPulses, sum1.data(), blockSize);
+        first += numPulses;
 
         // Apply the RRSFilter for this width
         RRS[w].first.process(sum1.data(), blockSize);
@@ -127,3 +135,52 @@ void DVNConvolver::process(float* block, int blockSize)
         blockSize
     );
 }
+
+/**
+ * @brief Clears the shared delay line and the RRS filter states.
+ */
+void DVNConvolver::reset()
+{
+    if (z != nullptr)
+        z->reset();
+
+    for (auto& group : RRS)
+        group.first.reset();
+}
+
+/**
+ * @brief Reports the pulse tables, the shared delay line, every RRS filter and the sums.
+ */
+void DVNConvolver::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, k);
+    EngineMemory::visit(visit, w);
+    EngineMemory::visit(visit, s);
+    EngineMemory::visit(visit, RRS);
+    EngineMemory::visit(visit, tapDelays);
+    EngineMemory::visit(visit, tapGains);
+
+    if (z != nullptr)
+        z->visitMemory(visit);
+
+    for (auto& [filter, pulses] : RRS)
+    {
+        filter.visitMemory(visit);
+        EngineMemory::visit(visit, pulses);
+    }
+
+    EngineMemory::visit(visit, sum1);
+    EngineMemory::visit(visit, sum2);
+}
+
+/**
+ * @brief Reports the shared input line and the RRS filters; sum1 and sum2 are scratch.
+ */
+void DVNConvolver::visitState(const EngineState::Visitor& visit)
+{
+    if (z != nullptr)
+        z->visitState(visit);
+
+    for (auto& group : RRS)
+        group.first.visitState(visit);
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <utility>
+#include <cstdint>
 
 // JUCE
 #include <juce_core/juce_core.h>
@@ -34,8 +35,9 @@ public:
      * @param p Number of pulses per second (controls temporal density).
      * @param maxBlockSize Maximum expected audio block size.
      * @param fs Sample rate (used to calculate pulse timing grid).
+     * @param seed Seed for the pulse positions, widths and signs.
      */
-    DVNConvolver(int N, int M, int p, int maxBlockSize, double fs);
+    DVNConvolver(int N, int M, int p, int maxBlockSize, double fs, uint32_t seed = 0);
 
     /** @brief Default constructor (produces an empty, uninitialized convolver). */
     DVNConvolver() = default;
@@ -61,6 +63,23 @@ public:
      */
     void process(float* block, int blockSize);
 
+    /**
+     * @brief Clears the input history and every RRS filter (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this convolver.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the input history and every RRS filter (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
 private:
     // --- Parameters ---
     int M = 0;      ///< Number of pulses
@@ -77,6 +96,8 @@ private:
     // --- Processing components ---
     std::unique_ptr<DelayLine> z; ///< Shared DelayLine for all pulses
     std::vector<std::pair<RRSFilter, std::vector<int>>> RRS; ///< RRS filters grouped by width
+    std::vector<int> tapDelays;  ///< Pulse positions in group order (for DelayLine::accumulateTaps)
+    std::vector<float> tapGains; ///< Pulse signs in group order
 
     // --- Temporary buffers ---
     std::vector<float> sum1; ///< Temporary sum for each RRS filter group
@@ -1,7 +1,123 @@
 #include "DelayLine.h"
+#include "HalfFloat.h"
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 
+// accumulateTaps promises the same bits on every path, which needs every
+// multiply and add rounded separately. Clang honours the standard pragma;
+// GCC ignores it and contracts across statements under its default
+// -ffp-contract=fast whenever FMA is available (e.g. -march=native), so the
+// GCC builds (Linux exporter, setup.py) pass -ffp-contract=off. MSVC does
+// not contract under /fp:precise.
+#if defined(__clang__)
+ #pragma STDC FP_CONTRACT OFF
+#endif
+
+#if defined(__AVX__)
+ #include <immintrin.h>
+ #define UMBRA_TAPS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define UMBRA_TAPS_SSE2 1
+#endif
+
+namespace
+{
+    constexpr int tapBatch = 64; ///< Taps resolved to pointers per pass over the output
+    constexpr int tapTile = 32;  ///< Output samples held in registers while the taps stream by
+
+    /**
+     * @brief Adds sum_j gains[j] * taps[j][i] to out[i] for i in [0, n).
+     *
+     * Per sample the products are added tap by tap, as a separate multiply
+     * and add, so every path below rounds the same way as a chain of
+     * FloatVectorOperations::addWithMultiply calls. That only holds while
+     * the compiler does not contract them into FMAs (see the top of this
+     * file).
+     */
+    void accumulate(const float* const* taps, const float* gains, int numTaps, float* out, int n)
+    {
+        int i = 0;
+
+#if UMBRA_TAPS_AVX
+        for (; i + tapTile <= n; i += tapTile)
+        {
+            __m256 a0 = _mm256_loadu_ps(out + i);
+            __m256 a1 = _mm256_loadu_ps(out + i + 8);
+            __m256 a2 = _mm256_loadu_ps(out + i + 16);
+            __m256 a3 = _mm256_loadu_ps(out + i + 24);
+
+            for (int j = 0; j < numTaps; ++j)
+            {
+                const float* x = taps[j] + i;
+                const __m256 g = _mm256_set1_ps(gains[j]);
+                a0 = _mm256_add_ps(a0, _mm256_mul_ps(g, _mm256_loadu_ps(x)));
+                a1 = _mm256_add_ps(a1, _mm256_mul_ps(g, _mm256_loadu_ps(x + 8)));
+                a2 = _mm256_add_ps(a2, _mm256_mul_ps(g, _mm256_loadu_ps(x + 16)));
+                a3 = _mm256_add_ps(a3, _mm256_mul_ps(g, _mm256_loadu_ps(x + 24)));
+            }
+
+            _mm256_storeu_ps(out + i, a0);
+            _mm256_storeu_ps(out + i + 8, a1);
+            _mm256_storeu_ps(out + i + 16, a2);
+            _mm256_storeu_ps(out + i + 24, a3);
+        }
+
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 a = _mm256_loadu_ps(out + i);
+            for (int j = 0; j < numTaps; ++j)
+                a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_set1_ps(gains[j]), _mm256_loadu_ps(taps[j] + i)));
+            _mm256_storeu_ps(out + i, a);
+        }
+#elif UMBRA_TAPS_SSE2
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128 a0 = _mm_loadu_ps(out + i);
+            __m128 a1 = _mm_loadu_ps(out + i + 4);
+            __m128 a2 = _mm_loadu_ps(out + i + 8);
+            __m128 a3 = _mm_loadu_ps(out + i + 12);
+
+            for (int j = 0; j < numTaps; ++j)
+            {
+                const float* x = taps[j] + i;
+                const __m128 g = _mm_set1_ps(gains[j]);
+                a0 = _mm_add_ps(a0, _mm_mul_ps(g, _mm_loadu_ps(x)));
+                a1 = _mm_add_ps(a1, _mm_mul_ps(g, _mm_loadu_ps(x + 4)));
+                a2 = _mm_add_ps(a2, _mm_mul_ps(g, _mm_loadu_ps(x + 8)));
+                a3 = _mm_add_ps(a3, _mm_mul_ps(g, _mm_loadu_ps(x + 12)));
+            }
+
+            _mm_storeu_ps(out + i, a0);
+            _mm_storeu_ps(out + i + 4, a1);
+            _mm_storeu_ps(out + i + 8, a2);
+            _mm_storeu_ps(out + i + 12, a3);
+        }
+#endif
+
+        // Remainder (the whole block without SIMD): same order, one tile at a time
+        for (; i < n; i += tapTile)
+        {
+            const int count = std::min(tapTile, n - i);
+            float acc[tapTile];
+            std::memcpy(acc, out + i, count * sizeof(float));
+
+            for (int j = 0; j < numTaps; ++j)
+            {
+                const float* x = taps[j] + i;
+                const float g = gains[j];
+                for (int t = 0; t < count; ++t)
+                {
+                    acc[t] += g * x[t]; // unfused only with contraction off (see top of file)
+                }
+            }
+
+            std::memcpy(out + i, acc, count * sizeof(float));
+        }
+    }
+}
+
 /**
  * @brief Constructs a DelayLine.
  *
@@ -9,10 +125,14 @@
  * @param M Maximum delay in samples.
  * @param g Gain applied to delayed samples (for feedback processing).
  * @param maxBlockSize Maximum expected processing block size.
+ * @param storage Sample format of the delay line contents.
  * @throws std::invalid_argument if M < 0 or maxBlockSize <= 0
+ *
+ * With 16-bit storage only a single (unmirrored) copy is kept, since block
+ * reads are not supported in that mode.
  */
-DelayLine::DelayLine(int M, float g, int maxBlockSize)
-    : M(M), g(g)
+DelayLine::DelayLine(int M, float g, int maxBlockSize, Storage storage)
+    : M(M), g(g), storage(storage)
 {
     if (M < 0 || maxBlockSize <= 0)
         throw std::invalid_argument("Delay length and block size must be positive");
@@ -20,6 +140,14 @@ DelayLine::DelayLine(int M, float g, int maxBlockSize)
     // Buffer size: max delay + max block size (ensures block reads never overflow)
     bufferSize = M + maxBlockSize;
 
+    if (storage != Storage::Float32)
+    {
+        // Compact storage: sample API only, no mirror needed (zero encodes as 0 in both formats)
+        compact.resize(bufferSize, 0);
+        write = 0;
+        return;
+    }
+
     // Mirror buffer: store two consecutive copies of the delay line
     // This allows readBlock to always return a contiguous memory block
     buffer.resize(2 * bufferSize, 0.0f);
@@ -39,8 +167,12 @@ DelayLine::DelayLine(int M, float g, int maxBlockSize)
  * @param blockSize Number of samples to read
  * @return Pointer to the block of samples (mutable for DSP operations)
  * @throws std::out_of_range if tau or blockSize is invalid
+ * @throws std::logic_error if the line uses 16-bit storage
  */
 float* DelayLine::readBlock(const int tau, const int blockSize) const {
+    if (storage != Storage::Float32)
+        throw std::logic_error("Block reads require Float32 storage");
+
     if (tau < 0 || tau > M)
         throw std::out_of_range("Tau exceeds maximum delay");
 
@@ -71,11 +203,15 @@ float* DelayLine::readBlock(const int blockSize) const {
  * Maintains mirrored buffer for contiguous block reads.
  * @param input Pointer to input samples
  * @param blockSize Number of samples to write
+ * @throws std::logic_error if the line uses 16-bit storage
  */
 void DelayLine::writeBlock(const float* input, const int blockSize) {
     if (!input || blockSize <= 0)
         return;
 
+    if (storage != Storage::Float32)
+        throw std::logic_error("Block writes require Float32 storage");
+
     if (write + blockSize <= bufferSize) {
         // Simple contiguous copy (no wrap)
         std::memcpy(&buffer[write], input, blockSize * sizeof(float));
@@ -112,6 +248,53 @@ void DelayLine::processBlock(const float* input, const int blockSize) {
     std::memcpy(const_cast<float*>(input), readBlock(blockSize), blockSize * sizeof(float));
 }
 
+/**
+ * @brief Adds several weighted taps of the line to a block in one pass.
+ *
+ * Taps are resolved to pointers into the mirrored buffer in batches of 64
+ * (on the stack, no allocation); each batch then makes one pass over the
+ * output with 32 samples held in registers while all of its taps stream by.
+ * Per sample the taps are added in order, exactly like repeated
+ * readBlock + addWithMultiply calls.
+ *
+ * @param taus Delay of each tap in samples (0..M).
+ * @param gains Gain of each tap.
+ * @param numTaps Number of taps.
+ * @param out Block the taps are added to.
+ * @param n Number of samples.
+ * @throws std::logic_error if the line uses 16-bit storage
+ * @throws std::out_of_range if a tap or n is out of bounds
+ */
+void DelayLine::accumulateTaps(const int* taus, const float* gains, int numTaps, float* out, int n) const {
+    if (storage != Storage::Float32)
+        throw std::logic_error("Block reads require Float32 storage");
+
+    if (n <= 0 || numTaps <= 0)
+        return;
+
+    const float* taps[tapBatch];
+    for (int first = 0; first < numTaps; first += tapBatch)
+    {
+        const int count = std::min(tapBatch, numTaps - first);
+        for (int j = 0; j < count; ++j)
+        {
+            const int tau = taus[first + j];
+            if (tau < 0 || tau > M)
+                throw std::out_of_range("Tau exceeds maximum delay");
+            if (n > bufferSize - tau)
+                throw std::out_of_range("Block size out of bounds");
+
+            // Same start as readBlock(tau, n)
+            int read = write - tau - n;
+            if (read < 0)
+                read += bufferSize;
+            taps[j] = buffer.data() + read;
+        }
+
+        accumulate(taps, gains + first, count, out, n);
+    }
+}
+
 // --- Sample-based API ---
 
 /**
@@ -129,6 +312,9 @@ float DelayLine::readSample(const int tau) const {
     if (read < 0)
         read += bufferSize; // wrap-around
 
+    if (storage != Storage::Float32)
+        return decode(compact[read]);
+
     return buffer[read];
 }
 
@@ -146,6 +332,13 @@ float DelayLine::readSample() const {
  * @param input Sample to write
  */
 void DelayLine::writeSample(const float input) {
+    if (storage != Storage::Float32)
+    {
+        compact[write] = encode(input);
+        write = (write + 1) % bufferSize;
+        return;
+    }
+
     buffer[write] = input;
     buffer[write + bufferSize] = input; // mirror write
     write = (write + 1) % bufferSize;
@@ -163,7 +356,62 @@ void DelayLine::processSample(const float& input) {
     float y = readSample(M);      // delayed sample at maximum delay
     float z = x + g * y;          // apply feedback gain
 
+    if (storage != Storage::Float32)
+    {
+        compact[write] = encode(z);
+        write = (write + 1) % bufferSize;
+        return;
+    }
+
     buffer[write] = z;            // write to main buffer
     buffer[write + bufferSize] = z; // write to mirrored buffer
     write = (write + 1) % bufferSize; // advance circular index
 }
+
+// --- Compact storage ---
+
+/**
+ * @brief Encodes a sample into the active 16-bit format (round to nearest-even).
+ */
+uint16_t DelayLine::encode(float value) const {
+    return storage == Storage::Float16 ? HalfFloat::floatToHalf(value)
+                                       : HalfFloat::floatToBFloat(value);
+}
+
+/**
+ * @brief Decodes a 16-bit stored sample back to float (exact).
+ */
+float DelayLine::decode(uint16_t bits) const {
+    return storage == Storage::Float16 ? HalfFloat::halfToFloat(bits)
+                                       : HalfFloat::bfloatToFloat(bits);
+}
+
+// --- State ---
+
+/**
+ * @brief Zeroes both storage formats and rewinds to the start.
+ */
+void DelayLine::reset() {
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    std::fill(compact.begin(), compact.end(), static_cast<uint16_t>(0)); // +0 in FP16 and bfloat16
+    write = 0;
+}
+
+// --- Memory ---
+
+/**
+ * @brief Reports the mirrored float buffer or the compact buffer.
+ */
+void DelayLine::visitMemory(const EngineMemory::Visitor& visit) {
+    EngineMemory::visit(visit, buffer);
+    EngineMemory::visit(visit, compact);
+}
+
+/**
+ * @brief Reports the buffer in use and the write index.
+ */
+void DelayLine::visitState(const EngineState::Visitor& visit) {
+    EngineState::visit(visit, buffer);
+    EngineState::visit(visit, compact);
+    EngineState::visit(visit, write);
+}
@@ -2,6 +2,11 @@
 
 // Standard library
 #include <vector>
+#include <cstdint>
+
+// Project headers
+#include "EngineMemory.h"
+#include "EngineState.h"
 
 // Forward declarations
 class FDN;
@@ -13,17 +18,36 @@ class FDN;
  * The DelayLine supports both block-based and sample-based APIs. It is used in
  * feedback delay networks (FDNs) and other DSP structures. The line can read
  * delayed samples, write new samples, and process them in-place.
+ *
+ * Long feedback lines can optionally store their contents as FP16 or bfloat16
+ * to halve memory traffic; samples are converted on read/write and all
+ * arithmetic stays in float. Compact storage supports the sample-based API only.
  */
 class DelayLine
 {
 public:
+    /**
+     * @enum Storage
+     * @brief Sample format of the delay line contents.
+     */
+    enum class Storage
+    {
+        Float32, ///< 32-bit float, mirrored buffer (block and sample API)
+        Float16, ///< IEEE binary16, sample API only
+        BFloat16 ///< bfloat16, sample API only
+    };
+
     /**
      * @brief Constructs a DelayLine with given parameters.
      * @param M The maximum delay length in samples.
      * @param g Gain applied to the delayed output (usually between 0 and 1).
      * @param maxBlockSize Maximum block size for internal processing buffers.
+     * @param storage Sample format used to hold the delay line contents.
+     *
+     * Compact (16-bit) lines keep a single unmirrored copy and support the
+     * sample-based API only (see supportsBlocks()).
      */
-    DelayLine(int M, float g, int maxBlockSize);
+    DelayLine(int M, float g, int maxBlockSize, Storage storage = Storage::Float32);
 
     /**
      * @brief Default constructor.
@@ -52,6 +76,7 @@ public:
      * @param tau The delay in samples.
      * @param blockSize Number of samples to read.
      * @return Pointer to the beginning of the block.
+     * @throws std::logic_error if the line uses compact (16-bit) storage.
      */
     float* readBlock(const int tau, const int blockSize) const;
 
@@ -66,6 +91,7 @@ public:
      * @brief Writes a block of samples into the delay line.
      * @param input Pointer to the input samples.
      * @param blockSize Number of samples to write.
+     * @throws std::logic_error if the line uses compact (16-bit) storage.
      */
     void writeBlock(const float* input, const int blockSize);
 
@@ -76,6 +102,28 @@ public:
      */
     void processBlock(const float* block, const int blockSize);
 
+    /**
+     * @brief Adds several weighted taps of the line to a block in one pass.
+     *
+     * Equivalent to out[i] += gains[j] * readBlock(taus[j], n)[i] for every
+     * tap j in order, but the output is held in registers across all taps
+     * (tiles of 32 samples) so it is loaded and stored once per batch of
+     * taps instead of once per tap. AVX, SSE2 and scalar builds perform the
+     * same multiply and add in the same order per sample, so they give
+     * identical bits as long as FP contraction is off (-ffp-contract=off
+     * with GCC, as the project's GCC builds set); an FMA-contracting build
+     * rounds differently.
+     *
+     * @param taus Delay of each tap in samples (0..M, same alignment as readBlock).
+     * @param gains Gain of each tap.
+     * @param numTaps Number of taps.
+     * @param out Block the taps are added to.
+     * @param n Number of samples.
+     * @throws std::logic_error if the line uses compact (16-bit) storage.
+     * @throws std::out_of_range if a tap or n is out of bounds.
+     */
+    void accumulateTaps(const int* taus, const float* gains, int numTaps, float* out, int n) const;
+
     // --- Sample-based API ---
 
     /**
@@ -103,11 +151,45 @@ public:
      */
     void processSample(const float& input);
 
+    // --- Storage ---
+
+    /** @brief True if the block-based API may be used (Float32 storage). */
+    bool supportsBlocks() const { return storage == Storage::Float32; }
+
+    // --- State ---
+
+    /**
+     * @brief Clears the contents and rewinds the write position (no allocation).
+     */
+    void reset();
+
+    // --- Memory ---
+
+    /**
+     * @brief Reports the heap regions owned by this delay line.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the contents and write position (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
 private:
+    /** @brief Converts a float into the compact storage format. */
+    uint16_t encode(float value) const;
+
+    /** @brief Converts a compact stored sample back to float. */
+    float decode(uint16_t bits) const;
+
     int M = 0;                  /**< Maximum delay length in samples */
     float g = 0.0f;             /**< Gain applied to delayed output */
+    Storage storage = Storage::Float32; /**< Sample format of the contents */
 
     std::vector<float> buffer;  /**< Circular buffer storing delayed samples */
+    std::vector<uint16_t> compact; /**< Circular buffer for 16-bit storage (no mirror) */
     int bufferSize = 0;         /**< Total size of the buffer */
     int write = 0;              /**< Current write index in the buffer */
 
@@ -14,21 +14,45 @@
  * @param p Pulse density (pulses per second).
  * @param blockSize Maximum expected audio block size.
  * @param fs Sample rate used for pulse timing.
+ * @param engine Diffusion engine (DVN convolvers, allpass cascade or shared-grid DVN).
+ * @param seed Topology seed; each channel's sequence seed is drawn from it.
+ * @param threads OpenMP threads across the DVN channels (0 = OpenMP default, 1 = serial).
  *
  * @throws std::invalid_argument if N < 1.
  */
-Diffuser::Diffuser(const int& N, int M, int p, int blockSize, double fs) : N(N)
+Diffuser::Diffuser(const int& N, int M, int p, int blockSize, double fs, Engine engine,
+    uint32_t seed, int threads)
+    : N(N), engine(engine), threads(threads > 0 ? threads : omp_get_max_threads())
 {
     if (N < 1)
         throw std::invalid_argument("Number of channels must be at least 1.");
 
+    if (engine == Engine::Allpass)
+    {
+        allpass = std::make_unique<AllpassDiffuser>(N, M, p, blockSize, fs, seed);
+        return;
+    }
+
+    if (engine == Engine::SharedDVN)
+    {
+        sharedDvn = std::make_unique<SharedDVNConvolver>(N, M, p, blockSize, fs, seed);
+        return;
+    }
+
     dvnConvolvers.resize(N);
+    std::mt19937 channelSeeds(seed);
 
     for (int channel = 0; channel < N; ++channel)
     {
         // Construct a DVNConvolver for each channel
         // Note: Each convolver is independent and manages its own pulse sequence
-        dvnConvolvers[channel] = std::make_unique<DVNConvolver>(N, M, p, blockSize, fs);
+        dvnConvolvers[channel] = std::make_unique<DVNConvolver>(N, M, p, blockSize, fs, channelSeeds());
+    }
+
+    // Start the OpenMP worker pool now, so the first callback does not
+    // create threads (and fault in their stacks) on the audio thread
+#pragma omp parallel num_threads(this->threads) if (this->threads > 1)
+    {
     }
 }
 
@@ -41,19 +65,101 @@ Diffuser::Diffuser(const int& N, int M, int p, int blockSize, double fs) : N(N)
  * 3. Process the block in-place using the corresponding DVNConvolver.
  * 4. Output is written back directly into the buffer.
  *
+ * Channels are split over the configured OpenMP team; with one thread, or
+ * for blocks shorter than minParallelSamples (the control-rate sub-blocks
+ * of processRamp() and friends), the loop runs serially without entering
+ * OpenMP, since a fork/join per sub-block and stage costs more than the
+ * channels save. Each channel is computed
+ * entirely by one thread in a fixed order, so the output is the same for
+ * any team size. The allpass engine runs its channels in groups of 8 and
+ * the shared-grid DVN engine processes all channels together in SIMD lanes,
+ * both on the calling thread.
+ *
  * @param buffer The audio buffer to process. Must contain at least N channels.
  */
 void Diffuser::process(juce::AudioBuffer<float>& buffer)
 {
-#pragma omp parallel for
-    for (int channel = 0; channel < N; ++channel)
+    if (engine == Engine::Allpass)
+    {
+        allpass->process(buffer);
+        return;
+    }
+
+    if (engine == Engine::SharedDVN)
+    {
+        sharedDvn->process(buffer);
+        return;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    if (threads <= 1 || numSamples < minParallelSamples)
     {
-        float* channelData = buffer.getWritePointer(channel);
-        // Process the current channel with its DVNConvolver
-        dvnConvolvers[channel]->process(channelData, buffer.getNumSamples());
+        for (int channel = 0; channel < N; ++channel)
+            dvnConvolvers[channel]->process(buffer.getWritePointer(channel), numSamples);
+        return;
+    }
+
+    // Workers take over the caller's floating-point mode (flush-to-zero,
+    // rounding), so denormals are handled alike on every thread and the
+    // thread count never changes the output
+    const auto fpStatus = juce::FloatVectorOperations::getFpStatusRegister();
+
+#pragma omp parallel num_threads(threads)
+    {
+        juce::FloatVectorOperations::setFpStatusRegister(fpStatus);
+
+#pragma omp for schedule(static)
+        for (int channel = 0; channel < N; ++channel)
+        {
+            float* channelData = buffer.getWritePointer(channel);
+            // Process the current channel with its DVNConvolver
+            dvnConvolvers[channel]->process(channelData, numSamples);
+        }
     }
 
     // Note: If the input buffer has more channels than N, remaining channels are unchanged.
     // If fewer channels, consider upmixing or handling in calling code.
 }
 
+/**
+ * @brief Forwards to the active engine.
+ */
+void Diffuser::reset()
+{
+    if (allpass != nullptr)
+        allpass->reset();
+    if (sharedDvn != nullptr)
+        sharedDvn->reset();
+
+    for (auto& convolver : dvnConvolvers)
+        convolver->reset();
+}
+
+/**
+ * @brief Forwards to the active engine.
+ */
+void Diffuser::visitMemory(const EngineMemory::Visitor& visit)
+{
+    if (allpass != nullptr)
+        allpass->visitMemory(visit);
+    if (sharedDvn != nullptr)
+        sharedDvn->visitMemory(visit);
+
+    EngineMemory::visit(visit, dvnConvolvers);
+    for (auto& convolver : dvnConvolvers)
+        convolver->visitMemory(visit);
+}
+
+/**
+ * @brief Forwards to the active engine.
+ */
+void Diffuser::visitState(const EngineState::Visitor& visit)
+{
+    if (allpass != nullptr)
+        allpass->visitState(visit);
+    if (sharedDvn != nullptr)
+        sharedDvn->visitState(visit);
+
+    for (auto& convolver : dvnConvolvers)
+        convolver->visitState(visit);
+}
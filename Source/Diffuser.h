@@ -3,6 +3,8 @@
 // Standard library
 #include <vector>
 #include <memory>
+#include <random>
+#include <cstdint>
 #include <stdexcept>
 
 // JUCE
@@ -10,6 +12,8 @@
 
 // Project headers
 #include "DVNConvolver.h"
+#include "AllpassDiffuser.h"
+#include "SharedDVNConvolver.h"
 
 /**
  * @class Diffuser
@@ -19,11 +23,29 @@
  * Each convolver independently applies a dark velvet noise convolution to its channel.
  * This can be used to increase spatial richness or create diffusion effects in reverberation.
  *
+ * Cheaper engines can be selected instead of the DVN convolvers: nested
+ * allpass cascades (AllpassDiffuser), or a single convolver whose channels
+ * share one pulse grid and differ only in pulse signs (SharedDVNConvolver).
+ * All share the same process() interface.
+ *
  * The class is non-copyable due to unique_ptr storage, but supports move semantics.
  */
 class Diffuser
 {
 public:
+    /**
+     * @enum Engine
+     * @brief Diffusion engine used by a Diffuser stage.
+     */
+    enum class Engine
+    {
+        DVN,       ///< One DVNConvolver per channel (highest quality, highest cost)
+        Allpass,   ///< Nested Schroeder allpass cascade, 8 channels per group, level-matched to DVN
+        SharedDVN  ///< DVN with one pulse grid for all channels, 8 channels per SIMD group
+    };
+
+    static constexpr int minParallelSamples = 256; ///< Shorter blocks run the DVN channels serially
+
     /**
      * @brief Constructs a Diffuser with N channels, each with a DVNConvolver.
      * @param N Number of audio channels.
@@ -31,9 +53,16 @@ public:
      * @param p Pulses per second per DVNConvolver.
      * @param blockSize Maximum audio block size.
      * @param fs Sample rate (Hz) used for pulse timing calculation.
+     * @param engine Diffusion engine. Allpass derives its delays from M, p and fs;
+     *        SharedDVN uses the same M, p and fs as the per-channel DVN.
+     * @param seed Topology seed; per-channel sequences are derived from it.
+     * @param threads OpenMP threads across the DVN channels (0 = OpenMP default,
+     *        1 = serial on the calling thread), for blocks of at least
+     *        minParallelSamples. Ignored by the other engines.
      * @throws std::invalid_argument if N < 1.
      */
-    Diffuser(const int& N, int M, int p, int blockSize, double fs);
+    Diffuser(const int& N, int M, int p, int blockSize, double fs, Engine engine = Engine::DVN,
+        uint32_t seed = 0, int threads = 0);
 
     /** @brief Default constructor (produces empty uninitialized Diffuser). */
     Diffuser() = default;
@@ -58,7 +87,28 @@ public:
      */
     void process(juce::AudioBuffer<float>& buffer);
 
+    /**
+     * @brief Clears the state of the active engine (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by the active engine.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the running state of the active engine (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
 private:
     int N = 0; ///< Number of channels
-    std::vector<std::unique_ptr<DVNConvolver>> dvnConvolvers; ///< One DVNConvolver per channel
+    Engine engine = Engine::DVN; ///< Active diffusion engine
+    int threads = 1; ///< OpenMP team size for the DVN channels (1 = serial)
+    std::vector<std::unique_ptr<DVNConvolver>> dvnConvolvers; ///< One DVNConvolver per channel (DVN engine)
+    std::unique_ptr<AllpassDiffuser> allpass; ///< Allpass cascade (Allpass engine)
+    std::unique_ptr<SharedDVNConvolver> sharedDvn; ///< Shared-grid convolver (SharedDVN engine)
 };
@@ -0,0 +1,195 @@
+#include "EarlyReflections.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr float speedOfSound = 343.0f;       ///< m/s
+    constexpr float wallReflection = 0.85f;      ///< Pressure reflection coefficient per bounce
+    constexpr float baseSize[3] = { 12.0f, 8.0f, 4.0f };   ///< Room dimensions (m) at roomSize 1
+    constexpr float sourcePos[3] = { 0.35f, 0.6f, 0.4f };   ///< Source position (fraction of each dimension)
+    constexpr float listenerPos[3] = { 0.65f, 0.4f, 0.4f }; ///< Listener position (fraction of each dimension)
+
+    /**
+     * @brief Coordinate of the n-th image of s along an axis of length L.
+     */
+    float imageCoordinate(int n, float s, float L)
+    {
+        return static_cast<float>(n) * L + ((n & 1) ? L - s : s);
+    }
+}
+
+/**
+ * @brief Constructs the early-reflection stage with the roomSize 1 pattern.
+ *
+ * @param fs Sample rate in Hz.
+ * @param numChannels Number of output channels taps are spread over.
+ * @throws std::invalid_argument if fs <= 0 or numChannels < 1.
+ */
+EarlyReflections::EarlyReflections(double fs, int numChannels)
+    : fs(fs), numChannels(numChannels)
+{
+    if (fs <= 0.0 || numChannels < 1)
+        throw std::invalid_argument("Sample rate and channel count must be positive");
+
+    setRoomSize(1.0f);
+}
+
+/**
+ * @brief Rebuilds the image-source tap pattern.
+ *
+ * Steps:
+ * 1. Scale the shoebox by roomSize and enumerate every image with
+ *    |nx| + |ny| + |nz| <= 2 (the direct path is the (0, 0, 0) image).
+ * 2. Delay = extra path length over the direct path; gain = spherical
+ *    spreading relative to the direct path times one reflection per bounce;
+ *    pan = constant-power from the image's lateral angle.
+ * 3. Drop taps beyond maxReflectionTime, sort by delay and deal them
+ *    round-robin to the output channels.
+ * 4. Normalize every channel to unit tap energy, matching the level of the
+ *    plain upmix it replaces.
+ *
+ * Runs only when roomSize changes; no allocation.
+ *
+ * @param roomSize Room scale (1.0 = 12 x 8 x 4 m).
+ */
+void EarlyReflections::setRoomSize(float roomSize)
+{
+    if (roomSize == previousRoomSize)
+        return;
+    previousRoomSize = roomSize;
+
+    const float scale = std::max(roomSize, 0.05f);
+    float size[3], source[3], listener[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        size[axis] = baseSize[axis] * scale;
+        source[axis] = sourcePos[axis] * size[axis];
+        listener[axis] = listenerPos[axis] * size[axis];
+    }
+
+    const auto distanceTo = [&](int nx, int ny, int nz, float& dx, float& dy)
+    {
+        dx = imageCoordinate(nx, source[0], size[0]) - listener[0];
+        dy = imageCoordinate(ny, source[1], size[1]) - listener[1];
+        const float dz = imageCoordinate(nz, source[2], size[2]) - listener[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    };
+
+    float dx, dy;
+    const float direct = distanceTo(0, 0, 0, dx, dy);
+    const int maxDelay = static_cast<int>(maxReflectionTime * fs);
+
+    // Step 1-2: image sources up to second order
+    numTaps = 0;
+    for (int nx = -2; nx <= 2; ++nx)
+    {
+        for (int ny = -2; ny <= 2; ++ny)
+        {
+            for (int nz = -2; nz <= 2; ++nz)
+            {
+                const int order = std::abs(nx) + std::abs(ny) + std::abs(nz);
+                if (order > 2 || numTaps == maxTaps)
+                    continue;
+
+                const float distance = distanceTo(nx, ny, nz, dx, dy);
+                const int delay = static_cast<int>(std::lround((distance - direct) / speedOfSound * fs));
+                if (delay < 0 || delay > maxDelay)
+                    continue;
+
+                // Listener faces +x; positive lateral = left
+                const float horizontal = std::sqrt(dx * dx + dy * dy);
+                const float lateral = horizontal > 0.0f ? dy / horizontal : 0.0f;
+                const float angle = 0.25f * juce::MathConstants<float>::pi * (1.0f - lateral);
+
+                const float gain = std::pow(wallReflection, static_cast<float>(order)) * direct / distance;
+
+                Tap& tap = taps[numTaps++];
+                tap.delay = delay;
+                tap.gainL = gain * std::cos(angle);
+                tap.gainR = gain * std::sin(angle);
+            }
+        }
+    }
+
+    // Step 3: order by arrival, spread over the channels
+    std::sort(taps.begin(), taps.begin() + numTaps,
+        [](const Tap& a, const Tap& b) { return a.delay < b.delay; });
+
+    for (int i = 0; i < numTaps; ++i)
+        taps[i].channel = i % numChannels;
+
+    // Step 4: unit energy per channel
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float energy = 0.0f;
+        for (int i = ch; i < numTaps; i += numChannels)
+            energy += taps[i].gainL * taps[i].gainL + taps[i].gainR * taps[i].gainR;
+
+        if (energy <= 0.0f)
+            continue;
+
+        const float norm = 1.0f / std::sqrt(energy);
+        for (int i = ch; i < numTaps; i += numChannels)
+        {
+            taps[i].gainL *= norm;
+            taps[i].gainR *= norm;
+        }
+    }
+}
+
+/**
+ * @brief Renders all taps for one block.
+ *
+ * Per output channel, the delays (clamped pre-delay + 1 + tap delay) and
+ * gains of its taps are gathered on the stack; each lane's ring then adds
+ * all of them in one pass over the channel (DelayLine::accumulateTaps), so
+ * a channel is loaded and stored once per lane instead of once per tap.
+ *
+ * @param source Input stage holding the filtered input.
+ * @param preDelay Pre-delay in samples.
+ * @param output Destination buffer.
+ * @param gain Level applied to every tap.
+ * @param accumulate Add to the output instead of overwriting it.
+ */
+void EarlyReflections::process(const InputConditioner& source,
+    int preDelay,
+    juce::AudioBuffer<float>& output,
+    float gain,
+    bool accumulate)
+{
+    const int numSamples = output.getNumSamples();
+    const int channels = juce::jmin(numChannels, output.getNumChannels());
+    if (numSamples <= 0 || channels < 1)
+        return;
+
+    if (!accumulate)
+        for (int ch = 0; ch < channels; ++ch)
+            output.clear(ch, 0, numSamples);
+
+    // Same alignment as InputConditioner::process (tau + 1)
+    const int base = juce::jlimit(0, source.getMaxPreDelay(), preDelay) + 1;
+    const DelayLine& left = source.getLine(0);
+    const DelayLine& right = source.getLine(1);
+
+    std::array<int, maxTaps> delays;
+    std::array<float, maxTaps> gainsL, gainsR;
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        // Taps are dealt round-robin, so channel ch owns taps ch, ch + numChannels, ...
+        int count = 0;
+        for (int i = ch; i < numTaps; i += numChannels)
+        {
+            delays[count] = base + taps[i].delay;
+            gainsL[count] = gain * taps[i].gainL;
+            gainsR[count] = gain * taps[i].gainR;
+            ++count;
+        }
+
+        float* out = output.getWritePointer(ch);
+        left.accumulateTaps(delays.data(), gainsL.data(), count, out, numSamples);
+        right.accumulateTaps(delays.data(), gainsR.data(), count, out, numSamples);
+    }
+}
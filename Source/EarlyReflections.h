@@ -0,0 +1,98 @@
+#pragma once
+
+// Standard library
+#include <array>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "InputConditioner.h"
+
+/**
+ * @class EarlyReflections
+ * @brief Multi-tap early-reflection stage reading straight from the pre-delay rings.
+ *
+ * A cheap replacement for the first DVN diffuser (Eco configuration). The tap
+ * pattern comes from a shoebox image-source model (direct path plus all first
+ * and second order reflections) whose dimensions scale with roomSize. Each tap
+ * has a delay, a gain (spherical spreading and wall absorption) and a pan
+ * derived from its azimuth.
+ *
+ * Processing does no per-sample work of its own: the taps of each output
+ * channel are added from each input lane's ring in one fused pass
+ * (DelayLine::accumulateTaps) over that channel. Taps are dealt
+ * round-robin to the channels so that each channel gets a different early
+ * pattern (decorrelation for the FDN that follows).
+ */
+class EarlyReflections
+{
+public:
+    static constexpr int maxTaps = 25;                ///< Direct path + 6 first + 18 second order images
+    static constexpr float maxReflectionTime = 0.15f; ///< Longest tap (seconds) after the pre-delay
+
+    /**
+     * @brief Constructs the stage.
+     * @param fs Sample rate in Hz.
+     * @param numChannels Number of output channels taps are spread over.
+     * @throws std::invalid_argument if fs <= 0 or numChannels < 1.
+     */
+    EarlyReflections(double fs, int numChannels);
+
+    /** @brief Default constructor (produces an empty, uninitialized stage). */
+    EarlyReflections() = default;
+
+    /** @brief Destructor. */
+    ~EarlyReflections() = default;
+
+    // Copy operations are deleted to prevent accidental deep copies
+    EarlyReflections(const EarlyReflections&) = delete;
+    EarlyReflections& operator=(const EarlyReflections&) = delete;
+
+    // Move operations are defaulted (safe for internal buffers)
+    EarlyReflections(EarlyReflections&&) noexcept = default;
+    EarlyReflections& operator=(EarlyReflections&&) noexcept = default;
+
+    /**
+     * @brief Rebuilds the tap pattern if the room size changed.
+     * @param roomSize Room scale (1.0 = 12 x 8 x 4 m).
+     */
+    void setRoomSize(float roomSize);
+
+    /**
+     * @brief Renders the taps for one block into the output channels.
+     * @param source Input stage whose rings hold the filtered input (after push()).
+     * @param preDelay Pre-delay in samples (clamped to the source's maximum).
+     * @param output Destination buffer (at least numChannels channels).
+     * @param gain Level applied to every tap.
+     * @param accumulate Add to the output instead of overwriting it.
+     *
+     * The source rings must have been built with at least maxReflectionTime
+     * of history.
+     */
+    void process(const InputConditioner& source,
+        int preDelay,
+        juce::AudioBuffer<float>& output,
+        float gain,
+        bool accumulate);
+
+private:
+    /**
+     * @struct Tap
+     * @brief One reflection: delay after the direct path, per-lane gains and target channel.
+     */
+    struct Tap
+    {
+        int delay = 0;        ///< Delay in samples relative to the direct path
+        float gainL = 0.0f;   ///< Gain applied to the left input lane
+        float gainR = 0.0f;   ///< Gain applied to the right input lane
+        int channel = 0;      ///< Output channel the tap is added to
+    };
+
+    double fs = 0.0;            ///< Sample rate in Hz
+    int numChannels = 0;        ///< Output channels taps are spread over
+    float previousRoomSize = -1.0f; ///< Room size the current taps were built for
+
+    std::array<Tap, maxTaps> taps; ///< Active taps, sorted by delay
+    int numTaps = 0;               ///< Number of valid entries in taps
+};
@@ -0,0 +1,272 @@
+#include "EngineMemory.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <sys/mman.h>
+ #include <sys/resource.h>
+ #include <unistd.h>
+ #define UMBRA_HAS_MLOCK 1
+#else
+ #define UMBRA_HAS_MLOCK 0
+#endif
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Rounds a region out to whole pages.
+     * @return Page-aligned start and size (size 0 for an empty region).
+     */
+    std::pair<void*, size_t> pageRange(void* data, size_t bytes)
+    {
+        if (data == nullptr || bytes == 0)
+            return { nullptr, 0 };
+
+        const auto page = static_cast<uintptr_t>(EngineMemory::getPageSize());
+        const auto start = reinterpret_cast<uintptr_t>(data) & ~(page - 1);
+        const auto end = (reinterpret_cast<uintptr_t>(data) + bytes + page - 1) & ~(page - 1);
+        return { reinterpret_cast<void*>(start), static_cast<size_t>(end - start) };
+    }
+
+    /** @brief Pins one page-aligned range. */
+    bool lockPages(void* start, size_t bytes)
+    {
+#if UMBRA_HAS_MLOCK
+        return mlock(start, bytes) == 0;
+#elif JUCE_WINDOWS
+        return VirtualLock(start, bytes) != 0;
+#else
+        juce::ignoreUnused(start, bytes);
+        return false;
+#endif
+    }
+
+    /** @brief Unpins one page-aligned range. */
+    void unlockPages(void* start, size_t bytes)
+    {
+#if UMBRA_HAS_MLOCK
+        munlock(start, bytes);
+#elif JUCE_WINDOWS
+        VirtualUnlock(start, bytes);
+#else
+        juce::ignoreUnused(start, bytes);
+#endif
+    }
+
+    /**
+     * @struct PinnedPages
+     * @brief Process-wide count of the Locks holding each pinned page.
+     *
+     * mlock / VirtualLock are not reference-counted: one unlock unpins a page
+     * for every owner, and engines in one process can share pages (small
+     * allocations side by side). Pages are therefore counted here and only
+     * unpinned when their last Lock releases them.
+     */
+    struct PinnedPages
+    {
+        std::mutex mutex;                             ///< Guards counts (prepare / release time only)
+        std::unordered_map<uintptr_t, size_t> counts; ///< Holders per page start address
+    };
+
+    PinnedPages& pinnedPages()
+    {
+        static PinnedPages pages;
+        return pages;
+    }
+
+    /**
+     * @brief Unpins the pages of a range that no Lock holds (caller holds the mutex).
+     *
+     * Consecutive free pages are unpinned with one call.
+     */
+    void unlockUnheld(PinnedPages& pinned, uintptr_t start, size_t bytes)
+    {
+        const auto page = static_cast<uintptr_t>(EngineMemory::getPageSize());
+        const uintptr_t end = start + bytes;
+
+        uintptr_t run = 0; // Start of the current run of free pages (0 = none)
+        for (uintptr_t p = start; p <= end; p += page)
+        {
+            const bool free = p < end && pinned.counts.find(p) == pinned.counts.end();
+            if (free && run == 0)
+                run = p;
+            else if (!free && run != 0)
+            {
+                unlockPages(reinterpret_cast<void*>(run), static_cast<size_t>(p - run));
+                run = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reports each channel of the buffer as its own region.
+ */
+void EngineMemory::visit(const Visitor& visit, juce::AudioBuffer<float>& buffer)
+{
+    const auto bytes = static_cast<size_t>(buffer.getNumSamples()) * sizeof(float);
+    if (bytes == 0)
+        return;
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        visit(buffer.getWritePointer(channel), bytes);
+}
+
+/**
+ * @brief Queries the page size once.
+ */
+size_t EngineMemory::getPageSize()
+{
+#if UMBRA_HAS_MLOCK
+    static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+#elif JUCE_WINDOWS
+    static const auto pageSize = []
+    {
+        SYSTEM_INFO info {};
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+    }();
+    return pageSize;
+#else
+    return 4096;
+#endif
+}
+
+/**
+ * @brief Rewrites the first byte of every page in the region.
+ *
+ * A read alone would only map the shared zero page; the volatile write of
+ * the same value forces a private page without changing the contents.
+ */
+size_t EngineMemory::prefault(void* data, size_t bytes)
+{
+    if (data == nullptr || bytes == 0)
+        return 0;
+
+    const size_t page = getPageSize();
+    auto* first = static_cast<volatile unsigned char*>(data);
+    const auto offset = reinterpret_cast<uintptr_t>(data) & (page - 1);
+
+    // First byte of the region, then the first byte of each following page
+    size_t pages = 0;
+    for (size_t i = 0; i < bytes; i = (i == 0 ? page - offset : i + page))
+    {
+        first[i] = first[i];
+        ++pages;
+    }
+    return pages;
+}
+
+/**
+ * @brief Reads the process's minor fault counter.
+ */
+int64_t EngineMemory::getMinorPageFaults()
+{
+#if UMBRA_HAS_MLOCK
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+    return static_cast<int64_t>(usage.ru_minflt);
+#else
+    return -1;
+#endif
+}
+
+EngineMemory::Lock::~Lock()
+{
+    release();
+}
+
+EngineMemory::Lock::Lock(Lock&& other) noexcept
+    : regions(std::move(other.regions)), lockedBytes(other.lockedBytes), failed(other.failed)
+{
+    other.regions.clear();
+    other.lockedBytes = 0;
+}
+
+EngineMemory::Lock& EngineMemory::Lock::operator=(Lock&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        regions = std::move(other.regions);
+        lockedBytes = other.lockedBytes;
+        failed = other.failed;
+        other.regions.clear();
+        other.lockedBytes = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Pins a region within the process's current lock limit.
+ *
+ * The limits (RLIMIT_MEMLOCK, the minimum working set on Windows) belong
+ * to the host process and are never changed. After the first refusal no
+ * further locks are attempted, so a low limit costs one failed system call
+ * rather than one per region; pages of a refused range that no other Lock
+ * holds are unpinned again, in case the call pinned part of it.
+ */
+bool EngineMemory::Lock::add(void* data, size_t bytes)
+{
+    const auto [start, size] = pageRange(data, bytes);
+    if (size == 0)
+        return true;
+    if (failed)
+        return false;
+
+    auto& pinned = pinnedPages();
+    const std::lock_guard<std::mutex> guard(pinned.mutex);
+
+    const auto first = reinterpret_cast<uintptr_t>(start);
+    if (!lockPages(start, size))
+    {
+        unlockUnheld(pinned, first, size);
+        failed = true;
+        return false;
+    }
+
+    const auto page = static_cast<uintptr_t>(getPageSize());
+    for (uintptr_t p = first; p < first + size; p += page)
+        ++pinned.counts[p];
+
+    regions.emplace_back(start, size);
+    lockedBytes += size;
+    return true;
+}
+
+/**
+ * @brief Drops this Lock's hold on every region in reverse order.
+ *
+ * Only pages no other Lock still holds are unpinned.
+ */
+void EngineMemory::Lock::release()
+{
+    if (regions.empty())
+        return;
+
+    auto& pinned = pinnedPages();
+    const std::lock_guard<std::mutex> guard(pinned.mutex);
+    const auto page = static_cast<uintptr_t>(getPageSize());
+
+    for (auto it = regions.rbegin(); it != regions.rend(); ++it)
+    {
+        const auto first = reinterpret_cast<uintptr_t>(it->first);
+        for (uintptr_t p = first; p < first + it->second; p += page)
+        {
+            const auto count = pinned.counts.find(p);
+            if (count != pinned.counts.end() && --count->second == 0)
+                pinned.counts.erase(count);
+        }
+        unlockUnheld(pinned, first, it->second);
+    }
+
+    regions.clear();
+    lockedBytes = 0;
+}
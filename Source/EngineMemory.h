@@ -0,0 +1,144 @@
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+/**
+ * @class EngineMemory
+ * @brief Prefaults and optionally locks the engine's heap memory.
+ *
+ * Delay lines and scratch buffers are allocated when the engine is built,
+ * but with overcommit (and calloc'd buffers such as juce::AudioBuffer) the
+ * kernel only maps their pages on first write, and an idle instance's pages
+ * may later be swapped out. Either way the audio thread takes the page
+ * faults. Every DSP class therefore exposes visitMemory(), which reports
+ * each heap region it owns; prefault() writes one byte per page of a region
+ * so it is resident before processing starts, and Lock pins regions with
+ * mlock / VirtualLock so they stay resident.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class EngineMemory
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    EngineMemory() = delete;
+
+    /**
+     * @brief Receives one owned heap region (start, size in bytes).
+     */
+    using Visitor = std::function<void(void*, size_t)>;
+
+    /**
+     * @brief Reports the contents of a vector (nothing if it is empty).
+     * @param visit Visitor receiving the region.
+     * @param data Vector owning the region.
+     */
+    template <typename T>
+    static void visit(const Visitor& visit, std::vector<T>& data)
+    {
+        if (!data.empty())
+            visit(data.data(), data.size() * sizeof(T));
+    }
+
+    /**
+     * @brief Reports every channel of an owning audio buffer.
+     * @param visit Visitor receiving the regions.
+     * @param buffer Buffer owning its channel data (not a view).
+     */
+    static void visit(const Visitor& visit, juce::AudioBuffer<float>& buffer);
+
+    /** @brief Size of one virtual memory page in bytes. */
+    static size_t getPageSize();
+
+    /**
+     * @brief Writes one byte per page so the region is mapped and resident.
+     * @param data Start of the region (contents are preserved).
+     * @param bytes Size of the region.
+     * @return Number of pages touched.
+     *
+     * Must not race with other writers of the region (call at prepare time).
+     */
+    static size_t prefault(void* data, size_t bytes);
+
+    /**
+     * @brief Minor page faults taken so far by the whole process.
+     *
+     * Process-wide, so faults in worker threads (OpenMP) are counted too.
+     * Returns -1 where the counter is not available.
+     */
+    static int64_t getMinorPageFaults();
+
+    /**
+     * @class Lock
+     * @brief Pins regions in physical memory until destroyed.
+     *
+     * Regions are rounded out to whole pages and pinned within the
+     * process's existing lock limit, which is never raised (in a plugin it
+     * belongs to the host). Once a lock fails, locking stops and the
+     * remaining regions are only prefaulted. Pages are counted process-wide,
+     * so a page shared with another Lock stays pinned until both are
+     * released.
+     */
+    class Lock
+    {
+    public:
+        /** @brief Creates an empty lock. */
+        Lock() = default;
+
+        /** @brief Unlocks every pinned region. */
+        ~Lock();
+
+        // Copy operations are deleted: each region is unlocked exactly once
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+        // Move operations transfer the pinned regions
+        Lock(Lock&& other) noexcept;
+        Lock& operator=(Lock&& other) noexcept;
+
+        /**
+         * @brief Pins one region.
+         * @param data Start of the region.
+         * @param bytes Size of the region.
+         * @return True if the region is locked; false once the limit is reached.
+         */
+        bool add(void* data, size_t bytes);
+
+        /** @brief Releases every pinned region. */
+        void release();
+
+        /** @brief Bytes pinned so far (whole pages). */
+        size_t getLockedBytes() const { return lockedBytes; }
+
+        /** @brief True if a lock failed and later regions are no longer tried. */
+        bool hasFailed() const { return failed; }
+
+    private:
+        std::vector<std::pair<void*, size_t>> regions; ///< Page-aligned pinned regions
+        size_t lockedBytes = 0;                        ///< Sum of region sizes
+        bool failed = false;                           ///< A lock was refused
+    };
+
+    /**
+     * @struct Stats
+     * @brief Outcome of preparing an engine's memory.
+     */
+    struct Stats
+    {
+        size_t regions = 0;     ///< Heap regions reported by visitMemory()
+        size_t bytes = 0;       ///< Total size of those regions
+        size_t pages = 0;       ///< Pages written by prefault()
+        size_t lockedBytes = 0; ///< Bytes pinned (0 unless locking was requested)
+        bool lockFailed = false; ///< Locking was requested but hit the limit
+    };
+};
@@ -0,0 +1,106 @@
+#include "EngineState.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr char magic[4] = { 'U', 'M', 'B', 'S' }; ///< Snapshot tag
+    constexpr uint32_t version = 1;                   ///< Snapshot format version
+
+    /**
+     * @struct Header
+     * @brief Fixed-size snapshot header; the regions follow it.
+     */
+    struct Header
+    {
+        char magic[4] = {};   ///< "UMBS"
+        uint32_t version = 0; ///< Format version
+        uint32_t seed = 0;    ///< Topology seed of the engine
+        float fs = 0.0f;      ///< Sample rate of the engine
+        uint64_t layout = 0;  ///< FNV-1a hash of the region sizes
+        uint64_t bytes = 0;   ///< Sum of the region sizes
+    };
+
+    /**
+     * @brief Region count, total size and layout hash of a source.
+     */
+    Header describe(const EngineState::Source& source, uint32_t seed, float fs)
+    {
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.seed = seed;
+        header.fs = fs;
+        header.layout = 14695981039346656037ull;
+
+        source([&header](void*, size_t bytes)
+        {
+            header.layout = (header.layout ^ static_cast<uint64_t>(bytes)) * 1099511628211ull;
+            header.bytes += bytes;
+        });
+
+        return header;
+    }
+}
+
+/**
+ * @brief Header plus the sum of the region sizes.
+ */
+size_t EngineState::getSize(const Source& source)
+{
+    return sizeof(Header) + static_cast<size_t>(describe(source, 0, 0.0f).bytes);
+}
+
+/**
+ * @brief Writes the header, then copies every region behind it in visiting order.
+ */
+size_t EngineState::save(const Source& source, uint32_t seed, float fs, void* destination, size_t size)
+{
+    const Header header = describe(source, seed, fs);
+    const size_t total = sizeof(Header) + static_cast<size_t>(header.bytes);
+    if (destination == nullptr || size < total)
+        throw std::invalid_argument("State buffer is too small");
+
+    auto* out = static_cast<char*>(destination);
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+
+    source([&out](void* data, size_t bytes)
+    {
+        std::memcpy(out, data, bytes);
+        out += bytes;
+    });
+
+    return total;
+}
+
+/**
+ * @brief Compares the snapshot header with the engine's, then copies every region back.
+ *
+ * The whole header is checked before the first region is written, so a
+ * rejected snapshot never leaves the engine half restored.
+ */
+void EngineState::restore(const Source& source, uint32_t seed, float fs, const void* data, size_t size)
+{
+    if (data == nullptr || size < sizeof(Header))
+        throw std::invalid_argument("State snapshot is truncated");
+
+    Header stored;
+    std::memcpy(&stored, data, sizeof(Header));
+    if (std::memcmp(stored.magic, magic, sizeof(magic)) != 0 || stored.version != version)
+        throw std::invalid_argument("Not an engine state snapshot");
+
+    const Header expected = describe(source, seed, fs);
+    if (stored.seed != expected.seed || stored.fs != expected.fs)
+        throw std::invalid_argument("State snapshot was taken with another seed or sample rate");
+    if (stored.layout != expected.layout || stored.bytes != expected.bytes
+        || size - sizeof(Header) != static_cast<size_t>(stored.bytes))
+        throw std::invalid_argument("State snapshot does not match the engine's options");
+
+    const auto* in = static_cast<const char*>(data) + sizeof(Header);
+    source([&in](void* region, size_t bytes)
+    {
+        std::memcpy(region, in, bytes);
+        in += bytes;
+    });
+}
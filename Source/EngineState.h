@@ -0,0 +1,104 @@
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+// Project headers
+#include "EngineMemory.h"
+
+/**
+ * @class EngineState
+ * @brief Saves and restores the running DSP state of an engine as one flat snapshot.
+ *
+ * Every DSP class exposes visitState() next to visitMemory(). It reports
+ * each region whose contents change while processing: delay line contents
+ * and write positions, filter and integrator states, smoothers. Topology,
+ * coefficients that follow from the parameters and per-block scratch are
+ * not reported; an engine built with the same seed and options already has
+ * them. A snapshot is a header followed by the regions in visiting order,
+ * each copied with one memcpy, so saving and restoring cost about as much
+ * as touching the state once.
+ *
+ * The header holds the seed, the sample rate and a hash of the region
+ * sizes, so a snapshot is only restored into an engine of the same shape.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class EngineState
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    EngineState() = delete;
+
+    /**
+     * @brief Receives one state region (start, size in bytes).
+     */
+    using Visitor = EngineMemory::Visitor;
+
+    /**
+     * @brief Calls visitState() of the engine with the given visitor.
+     */
+    using Source = std::function<void(const Visitor&)>;
+
+    /**
+     * @brief Reports a plain member (scalar, array or trivially copyable struct).
+     * @param visit Visitor receiving the region.
+     * @param value Member holding state.
+     */
+    template <typename T>
+    static void visit(const Visitor& visit, T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "State members are copied with memcpy");
+        visit(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Reports the contents of a vector (nothing if it is empty).
+     * @param visit Visitor receiving the region.
+     * @param data Vector holding state.
+     */
+    template <typename T>
+    static void visit(const Visitor& visit, std::vector<T>& data)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "State members are copied with memcpy");
+        EngineMemory::visit(visit, data);
+    }
+
+    /**
+     * @brief Size of a snapshot of the source, header included.
+     * @param source Engine state to measure.
+     * @return Bytes needed by save().
+     */
+    static size_t getSize(const Source& source);
+
+    /**
+     * @brief Writes a snapshot (no allocation).
+     * @param source Engine state to save.
+     * @param seed Topology seed of the engine.
+     * @param fs Sample rate of the engine in Hz.
+     * @param destination Receives the snapshot.
+     * @param size Capacity of destination in bytes.
+     * @return Bytes written (getSize()).
+     * @throws std::invalid_argument if size is smaller than getSize().
+     */
+    static size_t save(const Source& source, uint32_t seed, float fs, void* destination, size_t size);
+
+    /**
+     * @brief Checks a snapshot against the engine, then copies it in (no allocation).
+     * @param source Engine state to overwrite.
+     * @param seed Topology seed of the engine.
+     * @param fs Sample rate of the engine in Hz.
+     * @param data Snapshot written by save().
+     * @param size Size of the snapshot in bytes.
+     * @throws std::invalid_argument if the snapshot is malformed or was taken
+     *         from an engine with another seed, sample rate or shape; the
+     *         engine is left untouched then.
+     */
+    static void restore(const Source& source, uint32_t seed, float fs, const void* data, size_t size);
+};
@@ -1,42 +1,112 @@
 #include "FDN.h"
+#include <algorithm>
 #include <random>
 #include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief Smallest prime >= n (trial division; construction only).
+     */
+    int nextPrime(int n)
+    {
+        for (n = std::max(n, 2);; ++n)
+        {
+            bool prime = true;
+            for (int d = 2; d * d <= n && prime; ++d)
+                prime = n % d != 0;
+            if (prime)
+                return n;
+        }
+    }
+}
 
 /**
  * @brief Constructs a Feedback Delay Network with randomized delay lines and feedback gains.
  *
  * Each delay line length is jittered randomly around the base length `m` to decorrelate echoes.
  * Feedback gains are randomly assigned to provide a natural-sounding reverberation.
- * Low-pass damping filters are initialized with default parameters (will be updated in process()).
+ * Damping and absorption coefficients are set by the first process() call.
+ *
+ * With a decay target every line (including the first, which is otherwise
+ * a one-sample dummy) gets a distinct prime length drawn the same way, so
+ * no two lines share a period; the absorption filters then replace the
+ * random gains.
  *
  * @param N Number of delay lines (and typically audio channels).
  * @param m Base delay length in samples.
  * @param blockSize Maximum block size for internal buffers.
+ * @param matrix Feedback matrix used to mix the delay lines.
+ * @param storage Sample format of the delay line contents.
+ * @param seed Topology seed (same seed, same delays and gains).
+ * @param decay Band T60 targets (absorption filters when decay.low > 0).
+ * @throws std::invalid_argument if N < 1, if Hadamard mixing is requested
+ *         for a line count that is not a power of two, or if a decay time
+ *         is negative.
  */
-FDN::FDN(const int& N, const int& m, int blockSize) : N(N)
+FDN::FDN(const int& N, const int& m, int blockSize, FeedbackMatrixType matrix,
+    DelayLine::Storage storage, uint32_t seed, FDNDecay decay)
+    : N(N), decay(decay), matrixType(matrix)
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    if (N < 1)
+        throw std::invalid_argument("Number of delay lines must be at least 1.");
+
+    if (matrix == FeedbackMatrixType::Hadamard && (N & (N - 1)) != 0)
+        throw std::invalid_argument("Hadamard feedback requires a power-of-2 number of lines.");
+
+    if (decay.low < 0.0f || decay.high < 0.0f)
+        throw std::invalid_argument("Decay times must not be negative.");
+
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<float> jitter(1.0f, 2.0f); // Delay jitter factor
     std::uniform_real_distribution<float> gain(0.8f, 0.9f);   // Feedback gains
 
-    z.push_back(std::make_unique<DelayLine>(0, 0.0f, blockSize)); // Dummy first delay
-
     M.resize(N);
-    for (int i = 1; i < N; ++i)
+    if (decay.low > 0.0f)
+    {
+        // Absorption: distinct prime lengths for every line, unit gains
+        for (int i = 0; i < N; ++i)
+        {
+            int length = nextPrime(static_cast<int>(std::round(m * jitter(gen))));
+            while (std::find(M.begin(), M.begin() + i, length) != M.begin() + i)
+                length = nextPrime(length + 1);
+
+            M[i] = length;
+            z.push_back(std::make_unique<DelayLine>(2 * M[i], 0.0f, blockSize, storage));
+        }
+
+        g.resize(N, 1.0f);
+        shelfB0.resize(N, 0.0f);
+        shelfB1.resize(N, 0.0f);
+        gainLow.resize(N, 1.0f);
+        gainHigh.resize(N, 1.0f);
+    }
+    else
     {
-        // Randomize delay lengths
-        M[i] = static_cast<int>(std::round(m * jitter(gen)));
-        z.push_back(std::make_unique<DelayLine>(2 * M[i], 0.0f, blockSize));
+        z.push_back(std::make_unique<DelayLine>(0, 0.0f, blockSize, storage)); // Dummy first delay
+
+        for (int i = 1; i < N; ++i)
+        {
+            // Randomize delay lengths
+            M[i] = static_cast<int>(std::round(m * jitter(gen)));
+            z.push_back(std::make_unique<DelayLine>(2 * M[i], 0.0f, blockSize, storage));
+        }
+
+        g.resize(N);
+        for (int i = 0; i < N; ++i)
+            g[i] = gain(gen);
     }
 
-    g.resize(N);
-    for (int i = 0; i < N; ++i)
-        g[i] = gain(gen);
+    s1.resize(N, 0.0f);
+    s2.resize(N, 0.0f);
 
-    H.resize(N);
-    for (auto& filter : H)
-        filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(44100.0, 8000.0);
+    if (matrixType == FeedbackMatrixType::Velvet)
+        velvet = VelvetMatrix(N, gen);
+
+    taus.resize(N, 0);
+    inputFrame.resize(N, 0.0f);
+    outputFrame.resize(N, 0.0f);
 }
 
 /**
@@ -44,51 +114,316 @@ FDN::FDN(const int& N, const int& m, int blockSize) : N(N)
  *
  * Steps:
  * 1. Read each delay line at the scaled delay position (M[ch] * roomSize).
- * 2. Mix all delay line outputs using a Hadamard transform for energy redistribution.
- * 3. Apply damping filter (low-pass) and feedback gain.
+ * 2. Mix all delay line outputs using the feedback matrix for energy redistribution.
+ * 3. Apply damping filter (low-pass) and feedback gain, or the line's
+ *    absorption shelf.
  * 4. Add input signal to the feedback signal and write back into the delay lines.
  * 5. Replace the input buffer with the processed wet signal.
  *
+ * The matrix type and filter type are resolved once per block; the
+ * per-sample loop itself is specialized on them and the line count.
+ *
  * @param buffer Audio buffer to process in-place.
- * @param dampening Low-pass cutoff frequency (Hz) for damping filters.
+ * @param dampening Low-pass cutoff frequency (Hz) for damping filters, or
+ *        the absorption crossover.
+ * @param coefficients Filter designs for the buffer's sample rate.
+ * @param roomSize Scaling factor affecting effective delay read positions.
+ */
+void FDN::process(juce::AudioBuffer<float>& buffer, float dampening, const CoefficientTable& coefficients, float roomSize)
+{
+    const bool absorbing = decay.low > 0.0f;
+    const double fs = coefficients.getSampleRate();
+    const bool rateChanged = fs != previousFs;
+
+    if (absorbing)
+    {
+        // Control rate: the band gains depend on the effective lengths (room
+        // size); the shelves on those gains and the crossover
+        const bool gainsChanged = rateChanged || roomSize != previousRoomSize;
+        if (gainsChanged)
+        {
+            setAbsorptionGains(fs, roomSize);
+            previousRoomSize = roomSize;
+        }
+        if (gainsChanged || dampening != previousDampening)
+        {
+            setAbsorptionShelves(coefficients.onePole(dampening));
+            previousDampening = dampening;
+        }
+        previousFs = fs;
+    }
+    else if (dampening != previousDampening || rateChanged)
+    {
+        // Look up the low-pass damping coefficients only when the cutoff
+        // changed; all lines share one coefficient set
+        damping = coefficients.lowPass(dampening);
+        previousDampening = dampening;
+        previousFs = fs;
+    }
+
+    const auto run = [&](auto& matrix)
+    {
+        if (absorbing)
+            processWithMatrix<true>(matrix, buffer, roomSize);
+        else
+            processWithMatrix<false>(matrix, buffer, roomSize);
+    };
+
+    switch (matrixType)
+    {
+    case FeedbackMatrixType::Householder:
+    {
+        HouseholderMatrix householder;
+        run(householder);
+        break;
+    }
+    case FeedbackMatrixType::Velvet:
+        run(velvet);
+        break;
+    case FeedbackMatrixType::Hadamard:
+    default:
+    {
+        HadamardMatrix hadamard;
+        run(hadamard);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Computes the per-pass band gains of every line.
+ *
+ * A line whose effective delay is L samples must attenuate by
+ * k = 10^(-3 L / (fs T60)) per pass for the network to decay at T60.
+ * Both T60s and the lengths scale with roomSize, so this only runs when
+ * the room size (or sample rate) changes.
+ *
  * @param fs Sample rate (Hz).
+ * @param roomSize Delay scaling.
+ */
+void FDN::setAbsorptionGains(double fs, float roomSize)
+{
+    const double scale = std::max(static_cast<double>(roomSize), 0.01);
+    const double low = decay.low * scale;
+    const double high = (decay.high > 0.0f ? decay.high : decay.low) * scale;
+
+    for (int i = 0; i < N; ++i)
+    {
+        // readSample(tau) returns x[n - tau - 1]
+        const double length = static_cast<int>(M[i] * roomSize) + 1.0;
+        gainLow[i] = static_cast<float>(std::pow(10.0, -3.0 * length / (fs * low)));
+        gainHigh[i] = static_cast<float>(std::pow(10.0, -3.0 * length / (fs * high)));
+    }
+}
+
+/**
+ * @brief Designs Jot's first-order absorption shelf for every line.
+ *
+ * The shelf H(z) = (b0 + b1 z^-1) / (1 + a1 z^-1) is the bilinear
+ * transform of (k_high s + k_low) / (s + 1) prewarped to the crossover, so
+ * H(1) = k_low and H(-1) = k_high exactly; the pole depends only on the
+ * crossover and is shared by all lines. With a1 = (K - 1) / (K + 1) the
+ * usual K / (1 + K) and 1 / (1 + K) are (1 + a1) / 2 and (1 - a1) / 2, so
+ * the tabulated pole is all the shelves need: two multiply-adds per line.
+ *
+ * @param pole Bilinear one-pole coefficient of the crossover (CoefficientTable::onePole).
+ */
+void FDN::setAbsorptionShelves(float pole)
+{
+    const float low = 0.5f * (1.0f + pole);
+    const float high = 0.5f * (1.0f - pole);
+    shelfA1 = pole;
+
+    for (int i = 0; i < N; ++i)
+    {
+        shelfB0[i] = gainHigh[i] * high + gainLow[i] * low;
+        shelfB1[i] = gainLow[i] * low - gainHigh[i] * high;
+    }
+}
+
+/**
+ * @brief Dispatches to a line-count specialization of the per-sample loop.
+ */
+template <bool Absorbing, typename Matrix>
+void FDN::processWithMatrix(Matrix& matrix, juce::AudioBuffer<float>& buffer, float roomSize)
+{
+    switch (N)
+    {
+    case 8:  processLines<8, Absorbing>(matrix, buffer, roomSize); break;
+    case 16: processLines<16, Absorbing>(matrix, buffer, roomSize); break;
+    case 32: processLines<32, Absorbing>(matrix, buffer, roomSize); break;
+    default: processLines<0, Absorbing>(matrix, buffer, roomSize); break;
+    }
+}
+
+/**
+ * @brief Reads the delayed sample of every line in one pass.
+ *
+ * The read offsets are fixed for the block and checked in processLines(),
+ * so each read is one index computation and load straight from the line's
+ * storage (FDN is a friend of DelayLine), with no call or range check per
+ * line and sample.
+ */
+void FDN::gatherFrame(float* frame, int numLines) const
+{
+    for (int ch = 0; ch < numLines; ++ch)
+    {
+        const DelayLine& line = *z[ch];
+        int read = line.write - taus[ch] - 1;
+        if (read < 0)
+            read += line.bufferSize;
+
+        frame[ch] = line.storage == DelayLine::Storage::Float32
+            ? line.buffer[read]
+            : line.decode(line.compact[read]);
+    }
+}
+
+/**
+ * @brief Per-sample FDN recursion for a fixed matrix policy, line count and filter type.
+ *
+ * @tparam Lines Compile-time number of lines (0 = use runtime N).
+ * @tparam Absorbing Per-line absorption shelves instead of the shared low-pass.
+ * @param matrix Feedback matrix policy.
+ * @param buffer Audio buffer to process in-place (one channel per line, or
+ *        fewer channels shared by several lines).
  * @param roomSize Scaling factor affecting effective delay read positions.
  */
-void FDN::process(juce::AudioBuffer<float>& buffer, float dampening, double fs, float roomSize)
+template <int Lines, bool Absorbing, typename Matrix>
+void FDN::processLines(Matrix& matrix, juce::AudioBuffer<float>& buffer, float roomSize)
 {
     const int numSamples = buffer.getNumSamples();
-    const int N = static_cast<int>(z.size()); // Number of delay lines
+    const int numLines = Lines > 0 ? Lines : N;
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numLines);
+    const float fanIn = std::sqrt(static_cast<float>(numChannels) / static_cast<float>(numLines));
 
-    std::vector<float> inputFrame(N, 0.0f);
-    std::vector<float> outputFrame(N, 0.0f);
+    float* in = inputFrame.data();
+    float* out = outputFrame.data();
+    float* state1 = s1.data();
+    float* state2 = s2.data();
+    const CoefficientTable::Biquad c = damping;
+    const float* b0 = shelfB0.data();
+    const float* b1 = shelfB1.data();
+    const float a1 = shelfA1;
 
-    // Update low-pass damping filter coefficients for each delay line
-    for (int ch = 0; ch < N; ++ch)
-        H[ch].coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(fs, dampening);
+    // The read offsets only change with the room size: compute and check
+    // them once per block (same range as DelayLine::readSample)
+    for (int ch = 0; ch < numLines; ++ch)
+    {
+        taus[ch] = static_cast<int>(M[ch] * roomSize);
+        if (taus[ch] > z[ch]->M || taus[ch] < 0)
+            throw std::out_of_range("Tau exceeds maximum delay");
+    }
 
     for (int sample = 0; sample < numSamples; ++sample)
     {
         // Step 1: Read current input samples into frame
-        for (int ch = 0; ch < N; ++ch)
-            inputFrame[ch] = buffer.getSample(ch, sample);
+        for (int ch = 0; ch < numLines; ++ch)
+            in[ch] = buffer.getSample(ch < numChannels ? ch : ch % numChannels, sample);
 
         // Step 2: Read delayed samples for feedback
-        for (int ch = 0; ch < N; ++ch)
-            outputFrame[ch] = z[ch]->readSample(static_cast<int>(M[ch] * roomSize));
+        gatherFrame(out, numLines);
 
         // Step 3: Write processed wet signal to output buffer
-        for (int ch = 0; ch < N; ++ch)
-            buffer.setSample(ch, sample, outputFrame[ch]);
+        if (numChannels == numLines)
+        {
+            for (int ch = 0; ch < numLines; ++ch)
+                buffer.setSample(ch, sample, out[ch]);
+        }
+        else
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float sum = 0.0f;
+                for (int line = ch; line < numLines; line += numChannels)
+                    sum += out[line];
+                buffer.setSample(ch, sample, fanIn * sum);
+            }
+        }
 
-        // Step 4: Mix delay line outputs using Hadamard transform
-        Hadamard::process(outputFrame);
+        // Step 4: Mix delay line outputs using the feedback matrix
+        matrix.template process<Lines>(out, numLines);
 
-        // Step 5: Apply damping filter and feedback gain, then add input
-        for (int ch = 0; ch < N; ++ch)
-            outputFrame[ch] = inputFrame[ch] + g[ch] * H[ch].processSample(outputFrame[ch]);
+        // Step 5: Apply damping (TDF-II) and feedback gain, or the absorption
+        // shelves (first-order TDF-II, one pole for the bank), then add input
+        if constexpr (Absorbing)
+        {
+            for (int ch = 0; ch < numLines; ++ch)
+            {
+                const float x = out[ch];
+                const float y = b0[ch] * x + state1[ch];
+                state1[ch] = b1[ch] * x - a1 * y;
+                out[ch] = in[ch] + y;
+            }
+        }
+        else
+        {
+            for (int ch = 0; ch < numLines; ++ch)
+            {
+                const float x = out[ch];
+                const float y = c.b0 * x + state1[ch];
+                state1[ch] = c.b1 * x - c.a1 * y + state2[ch];
+                state2[ch] = c.b2 * x - c.a2 * y;
+                out[ch] = in[ch] + g[ch] * y;
+            }
+        }
 
         // Step 6: Write processed samples back into delay lines
-        for (int ch = 0; ch < N; ++ch)
-            z[ch]->writeSample(outputFrame[ch]);
+        for (int ch = 0; ch < numLines; ++ch)
+            z[ch]->writeSample(out[ch]);
     }
 }
+
+/**
+ * @brief Zeroes the delay lines, filter states and frames.
+ */
+void FDN::reset()
+{
+    for (auto& line : z)
+        line->reset();
+
+    std::fill(s1.begin(), s1.end(), 0.0f);
+    std::fill(s2.begin(), s2.end(), 0.0f);
+
+    std::fill(inputFrame.begin(), inputFrame.end(), 0.0f);
+    std::fill(outputFrame.begin(), outputFrame.end(), 0.0f);
+}
+
+/**
+ * @brief Reports the delay lines, per-line tables, damping states, velvet matrix and frames.
+ */
+void FDN::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, M);
+    EngineMemory::visit(visit, g);
+    EngineMemory::visit(visit, z);
+
+    for (auto& line : z)
+        line->visitMemory(visit);
+
+    EngineMemory::visit(visit, s1);
+    EngineMemory::visit(visit, s2);
+    EngineMemory::visit(visit, shelfB0);
+    EngineMemory::visit(visit, shelfB1);
+    EngineMemory::visit(visit, gainLow);
+    EngineMemory::visit(visit, gainHigh);
+    velvet.visitMemory(visit);
+    EngineMemory::visit(visit, taus);
+    EngineMemory::visit(visit, inputFrame);
+    EngineMemory::visit(visit, outputFrame);
+}
+
+/**
+ * @brief Reports the delay lines and damping states.
+ *
+ * The frames are overwritten every sample, and the coefficients follow the
+ * dampening passed to the next process() call.
+ */
+void FDN::visitState(const EngineState::Visitor& visit)
+{
+    for (auto& line : z)
+        line->visitState(visit);
+
+    EngineState::visit(visit, s1);
+    EngineState::visit(visit, s2);
+}
@@ -10,16 +10,50 @@
 #include <juce_dsp/juce_dsp.h>
 
 // Project headers
+#include "CoefficientTable.h"
 #include "DelayLine.h"
-#include "Hadamard.h"
+#include "FeedbackMatrix.h"
+
+/**
+ * @struct FDNDecay
+ * @brief Per-band reverberation time targets for FDN absorption filters.
+ *
+ * Times are given at roomSize 1 and scale with it, as the delays do.
+ * A low time of 0 keeps the shared low-pass damping and random gains;
+ * a high time of 0 uses the low time for both bands.
+ */
+struct FDNDecay
+{
+    float low = 0.0f;  ///< T60 (seconds) below the crossover
+    float high = 0.0f; ///< T60 (seconds) above the crossover
+};
 
 /**
  * @class FDN
  * @brief Implements a Feedback Delay Network (FDN) for reverb and diffusion.
  *
  * The FDN class manages multiple delay lines with feedback and optional damping
- * via low-pass IIR filters. A Hadamard transform mixes the delay lines for
- * energy redistribution, creating a dense reverberation tail.
+ * via low-pass biquads (one shared coefficient set, a flat state array per
+ * line, so the filter memories can be saved with the delay lines). An
+ * orthogonal feedback matrix (Hadamard, Householder or sparse velvet, see
+ * FeedbackMatrix.h) mixes the delay lines for energy redistribution,
+ * creating a dense reverberation tail.
+ *
+ * With an FDNDecay target the network is built for a prescribed reverberation
+ * time instead (Jot's absorption filters): every line gets a prime length
+ * and its own first-order shelf whose DC and Nyquist gains follow from
+ * that line's effective length and the low- and high-band T60, so every
+ * loop through the network decays at the same rate. The shelves share one
+ * pole (the crossover), so the bank is a flat per-line b0/b1 array that
+ * vectorizes across lines. The per-line band gains are recomputed only
+ * when the room size or sample rate changes; a crossover change only
+ * looks up the shared pole in the CoefficientTable and remixes the shelves.
+ * The damping low-pass is looked up in the same table, so modulating the
+ * dampening costs no transcendental math.
+ *
+ * A buffer with fewer channels than lines feeds line i from channel
+ * i % channels, and each channel receives the energy-normalized sum of
+ * its lines.
  *
  * The class is non-copyable due to unique_ptr storage, but supports move semantics.
  */
@@ -31,11 +65,23 @@ public:
      * @param N Number of delay lines (typically equal to number of channels).
      * @param m Base delay length used to initialize each delay line.
      * @param blockSize Maximum block size for internal buffers.
+     * @param matrix Feedback matrix used to mix the delay lines.
+     * @param storage Sample format of the delay line contents (FP16/BF16 halve
+     *        memory traffic; feedback math stays in float).
+     * @param seed Seed for delay lengths, gains and (velvet) signs/permutation.
+     * @param decay Band T60 targets; enables the absorption filters when set.
+     * @throws std::invalid_argument if N < 1, if the Hadamard matrix is
+     *         requested with N not a power of two, or if a decay time is negative.
      *
      * Each delay line's length is jittered randomly around m for decorrelation.
-     * Random gains are assigned to each feedback path.
+     * Random gains are assigned to each feedback path (absorption filters
+     * replace them when a decay target is set).
      */
-    FDN(const int& N, const int& m, int blockSize);
+    FDN(const int& N, const int& m, int blockSize,
+        FeedbackMatrixType matrix = FeedbackMatrixType::Hadamard,
+        DelayLine::Storage storage = DelayLine::Storage::Float32,
+        uint32_t seed = 0,
+        FDNDecay decay = {});
 
     /** @brief Default constructor (produces empty, uninitialized FDN). */
     FDN() = default;
@@ -54,24 +100,97 @@ public:
     /**
      * @brief Processes an audio buffer through the FDN.
      * @param buffer Audio buffer to process in-place.
-     * @param dampening Low-pass cutoff frequency for damping filters (Hz).
-     * @param fs Sample rate of the audio buffer (Hz).
+     * @param dampening Low-pass cutoff frequency for damping filters (Hz);
+     *        with absorption filters, the crossover between the two bands.
+     * @param coefficients Filter designs for the sample rate of the buffer.
      * @param roomSize Scaling factor for perceived room size affecting delay indices.
      *
-     * Each sample is read from the delay lines, mixed via a Hadamard transform,
+     * Each sample is read from the delay lines, mixed via the feedback matrix,
      * filtered by the damping filters, and written back to the delay lines.
      * The final output replaces the input buffer contents.
      */
     void process(juce::AudioBuffer<float>& buffer,
         float dampening,
-        double fs,
+        const CoefficientTable& coefficients,
         float roomSize);
 
+    /**
+     * @brief Clears the delay lines and damping filter states (no allocation).
+     *
+     * Topology, gains and the current damping coefficients are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by the delay lines and mixing buffers.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the delay lines and damping filter states (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
 private:
+    /**
+     * @brief Selects the compile-time line count for a given matrix policy.
+     *
+     * 8, 16 and 32 lines get fully specialized kernels; other counts use the
+     * generic runtime-N path.
+     */
+    template <bool Absorbing, typename Matrix>
+    void processWithMatrix(Matrix& matrix, juce::AudioBuffer<float>& buffer, float roomSize);
+
+    /** @brief Per-sample FDN loop, specialized on matrix policy, line count and filter type. */
+    template <int Lines, bool Absorbing, typename Matrix>
+    void processLines(Matrix& matrix, juce::AudioBuffer<float>& buffer, float roomSize);
+
+    /**
+     * @brief Reads every line at its block read offset into a frame.
+     * @param frame Receives one delayed sample per line.
+     * @param numLines Number of lines.
+     */
+    void gatherFrame(float* frame, int numLines) const;
+
+    /**
+     * @brief Computes every line's per-pass gain in both bands for its effective length.
+     * @param fs Sample rate (Hz).
+     * @param roomSize Delay scaling (sets the effective lengths and T60s).
+     */
+    void setAbsorptionGains(double fs, float roomSize);
+
+    /**
+     * @brief Designs every line's absorption shelf from its band gains.
+     * @param pole Bilinear one-pole coefficient of the crossover frequency.
+     */
+    void setAbsorptionShelves(float pole);
+
     int N = 0; ///< Number of delay lines
     std::vector<int> M; ///< Delay line lengths
     std::vector<float> g; ///< Feedback gains per delay line
 
     std::vector<std::unique_ptr<DelayLine>> z; ///< Delay line storage
-    std::vector<juce::dsp::IIR::Filter<float>> H; ///< Damping filters per delay line
+
+    CoefficientTable::Biquad damping; ///< Damping low-pass coefficients, shared by all lines
+    std::vector<float> s1; ///< First TDF-II damping state per line
+    std::vector<float> s2; ///< Second TDF-II damping state per line
+    float previousDampening = -1.0f; ///< Cutoff of the current damping coefficients
+    double previousFs = 0.0;         ///< Sample rate of the current damping coefficients
+
+    FDNDecay decay;                  ///< Band T60 targets (absorption filters when decay.low > 0)
+    std::vector<float> shelfB0;      ///< Absorption shelf b0 per line (gain included)
+    std::vector<float> shelfB1;      ///< Absorption shelf b1 per line
+    std::vector<float> gainLow;      ///< Per-pass gain below the crossover per line
+    std::vector<float> gainHigh;     ///< Per-pass gain above the crossover per line
+    float shelfA1 = 0.0f;            ///< Absorption shelf pole, shared by all lines
+    float previousRoomSize = -1.0f;  ///< Room size of the current absorption coefficients
+
+    FeedbackMatrixType matrixType = FeedbackMatrixType::Hadamard; ///< Active feedback matrix
+    VelvetMatrix velvet; ///< Sparse matrix state (used when matrixType == Velvet)
+
+    std::vector<int> taus;          ///< Read offset of every line for the current block
+    std::vector<float> inputFrame;  ///< Per-sample input frame (one value per line)
+    std::vector<float> outputFrame; ///< Per-sample delay output / mixing frame
 };
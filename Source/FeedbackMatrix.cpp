@@ -0,0 +1,43 @@
+#include "FeedbackMatrix.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a sparse velvet feedback matrix.
+ *
+ * Draws a random ±1 sign per line and a random permutation of the lines.
+ * Both are fixed for the lifetime of the matrix, so the FDN stays
+ * time-invariant.
+ *
+ * @param N Number of delay lines.
+ * @param gen Random generator (shared with the owning FDN).
+ * @throws std::invalid_argument if N < 1.
+ */
+VelvetMatrix::VelvetMatrix(int N, std::mt19937& gen)
+{
+    if (N < 1)
+        throw std::invalid_argument("Number of lines must be at least 1.");
+
+    std::bernoulli_distribution coin(0.5);
+
+    signs.resize(N);
+    for (auto& sign : signs)
+        sign = coin(gen) ? 1.0f : -1.0f;
+
+    permutation.resize(N);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), gen);
+
+    scratch.resize(N, 0.0f);
+}
+
+/**
+ * @brief Reports the permutation, signs and scratch frame.
+ */
+void VelvetMatrix::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, permutation);
+    EngineMemory::visit(visit, signs);
+    EngineMemory::visit(visit, scratch);
+}
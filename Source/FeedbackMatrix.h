@@ -0,0 +1,166 @@
+#pragma once
+
+// Standard library
+#include <vector>
+#include <random>
+#include <cmath>
+
+// Project headers
+#include "EngineMemory.h"
+#include "Hadamard.h"
+
+/**
+ * @enum FeedbackMatrixType
+ * @brief Selects the orthogonal mixing matrix used in the FDN feedback path.
+ */
+enum class FeedbackMatrixType
+{
+    Hadamard,    ///< Fast Walsh-Hadamard transform, O(N log N), N must be a power of two
+    Householder, ///< I - (2/N)·1·1^T, O(N), any N
+    Velvet       ///< Sparse nested matrix (signs, 4x4 blocks, permutation), O(N), any N
+};
+
+/*
+ * Feedback matrix policies.
+ *
+ * Each policy exposes `template <int Lines> process(float* frame, int N)`.
+ * When Lines > 0 the line count is a compile-time constant and the mixing
+ * loops are fully unrolled by the compiler; Lines == 0 selects the generic
+ * runtime-N path. All policies are orthogonal, so the FDN stays lossless
+ * before the attenuation filters.
+ */
+
+/**
+ * @struct HadamardMatrix
+ * @brief Normalized Hadamard mixing (Sylvester construction).
+ */
+struct HadamardMatrix
+{
+    template <int Lines>
+    static void process(float* frame, int N)
+    {
+        if constexpr (Lines == 0)
+        {
+            Hadamard::process(frame, N);
+        }
+        else
+        {
+            static_assert((Lines & (Lines - 1)) == 0, "Hadamard size must be a power of 2");
+
+            for (int len = 1; len < Lines; len <<= 1)
+                for (int i = 0; i < Lines; i += (len << 1))
+                    for (int j = 0; j < len; ++j)
+                    {
+                        const float a = frame[i + j];
+                        const float b = frame[i + j + len];
+                        frame[i + j] = a + b;
+                        frame[i + j + len] = a - b;
+                    }
+
+            const float scale = 1.0f / std::sqrt(static_cast<float>(Lines));
+            for (int i = 0; i < Lines; ++i)
+                frame[i] *= scale;
+        }
+    }
+};
+
+/**
+ * @struct HouseholderMatrix
+ * @brief Householder reflection A = I - (2/N)·1·1^T.
+ *
+ * Costs one sum and one scaled subtraction per frame. The sum is accumulated
+ * in 8 independent partial sums so it vectorizes without reassociation and
+ * always reduces in the same order.
+ */
+struct HouseholderMatrix
+{
+    template <int Lines>
+    static void process(float* frame, int N)
+    {
+        const int n = Lines > 0 ? Lines : N;
+
+        float partial[8] = {};
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+            for (int lane = 0; lane < 8; ++lane)
+                partial[lane] += frame[i + lane];
+        for (; i < n; ++i)
+            partial[i & 7] += frame[i];
+
+        const float sum = ((partial[0] + partial[1]) + (partial[2] + partial[3]))
+                        + ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+        const float offset = (2.0f / static_cast<float>(n)) * sum;
+
+        for (int k = 0; k < n; ++k)
+            frame[k] -= offset;
+    }
+};
+
+/**
+ * @class VelvetMatrix
+ * @brief Sparse "velvet" feedback matrix built from nested orthogonal factors.
+ *
+ * A = P · B · S, where S is a random ±1 diagonal, B is block-diagonal with
+ * normalized 4x4 Hadamard blocks (a Householder block covers any remainder),
+ * and P is a random permutation. Every row has at most four non-zeros, so
+ * mixing is O(N), while the permutation spreads energy across blocks on every
+ * recirculation and echo density still builds up quickly.
+ */
+class VelvetMatrix
+{
+public:
+    /** @brief Default constructor (empty matrix, must be configured before use). */
+    VelvetMatrix() = default;
+
+    /**
+     * @brief Constructs a velvet matrix for N lines.
+     * @param N Number of delay lines.
+     * @param gen Random generator used for signs and permutation.
+     * @throws std::invalid_argument if N < 1.
+     */
+    VelvetMatrix(int N, std::mt19937& gen);
+
+    template <int Lines>
+    void process(float* frame, int N)
+    {
+        const int n = Lines > 0 ? Lines : N;
+        const int blocks = n & ~3;
+        float* tmp = scratch.data();
+
+        // S: random signs
+        for (int i = 0; i < n; ++i)
+            tmp[i] = frame[i] * signs[i];
+
+        // B: normalized 4x4 Hadamard blocks
+        for (int i = 0; i < blocks; i += 4)
+        {
+            const float a = tmp[i] + tmp[i + 1];
+            const float b = tmp[i] - tmp[i + 1];
+            const float c = tmp[i + 2] + tmp[i + 3];
+            const float d = tmp[i + 2] - tmp[i + 3];
+            tmp[i]     = 0.5f * (a + c);
+            tmp[i + 1] = 0.5f * (b + d);
+            tmp[i + 2] = 0.5f * (a - c);
+            tmp[i + 3] = 0.5f * (b - d);
+        }
+
+        // Remainder block (1..3 lines): Householder reflection
+        if (blocks < n)
+            HouseholderMatrix::process<0>(tmp + blocks, n - blocks);
+
+        // P: scatter through the permutation
+        for (int i = 0; i < n; ++i)
+            frame[permutation[i]] = tmp[i];
+    }
+
+    /**
+     * @brief Reports the heap regions owned by this matrix.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+private:
+    std::vector<int> permutation; ///< Output line for each mixed input line
+    std::vector<float> signs;     ///< Random ±1 input signs
+    std::vector<float> scratch;   ///< Per-frame working buffer
+};
@@ -0,0 +1,651 @@
+#include "FrozenTail.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int numInputs = 2;  ///< Lane 0 and lanes 1-7
+    constexpr int numOutputs = 2; ///< Wet channels read by the output stage
+
+    /** @brief log2 of a power of two. */
+    int orderOf(int size)
+    {
+        int order = 0;
+        while ((1 << order) < size)
+            ++order;
+        return order;
+    }
+}
+
+/**
+ * @class FrozenTail::RenderThread
+ * @brief Renders the grid once, then exits.
+ */
+class FrozenTail::RenderThread : public juce::Thread
+{
+public:
+    explicit RenderThread(FrozenTail& owner) : juce::Thread("Umbra IR grid"), owner(owner) {}
+
+    ~RenderThread() override { stopThread(-1); }
+
+    void run() override
+    {
+        if (owner.renderGrid())
+        {
+            if (owner.lockGrid)
+                owner.lockPoints();
+            owner.ready.store(true, std::memory_order_release);
+        }
+        owner.finished.signal();
+    }
+
+private:
+    FrozenTail& owner;
+};
+
+/**
+ * @brief Allocates the convolution state and starts rendering the grid.
+ *
+ * Everything the audio thread touches is sized here from the longest
+ * possible response, so process() never allocates; the grid points are
+ * filled in by the render thread.
+ *
+ * @param fs Sample rate in Hz.
+ * @param grid Grid layout and response length.
+ * @param renderer Chain renderer, called on the background thread.
+ * @param lockGrid Pin the rendered spectra in memory once the grid is complete.
+ * @throws std::invalid_argument on an empty or inverted grid, or a
+ *         non-positive response length.
+ */
+FrozenTail::FrozenTail(double fs, const Grid& grid, ResponseRenderer renderer, bool lockGrid)
+    : fs(fs), grid(grid), renderer(std::move(renderer)), lockGrid(lockGrid)
+{
+    if (grid.roomSizePoints < 1 || grid.dampeningPoints < 1)
+        throw std::invalid_argument("Frozen grid needs at least one point per parameter.");
+    if (grid.minRoomSize <= 0.0f || grid.maxRoomSize < grid.minRoomSize
+        || grid.minDampening <= 0.0f || grid.maxDampening < grid.minDampening)
+        throw std::invalid_argument("Frozen grid ranges must be positive and ascending.");
+    if (grid.maxSeconds <= 0.0f)
+        throw std::invalid_argument("Frozen response length must be positive.");
+
+    maxLength = static_cast<int>(std::ceil(grid.maxSeconds * fs));
+    const int maxTailParts = juce::jmax(0, (maxLength - tailPartition + tailPartition - 1) / tailPartition);
+
+    // One extra slot for the current block; the tail also keeps the block
+    // before its oldest partition, which prime() needs
+    prepareStage(head, headPartition, tailPartition / headPartition + 1);
+    prepareStage(tail, tailPartition, maxTailParts + 2);
+    fftData.assign(4 * static_cast<size_t>(tailPartition), 0.0f);
+
+    points.resize(static_cast<size_t>(grid.roomSizePoints) * grid.dampeningPoints);
+
+    thread = std::make_unique<RenderThread>(*this);
+    thread->startThread();
+}
+
+/**
+ * @brief Stops the render thread; the renderer polls for the exit request.
+ */
+FrozenTail::~FrozenTail()
+{
+    thread.reset();
+}
+
+/**
+ * @brief Waits for the render thread to finish.
+ */
+bool FrozenTail::waitUntilReady(int timeoutMs)
+{
+    finished.wait(timeoutMs);
+    return isReady();
+}
+
+/**
+ * @brief Sizes the buffers and transform of one stage.
+ */
+void FrozenTail::prepareStage(Stage& stage, int size, int ring)
+{
+    stage.size = size;
+    stage.bins = size + 1;
+    stage.ring = ring;
+    stage.fft = std::make_unique<juce::dsp::FFT>(orderOf(2 * size));
+
+    const size_t spectra = static_cast<size_t>(numInputs) * ring * stage.bins;
+    const size_t outputBins = static_cast<size_t>(numOutputs) * stage.bins;
+    const size_t outputSamples = static_cast<size_t>(numOutputs) * size;
+
+    stage.block.assign(static_cast<size_t>(numInputs) * size, 0.0f);
+    stage.inputRe.assign(spectra, 0.0f);
+    stage.inputIm.assign(spectra, 0.0f);
+    stage.accRe.assign(outputBins, 0.0f);
+    stage.accIm.assign(outputBins, 0.0f);
+    stage.pastRe.assign(outputBins, 0.0f);
+    stage.pastIm.assign(outputBins, 0.0f);
+    stage.overlap.assign(outputSamples, 0.0f);
+    stage.output.assign(outputSamples, 0.0f);
+}
+
+/**
+ * @brief Renders every grid point and partitions its responses.
+ *
+ * Steps per point:
+ * 1. Render maxLength samples of the four chain responses.
+ * 2. Truncate where all of them have decayed 60 dB below the overall peak,
+ *    with a short fade so the cut is not audible.
+ * 3. Transform the head and tail partitions.
+ *
+ * @return False if the thread was asked to exit before finishing.
+ */
+bool FrozenTail::renderGrid()
+{
+    // Own transforms: FFT engines may keep work buffers, so the audio thread's are not shared
+    const juce::dsp::FFT headFFT(orderOf(2 * headPartition));
+    const juce::dsp::FFT tailFFT(orderOf(2 * tailPartition));
+    std::vector<float> scratch(4 * static_cast<size_t>(tailPartition), 0.0f);
+
+    juce::AudioBuffer<float> ir(numInputs * numOutputs, maxLength);
+    const int headBins = headPartition + 1;
+    const int tailBins = tailPartition + 1;
+    const int responses = numInputs * numOutputs;
+
+    for (int r = 0; r < grid.roomSizePoints; ++r)
+    {
+        for (int d = 0; d < grid.dampeningPoints; ++d)
+        {
+            const float u = grid.roomSizePoints > 1 ? static_cast<float>(r) / (grid.roomSizePoints - 1) : 0.0f;
+            const float v = grid.dampeningPoints > 1 ? static_cast<float>(d) / (grid.dampeningPoints - 1) : 0.0f;
+            const float roomSize = grid.minRoomSize + u * (grid.maxRoomSize - grid.minRoomSize);
+            const float dampening = grid.minDampening * std::pow(grid.maxDampening / grid.minDampening, v);
+
+            // Step 1: render
+            ir.clear();
+            if (juce::Thread::currentThreadShouldExit() || !renderer(roomSize, dampening, ir))
+                return false;
+
+            // Step 2: truncate at -60 dB
+            float peak = 0.0f;
+            for (int ch = 0; ch < responses; ++ch)
+                peak = juce::jmax(peak, ir.getMagnitude(ch, 0, maxLength));
+
+            int length = 1;
+            const float threshold = peak * 1.0e-3f;
+            for (int ch = 0; ch < responses; ++ch)
+            {
+                const float* data = ir.getReadPointer(ch);
+                for (int n = maxLength - 1; n >= length; --n)
+                {
+                    if (std::abs(data[n]) > threshold)
+                    {
+                        length = n + 1;
+                        break;
+                    }
+                }
+            }
+
+            const int fade = juce::jmin(length, headPartition);
+            for (int ch = 0; ch < responses; ++ch)
+            {
+                float* data = ir.getWritePointer(ch);
+                for (int n = 0; n < fade; ++n)
+                    data[length - fade + n] *= 0.5f * (1.0f + std::cos(juce::MathConstants<float>::pi * (n + 1) / fade));
+            }
+
+            // Step 3: partition
+            Point& point = points[static_cast<size_t>(r) * grid.dampeningPoints + d];
+            point.headParts = juce::jmin(tailPartition / headPartition, (length + headPartition - 1) / headPartition);
+            point.tailParts = juce::jmax(0, (length - tailPartition + tailPartition - 1) / tailPartition);
+
+            point.headRe.assign(static_cast<size_t>(point.headParts) * responses * headBins, 0.0f);
+            point.headIm.assign(point.headRe.size(), 0.0f);
+            point.tailRe.assign(static_cast<size_t>(point.tailParts) * responses * tailBins, 0.0f);
+            point.tailIm.assign(point.tailRe.size(), 0.0f);
+
+            for (int ch = 0; ch < responses; ++ch)
+            {
+                const float* data = ir.getReadPointer(ch);
+
+                for (int p = 0; p < point.headParts; ++p)
+                {
+                    const int start = p * headPartition;
+                    const size_t offset = (static_cast<size_t>(p) * responses + ch) * headBins;
+                    forward(headFFT, headPartition, data + start, juce::jmin(headPartition, length - start),
+                        scratch.data(), point.headRe.data() + offset, point.headIm.data() + offset);
+                }
+
+                for (int q = 0; q < point.tailParts; ++q)
+                {
+                    const int start = (q + 1) * tailPartition;
+                    const size_t offset = (static_cast<size_t>(q) * responses + ch) * tailBins;
+                    forward(tailFFT, tailPartition, data + start, juce::jmin(tailPartition, length - start),
+                        scratch.data(), point.tailRe.data() + offset, point.tailIm.data() + offset);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Locks the four spectra vectors of every point.
+ *
+ * A refused lock (low RLIMIT_MEMLOCK) only leaves the rest unpinned.
+ */
+void FrozenTail::lockPoints()
+{
+    auto lock = [this](void* data, size_t bytes) { gridLock.add(data, bytes); };
+
+    for (auto& point : points)
+    {
+        EngineMemory::visit(lock, point.headRe);
+        EngineMemory::visit(lock, point.headIm);
+        EngineMemory::visit(lock, point.tailRe);
+        EngineMemory::visit(lock, point.tailIm);
+    }
+}
+
+/**
+ * @brief Zero-pads count samples to 2 * size points and keeps bins 0..size.
+ */
+void FrozenTail::forward(const juce::dsp::FFT& fft, int size, const float* time, int count,
+    float* scratch, float* re, float* im)
+{
+    std::fill(scratch, scratch + 4 * size, 0.0f);
+    std::copy(time, time + count, scratch);
+    fft.performRealOnlyForwardTransform(scratch, true);
+
+    for (int k = 0; k <= size; ++k)
+    {
+        re[k] = scratch[2 * k];
+        im[k] = scratch[2 * k + 1];
+    }
+}
+
+/**
+ * @brief Rebuilds the conjugate-symmetric spectrum and transforms it back.
+ */
+void FrozenTail::inverse(const juce::dsp::FFT& fft, int size, const float* re, const float* im, float* scratch)
+{
+    const int points = 2 * size;
+    for (int k = 0; k <= size; ++k)
+    {
+        scratch[2 * k] = re[k];
+        scratch[2 * k + 1] = im[k];
+    }
+    for (int k = size + 1; k < points; ++k)
+    {
+        scratch[2 * k] = re[points - k];
+        scratch[2 * k + 1] = -im[points - k];
+    }
+
+    fft.performRealOnlyInverseTransform(scratch);
+}
+
+/**
+ * @brief Locates the parameters on the grid and keeps the points with non-zero weight.
+ *
+ * Room size is interpolated linearly and dampening logarithmically, matching
+ * the grid spacing; values outside the grid are clamped to its edge.
+ *
+ * @return Number of active points (1, 2 or 4).
+ */
+int FrozenTail::findWeights(float roomSize, float dampening)
+{
+    auto locate = [](float position, int count, int& index, float& fraction)
+    {
+        position = juce::jlimit(0.0f, static_cast<float>(count - 1), position);
+        index = juce::jmin(static_cast<int>(position), juce::jmax(0, count - 2));
+        fraction = count > 1 ? position - static_cast<float>(index) : 0.0f;
+    };
+
+    int r = 0, d = 0;
+    float fr = 0.0f, fd = 0.0f;
+    const float roomRange = grid.maxRoomSize - grid.minRoomSize;
+    const float dampRange = std::log(grid.maxDampening / grid.minDampening);
+
+    locate(roomRange > 0.0f ? (roomSize - grid.minRoomSize) / roomRange * (grid.roomSizePoints - 1) : 0.0f,
+        grid.roomSizePoints, r, fr);
+    locate(dampRange > 0.0f ? std::log(juce::jmax(dampening, 1.0f) / grid.minDampening) / dampRange * (grid.dampeningPoints - 1) : 0.0f,
+        grid.dampeningPoints, d, fd);
+
+    numWeights = 0;
+    auto add = [this](int rr, int dd, float gain)
+    {
+        if (gain > 0.0f)
+            weights[numWeights++] = { &points[static_cast<size_t>(rr) * grid.dampeningPoints + dd], gain };
+    };
+
+    add(r, d, (1.0f - fr) * (1.0f - fd));
+    if (fr > 0.0f)
+        add(r + 1, d, fr * (1.0f - fd));
+    if (fd > 0.0f)
+        add(r, d + 1, (1.0f - fr) * fd);
+    if (fr > 0.0f && fd > 0.0f)
+        add(r + 1, d + 1, fr * fd);
+
+    return numWeights;
+}
+
+/**
+ * @brief Weighted complex multiply-accumulate over the active grid points.
+ *
+ * Partition p is multiplied with the input spectrum (p - firstPart) slots
+ * older than newest. Points with fewer partitions simply stop early.
+ */
+void FrozenTail::accumulate(const Stage& stage, bool head, int firstPart, int lastPart, int newest,
+    float* re, float* im)
+{
+    const int bins = stage.bins;
+
+    for (int w = 0; w < numWeights; ++w)
+    {
+        const Point& point = *weights[w].point;
+        const float gain = weights[w].gain;
+        const int end = juce::jmin(lastPart, head ? point.headParts : point.tailParts);
+        const float* pointRe = head ? point.headRe.data() : point.tailRe.data();
+        const float* pointIm = head ? point.headIm.data() : point.tailIm.data();
+
+        for (int p = firstPart; p < end; ++p)
+        {
+            int slot = (newest - (p - firstPart)) % stage.ring;
+            if (slot < 0)
+                slot += stage.ring;
+
+            for (int i = 0; i < numInputs; ++i)
+            {
+                const size_t x = (static_cast<size_t>(i) * stage.ring + slot) * bins;
+                const float* xRe = stage.inputRe.data() + x;
+                const float* xIm = stage.inputIm.data() + x;
+
+                for (int o = 0; o < numOutputs; ++o)
+                {
+                    const size_t h = ((static_cast<size_t>(p) * numInputs + i) * numOutputs + o) * bins;
+                    const float* hRe = pointRe + h;
+                    const float* hIm = pointIm + h;
+                    float* accRe = re + static_cast<size_t>(o) * bins;
+                    float* accIm = im + static_cast<size_t>(o) * bins;
+
+                    for (int k = 0; k < bins; ++k)
+                    {
+                        accRe[k] += gain * (xRe[k] * hRe[k] - xIm[k] * hIm[k]);
+                        accIm[k] += gain * (xRe[k] * hIm[k] + xIm[k] * hRe[k]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rebuilds the convolution state from the recorded input spectra.
+ *
+ * Called once, on the first call after the grid is ready: the stages have
+ * only been storing input spectra, so the overlaps (and the tail's output
+ * for the current block) are computed as if they had been convolving all
+ * along, with the current weights.
+ */
+void FrozenTail::prime()
+{
+    const size_t headBins = static_cast<size_t>(numOutputs) * head.bins;
+    const size_t tailBins = static_cast<size_t>(numOutputs) * tail.bins;
+    const int headParts = tailPartition / headPartition;
+
+    // Head: overlap of the previous block, and older partitions of the current one
+    std::fill(head.accRe.begin(), head.accRe.begin() + headBins, 0.0f);
+    std::fill(head.accIm.begin(), head.accIm.begin() + headBins, 0.0f);
+    accumulate(head, true, 0, headParts, head.segment - 1, head.accRe.data(), head.accIm.data());
+    for (int o = 0; o < numOutputs; ++o)
+    {
+        inverse(*head.fft, head.size, head.accRe.data() + o * head.bins, head.accIm.data() + o * head.bins, fftData.data());
+        std::copy(fftData.begin() + head.size, fftData.begin() + 2 * head.size, head.overlap.begin() + o * head.size);
+    }
+
+    std::fill(head.pastRe.begin(), head.pastRe.end(), 0.0f);
+    std::fill(head.pastIm.begin(), head.pastIm.end(), 0.0f);
+    accumulate(head, true, 1, headParts, head.segment - 1, head.pastRe.data(), head.pastIm.data());
+
+    // Tail: the current block's output is the first half of the last block's
+    // result plus the second half of the one before
+    for (int age = 2; age >= 1; --age)
+    {
+        std::fill(tail.accRe.begin(), tail.accRe.begin() + tailBins, 0.0f);
+        std::fill(tail.accIm.begin(), tail.accIm.begin() + tailBins, 0.0f);
+        accumulate(tail, false, 0, tail.ring, tail.segment - age, tail.accRe.data(), tail.accIm.data());
+
+        for (int o = 0; o < numOutputs; ++o)
+        {
+            inverse(*tail.fft, tail.size, tail.accRe.data() + o * tail.bins, tail.accIm.data() + o * tail.bins, fftData.data());
+            float* output = tail.output.data() + o * tail.size;
+            float* overlap = tail.overlap.data() + o * tail.size;
+
+            if (age == 1)
+                for (int n = 0; n < tail.size; ++n)
+                    output[n] = fftData[n] + overlap[n];
+            std::copy(fftData.begin() + tail.size, fftData.begin() + 2 * tail.size, overlap);
+        }
+    }
+
+    primed = true;
+}
+
+/**
+ * @brief Moves a stage to the next ring slot.
+ */
+void FrozenTail::advance(Stage& stage)
+{
+    stage.segment = (stage.segment + 1) % stage.ring;
+    stage.position = 0;
+}
+
+/**
+ * @brief Convolves one block with the interpolated grid responses.
+ *
+ * The block is cut at head block boundaries (tail boundaries coincide,
+ * as tailPartition is a multiple of headPartition). Per piece:
+ * 1. Integrate the input (the responses include the excitation's 1 - z^-2)
+ *    and append it to both stages' current blocks.
+ * 2. Head: at a block start, accumulate partitions 1.. from the older
+ *    blocks; every piece transforms the partial block, adds partition 0 and
+ *    transforms back. Output = result + previous block's overlap.
+ * 3. Tail: add the precomputed output of the current block.
+ * 4. When the head block completes, keep the second half as its overlap.
+ *    When the tail block completes, convolve it with all tail partitions
+ *    to produce the next block's output and overlap.
+ *
+ * While the grid is rendering only the input spectra of completed blocks
+ * are stored.
+ */
+bool FrozenTail::process(const float* in0, const float* in1, float* out0, float* out1,
+    int numSamples, float roomSize, float dampening)
+{
+    const bool running = isReady();
+    if (running)
+    {
+        findWeights(roomSize, dampening);
+        if (!primed)
+            prime();
+    }
+
+    const float* inputs[numInputs] = { in0, in1 };
+    float* outputs[numOutputs] = { out0, out1 };
+    const size_t headBins = static_cast<size_t>(numOutputs) * head.bins;
+    const size_t tailBins = static_cast<size_t>(numOutputs) * tail.bins;
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - done, head.size - head.position);
+        const bool headStart = head.position == 0;
+
+        // Step 1: undo the 1 - z^-2 of the rendered excitation, y[n] = x[n] + r y[n - 2],
+        // and append to both stages
+        for (int i = 0; i < numInputs; ++i)
+        {
+            float* headBlock = head.block.data() + i * head.size + head.position;
+            for (int n = 0; n < count; ++n)
+            {
+                headBlock[n] = inputs[i][done + n] + leak * history[i][1];
+                history[i][1] = history[i][0];
+                history[i][0] = headBlock[n];
+            }
+            std::copy(headBlock, headBlock + count, tail.block.begin() + i * tail.size + tail.position);
+        }
+
+        const bool headComplete = head.position + count == head.size;
+        const bool tailComplete = tail.position + count == tail.size;
+
+        if (running)
+        {
+            // Step 2: head
+            if (headStart)
+            {
+                std::fill(head.pastRe.begin(), head.pastRe.end(), 0.0f);
+                std::fill(head.pastIm.begin(), head.pastIm.end(), 0.0f);
+                accumulate(head, true, 1, tailPartition / headPartition, head.segment - 1, head.pastRe.data(), head.pastIm.data());
+            }
+
+            for (int i = 0; i < numInputs; ++i)
+            {
+                const size_t slot = (static_cast<size_t>(i) * head.ring + head.segment) * head.bins;
+                forward(*head.fft, head.size, head.block.data() + i * head.size, head.position + count,
+                    fftData.data(), head.inputRe.data() + slot, head.inputIm.data() + slot);
+            }
+
+            std::copy(head.pastRe.begin(), head.pastRe.begin() + headBins, head.accRe.begin());
+            std::copy(head.pastIm.begin(), head.pastIm.begin() + headBins, head.accIm.begin());
+            accumulate(head, true, 0, 1, head.segment, head.accRe.data(), head.accIm.data());
+
+            for (int o = 0; o < numOutputs; ++o)
+            {
+                inverse(*head.fft, head.size, head.accRe.data() + o * head.bins, head.accIm.data() + o * head.bins, fftData.data());
+
+                // Step 3: add the tail's precomputed output
+                const float* overlap = head.overlap.data() + o * head.size + head.position;
+                const float* late = tail.output.data() + o * tail.size + tail.position;
+                const float* result = fftData.data() + head.position;
+                float* out = outputs[o] + done;
+                for (int n = 0; n < count; ++n)
+                    out[n] = result[n] + overlap[n] + late[n];
+
+                // Step 4: head overlap for the next block
+                if (headComplete)
+                    std::copy(fftData.begin() + head.size, fftData.begin() + 2 * head.size, head.overlap.begin() + o * head.size);
+            }
+        }
+        else if (headComplete)
+        {
+            for (int i = 0; i < numInputs; ++i)
+            {
+                const size_t slot = (static_cast<size_t>(i) * head.ring + head.segment) * head.bins;
+                forward(*head.fft, head.size, head.block.data() + i * head.size, head.size,
+                    fftData.data(), head.inputRe.data() + slot, head.inputIm.data() + slot);
+            }
+        }
+
+        if (tailComplete)
+        {
+            for (int i = 0; i < numInputs; ++i)
+            {
+                const size_t slot = (static_cast<size_t>(i) * tail.ring + tail.segment) * tail.bins;
+                forward(*tail.fft, tail.size, tail.block.data() + i * tail.size, tail.size,
+                    fftData.data(), tail.inputRe.data() + slot, tail.inputIm.data() + slot);
+            }
+
+            // Step 4: tail output and overlap for the next block
+            if (running)
+            {
+                std::fill(tail.accRe.begin(), tail.accRe.begin() + tailBins, 0.0f);
+                std::fill(tail.accIm.begin(), tail.accIm.begin() + tailBins, 0.0f);
+                accumulate(tail, false, 0, tail.ring, tail.segment, tail.accRe.data(), tail.accIm.data());
+
+                for (int o = 0; o < numOutputs; ++o)
+                {
+                    inverse(*tail.fft, tail.size, tail.accRe.data() + o * tail.bins, tail.accIm.data() + o * tail.bins, fftData.data());
+                    float* output = tail.output.data() + o * tail.size;
+                    float* overlap = tail.overlap.data() + o * tail.size;
+                    for (int n = 0; n < tail.size; ++n)
+                        output[n] = fftData[n] + overlap[n];
+                    std::copy(fftData.begin() + tail.size, fftData.begin() + 2 * tail.size, overlap);
+                }
+            }
+        }
+
+        head.position += count;
+        tail.position += count;
+        if (headComplete)
+            advance(head);
+        if (tailComplete)
+            advance(tail);
+
+        done += count;
+    }
+
+    return running;
+}
+
+/**
+ * @brief Zeroes both stages and the input integrator.
+ *
+ * Silent history convolves to silence, so a primed tail stays primed.
+ */
+void FrozenTail::reset()
+{
+    for (Stage* stage : { &head, &tail })
+    {
+        for (auto* data : { &stage->block, &stage->inputRe, &stage->inputIm, &stage->accRe, &stage->accIm,
+                 &stage->pastRe, &stage->pastIm, &stage->overlap, &stage->output })
+            std::fill(data->begin(), data->end(), 0.0f);
+
+        stage->segment = 0;
+        stage->position = 0;
+    }
+
+    for (auto& lane : history)
+        lane[0] = lane[1] = 0.0f;
+}
+
+/**
+ * @brief Reports both stages and the transform scratch.
+ */
+void FrozenTail::visitMemory(const EngineMemory::Visitor& visit)
+{
+    for (Stage* stage : { &head, &tail })
+    {
+        EngineMemory::visit(visit, stage->block);
+        EngineMemory::visit(visit, stage->inputRe);
+        EngineMemory::visit(visit, stage->inputIm);
+        EngineMemory::visit(visit, stage->accRe);
+        EngineMemory::visit(visit, stage->accIm);
+        EngineMemory::visit(visit, stage->pastRe);
+        EngineMemory::visit(visit, stage->pastIm);
+        EngineMemory::visit(visit, stage->overlap);
+        EngineMemory::visit(visit, stage->output);
+    }
+    EngineMemory::visit(visit, fftData);
+}
+
+/**
+ * @brief Reports both stages' input blocks, spectra rings, pending output and
+ *        positions, and the input integrators.
+ *
+ * The accumulators and fftData are scratch, and the restoring engine renders
+ * the same grid from the same seed.
+ */
+void FrozenTail::visitState(const EngineState::Visitor& visit)
+{
+    for (Stage* stage : { &head, &tail })
+    {
+        EngineState::visit(visit, stage->block);
+        EngineState::visit(visit, stage->inputRe);
+        EngineState::visit(visit, stage->inputIm);
+        EngineState::visit(visit, stage->pastRe);
+        EngineState::visit(visit, stage->pastIm);
+        EngineState::visit(visit, stage->overlap);
+        EngineState::visit(visit, stage->output);
+        EngineState::visit(visit, stage->segment);
+        EngineState::visit(visit, stage->position);
+    }
+
+    EngineState::visit(visit, history);
+    EngineState::visit(visit, primed);
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+// Standard library
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "EngineMemory.h"
+#include "EngineState.h"
+
+/**
+ * @class FrozenTail
+ * @brief Replaces the diffuser/FDN chain by convolution with pre-rendered impulse responses.
+ *
+ * A background thread renders the chain's impulse responses on a grid of
+ * roomSize x dampening values (linear in room size, logarithmic in
+ * dampening). At runtime the grid points around the current parameters are
+ * blended bilinearly in the frequency domain: one point on a grid node, two
+ * on a grid line, four in between. Automated parameters therefore cost a
+ * few convolutions instead of the live engine. Blending neighbouring rooms
+ * crossfades their responses rather than morphing the delays, so a denser
+ * grid follows the live engine more closely.
+ *
+ * The chain input only has two distinct signals: the upmix feeds wet lane 0
+ * from the first input channel and lanes 1-7 from the last one, and sends
+ * use the same layout. Each grid point therefore holds four responses (lane
+ * 0 and lanes 1-7, each into wet channels 0 and 1), which is all that the
+ * output stage reads.
+ *
+ * The diffusers' RRS filters have near-marginal poles at DC and Nyquist,
+ * which the input stage's filters cancel with exact zeros; a bare impulse
+ * would excite them and leave responses far too loud to truncate or
+ * convolve accurately. The responses are therefore rendered for the
+ * excitation 1 - z^-2 (zeros at DC and Nyquist), and process() runs its
+ * input through the matching leaky integrator 1 / (1 - r z^-2).
+ *
+ * Convolution is zero-latency and non-uniformly partitioned:
+ * - head: IR samples [0, tailPartition) in headPartition blocks, output
+ *   computed on every call from the partially filled input block;
+ * - tail: the rest of the IR in tailPartition blocks, computed once per
+ *   tailPartition input samples, when a block completes (the tail starts one
+ *   block late, so its output is known a block ahead).
+ *
+ * Until the grid is rendered, process() only records input history and
+ * reports false, so the caller keeps running the live chain.
+ */
+class FrozenTail
+{
+public:
+    static constexpr int headPartition = 256;  ///< Head partition and block size (samples)
+    static constexpr int tailPartition = 4096; ///< Tail partition and block size (samples)
+    static constexpr float leak = 1.0f - 1.0f / 65536.0f; ///< Input integrator pole radius squared
+
+    /**
+     * @struct Grid
+     * @brief Parameter grid the responses are rendered on.
+     */
+    struct Grid
+    {
+        int roomSizePoints = 3;        ///< Grid points along roomSize (linear spacing)
+        float minRoomSize = 0.1f;      ///< First roomSize point
+        float maxRoomSize = 2.0f;      ///< Last roomSize point
+        int dampeningPoints = 3;       ///< Grid points along dampening (logarithmic spacing)
+        float minDampening = 500.0f;   ///< First dampening point (Hz)
+        float maxDampening = 20000.0f; ///< Last dampening point (Hz)
+        float maxSeconds = 4.0f;       ///< Longest rendered response (truncated at -60 dB)
+    };
+
+    /**
+     * @brief Renders the chain responses for one grid point.
+     *
+     * Arguments: roomSize, dampening, and a 4-channel buffer whose length is
+     * the requested response length. Channel 2 * i + o receives the response
+     * of wet channel o to the excitation x[0] = 1, x[2] = -1 on input i
+     * (0 = lane 0, 1 = lanes 1-7). Returns false if the render was cancelled.
+     */
+    using ResponseRenderer = std::function<bool(float, float, juce::AudioBuffer<float>&)>;
+
+    /**
+     * @brief Allocates the convolution state and starts rendering the grid.
+     * @param fs Sample rate in Hz.
+     * @param grid Grid layout and response length.
+     * @param renderer Chain renderer, called on the background thread.
+     * @param lockGrid Pin the rendered spectra in memory once the grid is complete.
+     * @throws std::invalid_argument if the grid has fewer than one point per
+     *         axis, non-positive or reversed ranges, or a non-positive length.
+     */
+    FrozenTail(double fs, const Grid& grid, ResponseRenderer renderer, bool lockGrid = false);
+
+    /** @brief Stops the render thread (cancelling a render in progress). */
+    ~FrozenTail();
+
+    // Copy and move operations are deleted: the render thread refers to this object
+    FrozenTail(const FrozenTail&) = delete;
+    FrozenTail& operator=(const FrozenTail&) = delete;
+    FrozenTail(FrozenTail&&) = delete;
+    FrozenTail& operator=(FrozenTail&&) = delete;
+
+    /** @brief True once every grid point has been rendered. */
+    bool isReady() const { return ready.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Blocks until the grid is rendered.
+     * @param timeoutMs Maximum wait in milliseconds (-1 = no limit).
+     * @return True if the grid is ready.
+     */
+    bool waitUntilReady(int timeoutMs = -1);
+
+    /**
+     * @brief Convolves one block of chain input with the interpolated responses.
+     * @param in0 Wet lane 0 (chain input).
+     * @param in1 Wet lane 1 (chain input, equal to lanes 2-7).
+     * @param out0 Receives wet channel 0 (may not alias the inputs).
+     * @param out1 Receives wet channel 1 (may not alias the inputs).
+     * @param numSamples Number of samples (any length).
+     * @param roomSize Current room size.
+     * @param dampening Current dampening cutoff (Hz).
+     * @return True if the outputs were written; false while the grid is
+     *         still rendering (the input is recorded either way).
+     */
+    bool process(const float* in0, const float* in1, float* out0, float* out1,
+        int numSamples, float roomSize, float dampening);
+
+    /**
+     * @brief Clears the convolution state as if the input had been silent (no allocation).
+     *
+     * The grid is kept. Audio thread only, like process().
+     */
+    void reset();
+
+    /**
+     * @brief Reports the convolution state used by process().
+     * @param visit Receives each region (see EngineMemory).
+     *
+     * The grid spectra are not included: the render thread writes them (so
+     * they are resident once ready) and pins them itself if lockGrid was set.
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the convolution history (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+private:
+    /**
+     * @struct Point
+     * @brief Partitioned spectra of one grid point, split into real and imaginary parts.
+     *
+     * Layout: [partition][input][output][bin].
+     */
+    struct Point
+    {
+        int headParts = 0;         ///< Head partitions in use (<= tailPartition / headPartition)
+        int tailParts = 0;         ///< Tail partitions in use
+        std::vector<float> headRe; ///< Head spectra, real parts
+        std::vector<float> headIm; ///< Head spectra, imaginary parts
+        std::vector<float> tailRe; ///< Tail spectra, real parts
+        std::vector<float> tailIm; ///< Tail spectra, imaginary parts
+    };
+
+    /**
+     * @struct Weight
+     * @brief One grid point taking part in the bilinear blend.
+     */
+    struct Weight
+    {
+        const Point* point = nullptr; ///< Grid point
+        float gain = 0.0f;            ///< Bilinear weight
+    };
+
+    /**
+     * @struct Stage
+     * @brief One uniformly partitioned overlap-add convolver for both inputs.
+     */
+    struct Stage
+    {
+        int size = 0;     ///< Partition and block size
+        int bins = 0;     ///< size + 1 spectrum bins
+        int ring = 0;     ///< Input spectra kept per input
+        int segment = 0;  ///< Ring slot of the current block
+        int position = 0; ///< Samples of the current block received
+        std::unique_ptr<juce::dsp::FFT> fft; ///< Transform of 2 * size points
+
+        std::vector<float> block;    ///< Current input block per input ([input][sample])
+        std::vector<float> inputRe;  ///< Input spectra ([input][slot][bin])
+        std::vector<float> inputIm;  ///< Input spectra ([input][slot][bin])
+        std::vector<float> accRe;    ///< Spectrum accumulators ([output][bin])
+        std::vector<float> accIm;    ///< Spectrum accumulators ([output][bin])
+        std::vector<float> pastRe;   ///< Head: older partitions of the current block ([output][bin])
+        std::vector<float> pastIm;   ///< Head: older partitions of the current block ([output][bin])
+        std::vector<float> overlap;  ///< Second half of the previous block's output ([output][sample])
+        std::vector<float> output;   ///< Tail: output of the current block ([output][sample])
+    };
+
+    class RenderThread;
+
+    /** @brief Allocates a stage with size-sample partitions and ring input slots. */
+    static void prepareStage(Stage& stage, int size, int ring);
+
+    /** @brief Renders and partitions every grid point (render thread). */
+    bool renderGrid();
+
+    /** @brief Pins the rendered spectra (render thread, before ready is set). */
+    void lockPoints();
+
+    /** @brief Transforms count samples, zero-padded to 2 * size, into split spectra. */
+    static void forward(const juce::dsp::FFT& fft, int size, const float* time, int count,
+        float* scratch, float* re, float* im);
+
+    /** @brief Inverse transform of split spectra into the first 2 * size samples of scratch. */
+    static void inverse(const juce::dsp::FFT& fft, int size, const float* re, const float* im, float* scratch);
+
+    /** @brief Finds the grid points and bilinear weights for the parameters. */
+    int findWeights(float roomSize, float dampening);
+
+    /**
+     * @brief Accumulates input spectra times partition spectra of the active points.
+     * @param stage Stage to read from.
+     * @param head True for the head stage spectra.
+     * @param firstPart First partition.
+     * @param lastPart One past the last partition.
+     * @param newest Ring slot multiplied with partition firstPart.
+     * @param re Output accumulators ([output][bin]), added to.
+     * @param im Output accumulators ([output][bin]), added to.
+     */
+    void accumulate(const Stage& stage, bool head, int firstPart, int lastPart, int newest, float* re, float* im);
+
+    /** @brief Computes the overlap and pending output the stages would hold had they been running. */
+    void prime();
+
+    /** @brief Starts the next block in the ring. */
+    static void advance(Stage& stage);
+
+    double fs = 0.0;  ///< Sample rate in Hz
+    Grid grid;        ///< Grid layout
+    ResponseRenderer renderer; ///< Chain renderer (render thread only)
+    int maxLength = 0; ///< Response length rendered per point (samples)
+
+    std::vector<Point> points; ///< [roomSize index][dampening index]; written before ready is set
+    bool lockGrid = false;     ///< Pin the spectra once rendered
+    EngineMemory::Lock gridLock; ///< Pinned spectra (declared after points, released first)
+    std::atomic<bool> ready { false }; ///< Set once points is complete
+    juce::WaitableEvent finished;      ///< Signalled when the render thread ends
+    bool primed = false;               ///< True once the stages hold convolved history
+
+    Stage head;                  ///< Early part of the responses
+    Stage tail;                  ///< Late part of the responses
+    std::vector<float> fftData;  ///< Transform scratch (audio thread)
+    float history[2][2] = {};    ///< Input integrator state per input (y[n - 1], y[n - 2])
+    Weight weights[4];           ///< Active grid points of the current call
+    int numWeights = 0;          ///< Entries in use in weights
+
+    std::unique_ptr<RenderThread> thread; ///< Background grid renderer (declared last, stopped first)
+};
@@ -62,19 +62,35 @@ void Hadamard::process(juce::AudioBuffer<float>& buffer)
  * The vector size must be a power of 2. Transformation uses only
  * additions and subtractions and is normalized by 1/sqrt(N).
  *
- * @param frame The float vector to transform in-place.
+ * @param frame The float vector to transform in-place; left unchanged if
+ *        its size is not a power of 2.
  */
 void Hadamard::process(std::vector<float>& frame)
 {
-    size_t N = frame.size();
-    if ((N & (N - 1)) != 0) return; // Must be power of 2
+    const size_t N = frame.size();
+    if (N == 0 || (N & (N - 1)) != 0) return; // Must be power of 2
+
+    process(frame.data(), static_cast<int>(N));
+}
+
+/**
+ * @brief Performs an in-place Hadamard transform on a raw float frame.
+ *
+ * @param frame Pointer to N floats, transformed in-place.
+ * @param N Frame length (power of 2).
+ * @throws std::invalid_argument if N is not a power of 2.
+ */
+void Hadamard::process(float* frame, int N)
+{
+    if (N < 1 || (N & (N - 1)) != 0)
+        throw std::invalid_argument("Frame size must be a power of 2.");
 
     // Fast Hadamard transform (in-place)
-    for (size_t len = 1; len < N; len <<= 1)
+    for (int len = 1; len < N; len <<= 1)
     {
-        for (size_t i = 0; i < N; i += (len << 1))
+        for (int i = 0; i < N; i += (len << 1))
         {
-            for (size_t j = 0; j < len; ++j)
+            for (int j = 0; j < len; ++j)
             {
                 float a = frame[i + j];
                 float b = frame[i + j + len];
@@ -86,6 +102,6 @@ void Hadamard::process(std::vector<float>& frame)
 
     // Normalize
     float scale = 1.0f / std::sqrt(static_cast<float>(N));
-    for (auto& val : frame)
-        val *= scale;
+    for (int i = 0; i < N; ++i)
+        frame[i] *= scale;
 }
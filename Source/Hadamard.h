@@ -37,7 +37,15 @@ public:
      * @brief Performs a Hadamard transform on a standard float vector.
      * @param frame The vector to transform. Transformation is applied in-place.
      *
-     * Vector size must be a power of two.
+     * Vector size must be a power of two; other sizes leave the vector unchanged.
      */
     static void process(std::vector<float>& frame);
+
+    /**
+     * @brief Performs a Hadamard transform on a raw frame of N floats.
+     * @param frame Pointer to the frame. Transformation is applied in-place.
+     * @param N Frame length, must be a power of two.
+     * @throws std::invalid_argument if N is not a power of two.
+     */
+    static void process(float* frame, int N);
 };
@@ -0,0 +1,187 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <cstring>
+
+// GCC and Clang define __F16C__ (-mf16c, implied by -march=haswell and
+// later, but not by -mavx2); MSVC has no F16C macro, and its /arch:AVX2
+// targets imply F16C
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+ #include <immintrin.h>
+ #define UMBRA_HAS_F16C 1
+#else
+ #define UMBRA_HAS_F16C 0
+#endif
+
+/**
+ * @class HalfFloat
+ * @brief Conversions between float and 16-bit storage formats.
+ *
+ * Supports IEEE 754 binary16 (FP16) and bfloat16 (BF16). Both round to
+ * nearest-even. FP16 uses the F16C instructions when the build targets them
+ * and an exact software fallback otherwise; both paths produce identical bits.
+ * BF16 is a truncated float, so its conversion is a handful of integer ops.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class HalfFloat
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    HalfFloat() = delete;
+
+    /**
+     * @brief Converts a float to FP16 (round to nearest-even).
+     * @param value Float value.
+     * @return FP16 bit pattern.
+     */
+    static inline uint16_t floatToHalf(float value)
+    {
+#if UMBRA_HAS_F16C
+        return static_cast<uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+        return floatToHalfSoftware(value);
+#endif
+    }
+
+    /**
+     * @brief Converts FP16 to float (exact).
+     * @param bits FP16 bit pattern.
+     * @return Float value.
+     */
+    static inline float halfToFloat(uint16_t bits)
+    {
+#if UMBRA_HAS_F16C
+        return _cvtsh_ss(bits);
+#else
+        return halfToFloatSoftware(bits);
+#endif
+    }
+
+    /**
+     * @brief Converts a float to BF16 (round to nearest-even, NaN preserved).
+     * @param value Float value.
+     * @return BF16 bit pattern.
+     */
+    static inline uint16_t floatToBFloat(float value)
+    {
+        uint32_t x;
+        std::memcpy(&x, &value, sizeof(x));
+
+        if ((x & 0x7FFFFFFFu) > 0x7F800000u)
+            return static_cast<uint16_t>((x >> 16) | 0x40u); // quiet NaN
+
+        return static_cast<uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+    }
+
+    /**
+     * @brief Converts BF16 to float (exact).
+     * @param bits BF16 bit pattern.
+     * @return Float value.
+     */
+    static inline float bfloatToFloat(uint16_t bits)
+    {
+        const uint32_t x = static_cast<uint32_t>(bits) << 16;
+        float value;
+        std::memcpy(&value, &x, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Portable float -> FP16 conversion, bit-identical to F16C.
+     * @param value Float value.
+     * @return FP16 bit pattern.
+     */
+    static inline uint16_t floatToHalfSoftware(float value)
+    {
+        uint32_t x;
+        std::memcpy(&x, &value, sizeof(x));
+
+        const uint32_t sign = (x >> 16) & 0x8000u;
+        x &= 0x7FFFFFFFu;
+
+        // Inf / NaN (NaN is quieted, top payload bits kept)
+        if (x >= 0x7F800000u)
+            return static_cast<uint16_t>(sign | 0x7C00u
+                | (x > 0x7F800000u ? 0x200u | ((x >> 13) & 0x3FFu) : 0u));
+
+        // Rounds to infinity (>= 65520)
+        if (x >= 0x477FF000u)
+            return static_cast<uint16_t>(sign | 0x7C00u);
+
+        // Subnormal half (< 2^-14) or zero
+        if (x < 0x38800000u)
+        {
+            if (x < 0x33000000u)
+                return static_cast<uint16_t>(sign);
+
+            const uint32_t exponent = x >> 23;
+            const uint32_t mantissa = (x & 0x7FFFFFu) | 0x800000u;
+            const uint32_t shift = 126u - exponent;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const uint32_t halfway = 1u << (shift - 1u);
+
+            uint32_t h = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (h & 1u)))
+                ++h;
+
+            return static_cast<uint16_t>(sign | h);
+        }
+
+        // Normal: rebias exponent, round mantissa to 10 bits
+        uint32_t h = (x - 0x38000000u) >> 13;
+        const uint32_t remainder = x & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (h & 1u)))
+            ++h;
+
+        return static_cast<uint16_t>(sign | h);
+    }
+
+    /**
+     * @brief Portable FP16 -> float conversion.
+     * @param bits FP16 bit pattern.
+     * @return Float value.
+     */
+    static inline float halfToFloatSoftware(uint16_t bits)
+    {
+        const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+        uint32_t exponent = (bits >> 10) & 0x1Fu;
+        uint32_t mantissa = bits & 0x3FFu;
+        uint32_t x;
+
+        if (exponent == 0)
+        {
+            if (mantissa == 0)
+            {
+                x = sign;
+            }
+            else
+            {
+                // Normalize subnormal
+                exponent = 113;
+                while ((mantissa & 0x400u) == 0)
+                {
+                    mantissa <<= 1;
+                    --exponent;
+                }
+                x = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+            }
+        }
+        else if (exponent == 31)
+        {
+            // Inf, or NaN quieted the same way as the hardware conversion
+            x = sign | 0x7F800000u | (mantissa << 13) | (mantissa != 0 ? 0x400000u : 0u);
+        }
+        else
+        {
+            x = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+        }
+
+        float value;
+        std::memcpy(&value, &x, sizeof(value));
+        return value;
+    }
+};
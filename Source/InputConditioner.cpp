@@ -0,0 +1,274 @@
+#include "InputConditioner.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+/**
+ * @brief Constructs the fused input stage.
+ *
+ * Allocates one pre-delay ring per lane and the filtered-block scratch.
+ * The filters pass everything until the first setCutoffs() looks up their
+ * coefficients.
+ *
+ * @param fs Sample rate in Hz.
+ * @param blockSize Maximum audio block size.
+ * @param maxPreDelay Maximum pre-delay in seconds.
+ * @param history Extra ring length in seconds beyond the pre-delay.
+ * @throws std::invalid_argument if fs <= 0 or blockSize <= 0.
+ */
+InputConditioner::InputConditioner(double fs, int blockSize, float maxPreDelay, float history)
+    : fs(fs), blockSize(blockSize)
+{
+    if (fs <= 0.0 || blockSize <= 0)
+        throw std::invalid_argument("Sample rate and block size must be positive");
+
+    maxDelay = static_cast<int>(maxPreDelay * fs);
+    const int historySamples = juce::jmax(0, static_cast<int>(history * fs));
+
+    // One extra sample: the block read at tau + 1 matches the former
+    // read-before-write per-sample loop exactly
+    z.reserve(lanes);
+    for (int lane = 0; lane < lanes; ++lane)
+        z.emplace_back(maxDelay + historySamples + 1, 1.0f, blockSize);
+
+    scratch.resize(static_cast<size_t>(lanes) * blockSize, 0.0f);
+}
+
+/**
+ * @brief Copies normalized coefficients (b0, b1, b2, a1, a2) from a table lookup.
+ */
+void InputConditioner::Biquad::setCoefficients(const CoefficientTable::Biquad& c)
+{
+    b0 = c.b0;
+    b1 = c.b1;
+    b2 = c.b2;
+    a1 = c.a1;
+    a2 = c.a2;
+}
+
+/**
+ * @brief Looks up biquad coefficients if a cutoff changed.
+ *
+ * The lookup interpolates precomputed designs, so the cutoffs can move every
+ * sub-block without any transcendental math on the audio thread.
+ *
+ * @param newLowPass Low-pass cutoff (Hz).
+ * @param newHighPass High-pass cutoff (Hz).
+ * @param coefficients Designs for this stage's sample rate.
+ */
+void InputConditioner::setCutoffs(float newLowPass, float newHighPass, const CoefficientTable& coefficients)
+{
+    jassert(coefficients.getSampleRate() == fs);
+
+    if (newLowPass != previousLowPass)
+    {
+        lowPass.setCoefficients(coefficients.lowPass(newLowPass));
+        previousLowPass = newLowPass;
+    }
+    if (newHighPass != previousHighPass)
+    {
+        highPass.setCoefficients(coefficients.highPass(newHighPass));
+        previousHighPass = newHighPass;
+    }
+}
+
+/**
+ * @brief Runs the fused conditioning kernel for one block.
+ *
+ * Steps:
+ * 1. High-pass then low-pass, both lanes per sample, into the scratch block.
+ * 2. Block-write each lane into its pre-delay ring.
+ * 3. Block-read the delayed lane and copy it to its output channels
+ *    (output channel c takes lane min(c, numInputs - 1)).
+ *
+ * A mono input runs the same kernel with both lanes fed from channel 0.
+ *
+ * @param input Input buffer (first two channels are used).
+ * @param output Destination buffer, fully overwritten.
+ * @param preDelay Pre-delay in samples.
+ */
+void InputConditioner::process(const juce::AudioBuffer<float>& input,
+    juce::AudioBuffer<float>& output,
+    int preDelay)
+{
+    const int numInputs = filterBlock(input);
+    if (numInputs > 0)
+        delayAndUpmix(numInputs, input.getNumSamples(), output, preDelay, false, 1.0f);
+}
+
+/**
+ * @brief Same kernel as process(), but adds gain * result into the output.
+ *
+ * @param input Input buffer (first two channels are used).
+ * @param output Destination buffer, accumulated into.
+ * @param preDelay Pre-delay in samples.
+ * @param gain Send level.
+ */
+void InputConditioner::processAdd(const juce::AudioBuffer<float>& input,
+    juce::AudioBuffer<float>& output,
+    int preDelay,
+    float gain)
+{
+    const int numInputs = filterBlock(input);
+    if (numInputs > 0)
+        delayAndUpmix(numInputs, input.getNumSamples(), output, preDelay, true, gain);
+}
+
+/**
+ * @brief Same kernel as processAdd(), with a per-sample gain.
+ *
+ * @param input Input buffer (first two channels are used).
+ * @param output Destination buffer, accumulated into.
+ * @param preDelay Pre-delay in samples.
+ * @param gains Send level per sample.
+ */
+void InputConditioner::processAdd(const juce::AudioBuffer<float>& input,
+    juce::AudioBuffer<float>& output,
+    int preDelay,
+    const float* gains)
+{
+    const int numInputs = filterBlock(input);
+    if (numInputs > 0)
+        delayAndUpmix(numInputs, input.getNumSamples(), output, preDelay, true, 1.0f, gains);
+}
+
+/**
+ * @brief Filters one block and writes every lane into its ring.
+ *
+ * Both lanes are always written (a mono input feeds both), so a reader can
+ * tap either lane regardless of the input layout.
+ *
+ * @param input Input buffer (first two channels are used).
+ */
+void InputConditioner::push(const juce::AudioBuffer<float>& input)
+{
+    if (filterBlock(input) == 0)
+        return;
+
+    for (int lane = 0; lane < lanes; ++lane)
+        z[lane].writeBlock(scratch.data() + static_cast<size_t>(lane) * blockSize, input.getNumSamples());
+}
+
+/**
+ * @brief 2-lane biquad cascade (HP -> LP), transposed direct form II.
+ *
+ * @param input Input buffer.
+ * @return Number of input lanes used.
+ */
+int InputConditioner::filterBlock(const juce::AudioBuffer<float>& input)
+{
+    const int numSamples = input.getNumSamples();
+    const int numInputs = juce::jmin(input.getNumChannels(), lanes);
+    if (numInputs < 1 || numSamples <= 0)
+        return 0;
+
+    const float* in[lanes];
+    float* filtered[lanes];
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        in[lane] = input.getReadPointer(juce::jmin(lane, numInputs - 1));
+        filtered[lane] = scratch.data() + static_cast<size_t>(lane) * blockSize;
+    }
+
+    Biquad& hp = highPass;
+    Biquad& lp = lowPass;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const float x = in[lane][i];
+
+            const float h = hp.b0 * x + hp.s1[lane];
+            hp.s1[lane] = hp.b1 * x - hp.a1 * h + hp.s2[lane];
+            hp.s2[lane] = hp.b2 * x - hp.a2 * h;
+
+            const float y = lp.b0 * h + lp.s1[lane];
+            lp.s1[lane] = lp.b1 * h - lp.a1 * y + lp.s2[lane];
+            lp.s2[lane] = lp.b2 * h - lp.a2 * y;
+
+            filtered[lane][i] = y;
+        }
+    }
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        JUCE_SNAP_TO_ZERO(hp.s1[lane]);
+        JUCE_SNAP_TO_ZERO(hp.s2[lane]);
+        JUCE_SNAP_TO_ZERO(lp.s1[lane]);
+        JUCE_SNAP_TO_ZERO(lp.s2[lane]);
+    }
+
+    return numInputs;
+}
+
+/**
+ * @brief Block pre-delay and upmix into the FDN input channels.
+ *
+ * Output channel c takes lane min(c, numInputs - 1).
+ */
+void InputConditioner::delayAndUpmix(int numInputs, int numSamples, juce::AudioBuffer<float>& output,
+    int preDelay, bool accumulate, float gain, const float* gains)
+{
+    const int tau = juce::jlimit(0, maxDelay, preDelay) + 1;
+    const int numOutputs = output.getNumChannels();
+
+    for (int lane = 0; lane < numInputs; ++lane)
+    {
+        z[lane].writeBlock(scratch.data() + static_cast<size_t>(lane) * blockSize, numSamples);
+        const float* delayed = z[lane].readBlock(tau, numSamples);
+
+        const int lastChannel = lane == numInputs - 1 ? numOutputs : lane + 1;
+        for (int ch = lane; ch < lastChannel; ++ch)
+        {
+            if (accumulate && gains != nullptr)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch), delayed, gains, numSamples);
+            else if (accumulate)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch), delayed, gain, numSamples);
+            else
+                juce::FloatVectorOperations::copy(output.getWritePointer(ch), delayed, numSamples);
+        }
+    }
+}
+
+/**
+ * @brief Zeroes both biquad states and every pre-delay ring.
+ */
+void InputConditioner::reset()
+{
+    for (Biquad* biquad : { &highPass, &lowPass })
+    {
+        std::fill(std::begin(biquad->s1), std::end(biquad->s1), 0.0f);
+        std::fill(std::begin(biquad->s2), std::end(biquad->s2), 0.0f);
+    }
+
+    for (auto& line : z)
+        line.reset();
+}
+
+/**
+ * @brief Reports the pre-delay rings and the filtered scratch block.
+ */
+void InputConditioner::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, z);
+
+    for (auto& line : z)
+        line.visitMemory(visit);
+
+    EngineMemory::visit(visit, scratch);
+}
+
+/**
+ * @brief Reports both biquads' lane states and the rings; coefficients follow the cutoffs.
+ */
+void InputConditioner::visitState(const EngineState::Visitor& visit)
+{
+    for (Biquad* biquad : { &highPass, &lowPass })
+    {
+        EngineState::visit(visit, biquad->s1);
+        EngineState::visit(visit, biquad->s2);
+    }
+
+    for (auto& line : z)
+        line.visitState(visit);
+}
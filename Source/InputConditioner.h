@@ -0,0 +1,186 @@
+#pragma once
+
+// Standard library
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "CoefficientTable.h"
+#include "DelayLine.h"
+
+/**
+ * @class InputConditioner
+ * @brief Fused input stage: high-pass, low-pass, pre-delay and 8-channel upmix.
+ *
+ * Replaces four separate passes over the input (two juce::IIRFilter passes,
+ * a per-sample pre-delay loop and the upmix copies) with one blocked kernel:
+ * 1. Both biquads run for both stereo channels as a 2-lane biquad
+ *    (transposed direct form II, same topology as juce::IIRFilter).
+ * 2. The filtered block is written to the pre-delay ring with one block write.
+ * 3. The delayed block is read contiguously and copied straight into the
+ *    8-channel FDN input buffer (channels beyond the input repeat the last one).
+ *
+ * The rings can keep extra history beyond the maximum pre-delay, so that
+ * EarlyReflections can tap them directly (push() + getLine()).
+ */
+class InputConditioner
+{
+public:
+    static constexpr int lanes = 2; ///< Input channels processed together (stereo)
+
+    /**
+     * @brief Constructs the input stage.
+     * @param fs Sample rate in Hz.
+     * @param blockSize Maximum audio block size.
+     * @param maxPreDelay Maximum pre-delay in seconds.
+     * @param history Extra ring length in seconds beyond the pre-delay (for tapping).
+     * @throws std::invalid_argument if fs <= 0 or blockSize <= 0.
+     */
+    InputConditioner(double fs, int blockSize, float maxPreDelay = 0.1f, float history = 0.0f);
+
+    /** @brief Default constructor (produces an empty, uninitialized stage). */
+    InputConditioner() = default;
+
+    /** @brief Destructor. */
+    ~InputConditioner() = default;
+
+    // Copy operations are deleted to prevent accidental deep copies
+    InputConditioner(const InputConditioner&) = delete;
+    InputConditioner& operator=(const InputConditioner&) = delete;
+
+    // Move operations are defaulted (safe for internal buffers)
+    InputConditioner(InputConditioner&&) noexcept = default;
+    InputConditioner& operator=(InputConditioner&&) noexcept = default;
+
+    /**
+     * @brief Updates the filter cutoffs. Coefficients are only looked up on change.
+     * @param newLowPass Low-pass cutoff (Hz).
+     * @param newHighPass High-pass cutoff (Hz).
+     * @param coefficients Designs for this stage's sample rate.
+     */
+    void setCutoffs(float newLowPass, float newHighPass, const CoefficientTable& coefficients);
+
+    /**
+     * @brief Conditions one block of input into the FDN input buffer.
+     * @param input Input buffer (1 or 2 channels are used).
+     * @param output Destination buffer; all of its channels are overwritten.
+     * @param preDelay Pre-delay in samples (clamped to the maximum).
+     *
+     * Sample counts of input and output must match and not exceed blockSize.
+     */
+    void process(const juce::AudioBuffer<float>& input,
+        juce::AudioBuffer<float>& output,
+        int preDelay);
+
+    /**
+     * @brief Conditions one block of input and adds it to the FDN input buffer.
+     * @param input Input buffer (1 or 2 channels are used).
+     * @param output Destination buffer; gain * conditioned input is added to every channel.
+     * @param preDelay Pre-delay in samples (clamped to the maximum).
+     * @param gain Send level applied while accumulating.
+     *
+     * Used for extra inputs that share one reverb tail.
+     */
+    void processAdd(const juce::AudioBuffer<float>& input,
+        juce::AudioBuffer<float>& output,
+        int preDelay,
+        float gain);
+
+    /**
+     * @brief Same as processAdd(), with one gain per sample.
+     * @param input Input buffer (1 or 2 channels are used).
+     * @param output Destination buffer; gains[i] * conditioned input is added to every channel.
+     * @param preDelay Pre-delay in samples (clamped to the maximum).
+     * @param gains Send level per sample (input.getNumSamples() values).
+     *
+     * Used while a send level ramps.
+     */
+    void processAdd(const juce::AudioBuffer<float>& input,
+        juce::AudioBuffer<float>& output,
+        int preDelay,
+        const float* gains);
+
+    /**
+     * @brief Filters one block and writes it into the pre-delay rings without reading.
+     * @param input Input buffer (1 or 2 channels are used; mono feeds both lanes).
+     *
+     * Used when the rings are read by EarlyReflections instead of the upmix.
+     */
+    void push(const juce::AudioBuffer<float>& input);
+
+    /**
+     * @brief Gives read access to one lane's ring.
+     * @param lane Lane index (0 or 1).
+     * @return Ring holding the filtered input of that lane.
+     */
+    const DelayLine& getLine(int lane) const { return z[lane]; }
+
+    /** @brief Maximum pre-delay in samples (taps start after the clamped pre-delay). */
+    int getMaxPreDelay() const { return maxDelay; }
+
+    /**
+     * @brief Clears the filter states and pre-delay rings (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this stage.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the filter states and pre-delay rings (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+private:
+    /**
+     * @brief Runs the 2-lane HP/LP cascade into the scratch block.
+     * @param input Input buffer.
+     * @return Number of input channels used (0 if there is nothing to do).
+     */
+    int filterBlock(const juce::AudioBuffer<float>& input);
+
+    /**
+     * @brief Pre-delays the scratch block and writes or adds it to the output channels.
+     * @param numInputs Number of filtered lanes.
+     * @param numSamples Block length.
+     * @param output Destination buffer.
+     * @param preDelay Pre-delay in samples.
+     * @param accumulate Add (with gain) instead of overwrite.
+     * @param gain Gain used when accumulating.
+     * @param gains Per-sample gains used when accumulating instead of gain (nullptr for a constant gain).
+     */
+    void delayAndUpmix(int numInputs, int numSamples, juce::AudioBuffer<float>& output,
+        int preDelay, bool accumulate, float gain, const float* gains = nullptr);
+
+    /**
+     * @struct Biquad
+     * @brief Normalized biquad coefficients with per-lane TDF-II state.
+     */
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; ///< Coefficients (a0 = 1)
+        float s1[lanes] = {};                                       ///< First state per lane
+        float s2[lanes] = {};                                       ///< Second state per lane
+
+        /** @brief Loads coefficients from a table lookup. */
+        void setCoefficients(const CoefficientTable::Biquad& c);
+    };
+
+    double fs = 0.0;      ///< Sample rate in Hz
+    int blockSize = 0;    ///< Maximum processing block size
+    int maxDelay = 0;     ///< Maximum pre-delay in samples
+
+    Biquad highPass;      ///< High-pass stage (removes subsonic rumble)
+    Biquad lowPass;       ///< Low-pass stage (simulates HF absorption)
+    float previousLowPass = -1.0f;  ///< Last applied low-pass cutoff (-1 = none yet)
+    float previousHighPass = -1.0f; ///< Last applied high-pass cutoff (-1 = none yet)
+
+    std::vector<DelayLine> z;      ///< Pre-delay ring per lane
+    std::vector<float> scratch;    ///< Filtered block, [lane][sample]
+};
@@ -0,0 +1,254 @@
+#include "LevelMeter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Publishes the floor, so readers before prepare() see silence.
+ */
+LevelMeter::LevelMeter()
+{
+    publish(Readings());
+}
+
+/**
+ * @brief Derives the K-weighting filters and loudness steps for fs and clears all state.
+ *
+ * The K-weighting is the BS.1770 pre-filter: a high-shelf of about +4 dB
+ * above 1.5 kHz followed by a 38 Hz high-pass, both redesigned for the
+ * actual sample rate with the bilinear transform.
+ *
+ * @param fs Sample rate in Hz.
+ * @throws std::invalid_argument if fs <= 0.
+ */
+void LevelMeter::prepare(double fs)
+{
+    if (fs <= 0.0)
+        throw std::invalid_argument("Sample rate must be positive");
+
+    this->fs = fs;
+
+    // Stage 1: high-shelf
+    Biquad shelf;
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / fs);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // Stage 2: high-pass
+    Biquad highPass;
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / fs);
+        const double a0 = 1.0 + k / q + k * k;
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    for (auto& channel : kWeighting)
+        channel = { shelf, highPass };
+
+    stepLength = juce::jmax(1, static_cast<int>(std::lround(loudnessStepSeconds * fs)));
+    windowSteps = static_cast<int>(std::lround(loudnessWindowSeconds / loudnessStepSeconds));
+
+    stepPower.fill(0.0);
+    stepsFilled = 0;
+    stepIndex = 0;
+    stepSamples = 0;
+    stepEnergy = 0.0;
+    loudness = floorDb;
+
+    levels.clear();
+    std::fill(std::begin(inputPeak), std::end(inputPeak), 0.0);
+    std::fill(std::begin(outputPeak), std::end(outputPeak), 0.0);
+    std::fill(std::begin(inputPower), std::end(inputPower), 0.0);
+    std::fill(std::begin(outputPower), std::end(outputPower), 0.0);
+    wetPower = 0.0;
+
+    publish(Readings());
+}
+
+/**
+ * @brief Applies the ballistics to this callback's statistics and publishes them.
+ *
+ * Steps:
+ * 1. Peaks jump up to the callback's peak and otherwise fall at
+ *    peakFallDbPerSecond; mean squares are integrated with a one-pole
+ *    of rmsSeconds, stepped once per callback.
+ * 2. The output is K-weighted and summed into 100 ms loudness steps; the
+ *    short-term loudness is recomputed whenever a step completes.
+ * 3. The readings are published and the statistics cleared for the next callback.
+ *
+ * @param output Mixed output of the callback.
+ */
+void LevelMeter::update(const juce::AudioBuffer<float>& output)
+{
+    const int numSamples = levels.numSamples;
+    if (fs <= 0.0 || numSamples <= 0)
+    {
+        levels.clear();
+        return;
+    }
+
+    const int numChannels = juce::jlimit(1, 2, output.getNumChannels());
+    const double seconds = static_cast<double>(numSamples) / fs;
+    const double fall = std::pow(10.0, -peakFallDbPerSecond * seconds / 20.0);
+    const double alpha = 1.0 - std::exp(-seconds / rmsSeconds);
+    const double invSamples = 1.0 / static_cast<double>(numSamples);
+
+    // Step 1: ballistics
+    Readings readings;
+    double wet = 0.0;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        inputPeak[ch] = std::max(static_cast<double>(levels.inputPeak[ch]), inputPeak[ch] * fall);
+        outputPeak[ch] = std::max(static_cast<double>(levels.outputPeak[ch]), outputPeak[ch] * fall);
+        inputPower[ch] += alpha * (levels.inputSquares[ch] * invSamples - inputPower[ch]);
+        outputPower[ch] += alpha * (levels.outputSquares[ch] * invSamples - outputPower[ch]);
+        wet += levels.wetSquares[ch] * invSamples / numChannels;
+
+        readings.inputPeakDb[ch] = toDb(inputPeak[ch] * inputPeak[ch]);
+        readings.outputPeakDb[ch] = toDb(outputPeak[ch] * outputPeak[ch]);
+        readings.inputRmsDb[ch] = toDb(inputPower[ch]);
+        readings.outputRmsDb[ch] = toDb(outputPower[ch]);
+    }
+    wetPower += alpha * (wet - wetPower);
+    readings.wetEnergyDb = toDb(wetPower);
+
+    if (numChannels == 1)
+    {
+        readings.inputPeakDb[1] = readings.inputPeakDb[0];
+        readings.outputPeakDb[1] = readings.outputPeakDb[0];
+        readings.inputRmsDb[1] = readings.inputRmsDb[0];
+        readings.outputRmsDb[1] = readings.outputRmsDb[0];
+    }
+
+    // Step 2: short-term loudness
+    measureLoudness(output, numChannels);
+    readings.shortTermLufs = loudness;
+
+    // Step 3: publish
+    publish(readings);
+    levels.clear();
+}
+
+/**
+ * @brief K-weights the output and advances the short-term loudness window.
+ *
+ * Loudness = -0.691 + 10 log10(mean K-weighted power summed over channels),
+ * over the last windowSteps steps (fewer right after prepare()).
+ */
+void LevelMeter::measureLoudness(const juce::AudioBuffer<float>& output, int numChannels)
+{
+    const int numSamples = juce::jmin(levels.numSamples, output.getNumSamples());
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - start, stepLength - stepSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* data = output.getReadPointer(ch, start);
+            auto& shelf = kWeighting[ch][0];
+            auto& highPass = kWeighting[ch][1];
+            double energy = 0.0;
+            for (int n = 0; n < count; ++n)
+            {
+                const double y = highPass.process(shelf.process(data[n]));
+                energy += y * y;
+            }
+            shelf.snapToZero();
+            highPass.snapToZero();
+            stepEnergy += energy;
+        }
+
+        start += count;
+        stepSamples += count;
+        if (stepSamples < stepLength)
+            break;
+
+        // Step complete: it replaces the oldest one in the window
+        stepPower[static_cast<size_t>(stepIndex)] = stepEnergy;
+        stepIndex = (stepIndex + 1) % windowSteps;
+        stepsFilled = juce::jmin(stepsFilled + 1, windowSteps);
+        stepSamples = 0;
+        stepEnergy = 0.0;
+
+        double window = 0.0;
+        for (int i = 0; i < stepsFilled; ++i)
+            window += stepPower[static_cast<size_t>(i)];
+        const double power = window / (static_cast<double>(stepsFilled) * stepLength);
+        loudness = power > 0.0 ? juce::jmax(floorDb, static_cast<float>(-0.691 + 10.0 * std::log10(power))) : floorDb;
+    }
+}
+
+/**
+ * @brief Seqlock write: odd counter, relaxed word stores, even counter.
+ *
+ * The release fence orders the odd counter before the words, and the
+ * release store publishes the words before the even counter, so a reader
+ * that sees the same even value before and after its copy has a snapshot
+ * from a single update.
+ */
+void LevelMeter::publish(const Readings& readings)
+{
+    float words[numValues];
+    std::memcpy(words, &readings, sizeof(words));
+
+    const uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int i = 0; i < numValues; ++i)
+        published[static_cast<size_t>(i)].store(words[i], std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Seqlock read: retries while a write is in progress or completed during the copy.
+ */
+LevelMeter::Readings LevelMeter::read() const
+{
+    float words[numValues];
+    for (;;)
+    {
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0)
+            continue;
+
+        for (int i = 0; i < numValues; ++i)
+            words[i] = published[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            break;
+    }
+
+    Readings readings;
+    std::memcpy(&readings, words, sizeof(words));
+    return readings;
+}
+
+/**
+ * @brief Power to dB, clamped at floorDb.
+ */
+float LevelMeter::toDb(double power)
+{
+    return power > 0.0 ? juce::jmax(floorDb, static_cast<float>(10.0 * std::log10(power))) : floorDb;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// Standard library
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "OutputStage.h"
+
+/**
+ * @class LevelMeter
+ * @brief Monitoring levels published from the audio thread without locks.
+ *
+ * The audio thread hands over the peaks and sums of squares the output stage
+ * gathered during its mixing pass (OutputStage::Levels) together with the
+ * mixed output. The meter applies the display ballistics (peak fall-off,
+ * 300 ms RMS integration), K-weights the output for the 3 s short-term
+ * loudness of ITU-R BS.1770 and publishes one Readings snapshot per
+ * callback through a seqlock: the writer never waits, and readers on any
+ * thread (editor, exporters) retry in the rare case a snapshot changed
+ * while they copied it.
+ */
+class LevelMeter
+{
+public:
+    static constexpr float floorDb = -120.0f;               ///< Reported for silence
+    static constexpr float peakFallDbPerSecond = 20.0f;     ///< Peak meter release
+    static constexpr double rmsSeconds = 0.3;               ///< RMS / wet energy integration time
+    static constexpr double loudnessWindowSeconds = 3.0;    ///< Short-term loudness window
+    static constexpr double loudnessStepSeconds = 0.1;      ///< Short-term loudness update interval
+
+    /**
+     * @struct Readings
+     * @brief One published snapshot (all levels in dB, channel 1 = channel 0 for mono).
+     */
+    struct Readings
+    {
+        float inputPeakDb[2] { floorDb, floorDb };   ///< Input peak (dBFS, with fall-off)
+        float inputRmsDb[2] { floorDb, floorDb };    ///< Input RMS (dBFS)
+        float outputPeakDb[2] { floorDb, floorDb };  ///< Output peak (dBFS, with fall-off)
+        float outputRmsDb[2] { floorDb, floorDb };   ///< Output RMS (dBFS)
+        float shortTermLufs = floorDb;               ///< Output short-term loudness (LUFS)
+        float wetEnergyDb = floorDb;                 ///< Wet tail mean power over both channels (dBFS)
+    };
+    static_assert(std::is_trivially_copyable<Readings>::value, "Readings are published word by word");
+
+    /** @brief Constructs an idle meter (reads the floor until prepared). */
+    LevelMeter();
+
+    /** @brief Destructor. */
+    ~LevelMeter() = default;
+
+    // Copy and move operations are deleted: readers hold references to the published state
+    LevelMeter(const LevelMeter&) = delete;
+    LevelMeter& operator=(const LevelMeter&) = delete;
+    LevelMeter(LevelMeter&&) = delete;
+    LevelMeter& operator=(LevelMeter&&) = delete;
+
+    /**
+     * @brief Sets the sample rate and clears all state (not on the audio thread).
+     * @param fs Sample rate in Hz.
+     * @throws std::invalid_argument if fs <= 0.
+     */
+    void prepare(double fs);
+
+    /**
+     * @brief Statistics target for Reverb::setLevels, cleared by update().
+     */
+    OutputStage::Levels& getLevels() { return levels; }
+
+    /**
+     * @brief Turns one callback's statistics into readings and publishes them.
+     * @param output Mixed output of the callback (1 or 2 channels are used).
+     *
+     * Audio thread only. Does not allocate or lock.
+     */
+    void update(const juce::AudioBuffer<float>& output);
+
+    /**
+     * @brief Copies the latest snapshot (any thread, lock-free).
+     */
+    Readings read() const;
+
+private:
+    static constexpr int numValues = static_cast<int>(sizeof(Readings) / sizeof(float)); ///< Floats per snapshot
+    static constexpr int maxSteps = 64; ///< Capacity of the loudness step ring (>= window / step)
+    static_assert(loudnessWindowSeconds / loudnessStepSeconds < maxSteps, "Loudness step ring too small for the window");
+
+    /**
+     * @struct Biquad
+     * @brief Transposed direct form II section with double state.
+     */
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double s1 = 0.0, s2 = 0.0;
+
+        double process(double x)
+        {
+            const double y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            return y;
+        }
+
+        /** @brief Flushes decayed state, so long silences never run on denormals. */
+        void snapToZero()
+        {
+            if (std::abs(s1) < 1.0e-30) s1 = 0.0;
+            if (std::abs(s2) < 1.0e-30) s2 = 0.0;
+        }
+    };
+
+    /**
+     * @brief Adds the K-weighted power of the output to the loudness steps.
+     */
+    void measureLoudness(const juce::AudioBuffer<float>& output, int numChannels);
+
+    /**
+     * @brief Writes one snapshot under the seqlock.
+     */
+    void publish(const Readings& readings);
+
+    static float toDb(double power);
+
+    double fs = 0.0;                 ///< Sample rate in Hz
+    OutputStage::Levels levels;      ///< Filled by the output stage during the callback
+
+    // --- Ballistics (audio thread) ---
+    double inputPeak[2] {};          ///< Held input peaks (linear)
+    double outputPeak[2] {};         ///< Held output peaks (linear)
+    double inputPower[2] {};         ///< Integrated input mean squares
+    double outputPower[2] {};        ///< Integrated output mean squares
+    double wetPower = 0.0;           ///< Integrated wet mean square
+
+    // --- Short-term loudness (audio thread) ---
+    std::array<std::array<Biquad, 2>, 2> kWeighting; ///< [channel][shelf, high-pass]
+    std::array<double, maxSteps> stepPower {};        ///< K-weighted energy of each finished step
+    int stepLength = 1;              ///< Samples per loudness step
+    int windowSteps = 1;             ///< Steps per short-term window
+    int stepsFilled = 0;             ///< Finished steps in the window (up to windowSteps)
+    int stepIndex = 0;               ///< Ring slot of the step being filled
+    int stepSamples = 0;             ///< Samples in the step being filled
+    double stepEnergy = 0.0;         ///< K-weighted energy of the step being filled
+    float loudness = floorDb;        ///< Last short-term loudness
+
+    // --- Published state ---
+    std::atomic<uint32_t> sequence { 0 };               ///< Seqlock counter (odd while writing)
+    std::array<std::atomic<float>, numValues> published;  ///< Snapshot words
+};
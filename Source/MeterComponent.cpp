@@ -0,0 +1,94 @@
+#include "MeterComponent.h"
+
+namespace
+{
+    const juce::Colour velvet = juce::Colour::fromFloatRGBA(0.5f, 0.0f, 0.25f, 1.0f); ///< Knob and label colour
+}
+
+/**
+ * @brief Constructs the meter display and starts polling at 30 Hz.
+ * @param meter Source of the readings.
+ */
+MeterComponent::MeterComponent(const LevelMeter& meter)
+    : meter(meter)
+{
+    setOpaque(false);
+    startTimerHz(30);
+}
+
+/**
+ * @brief Stops polling before the component goes away.
+ */
+MeterComponent::~MeterComponent()
+{
+    stopTimer();
+}
+
+/**
+ * @brief Takes the latest snapshot and repaints.
+ */
+void MeterComponent::timerCallback()
+{
+    readings = meter.read();
+    repaint();
+}
+
+/**
+ * @brief Draws the input and output bar pairs and the loudness / wet energy text.
+ */
+void MeterComponent::paint(juce::Graphics& g)
+{
+    auto area = getLocalBounds();
+    auto text = area.removeFromRight(juce::jmin(area.getWidth() / 3, 220));
+    const int pairWidth = area.getWidth() / 2;
+
+    drawPair(g, area.removeFromLeft(pairWidth).reduced(4, 2), "IN", readings.inputPeakDb, readings.inputRmsDb);
+    drawPair(g, area.reduced(4, 2), "OUT", readings.outputPeakDb, readings.outputRmsDb);
+
+    auto formatDb = [](float db, const char* unit)
+    {
+        return db <= LevelMeter::floorDb ? juce::String("-inf ") + unit : juce::String(db, 1) + " " + unit;
+    };
+
+    g.setColour(velvet);
+    g.setFont(juce::Font("Courier New", 13.0f, juce::Font::bold));
+    const auto lines = text.reduced(4, 2);
+    g.drawText("Short-term " + formatDb(readings.shortTermLufs, "LUFS"),
+        lines.withHeight(lines.getHeight() / 2), juce::Justification::centredLeft);
+    g.drawText("Wet " + formatDb(readings.wetEnergyDb, "dB"),
+        lines.withTrimmedTop(lines.getHeight() / 2), juce::Justification::centredLeft);
+}
+
+/**
+ * @brief Draws the label and one bar per channel: RMS filled, peak as a line.
+ */
+void MeterComponent::drawPair(juce::Graphics& g, juce::Rectangle<int> area, const juce::String& label,
+    const float* peakDb, const float* rmsDb) const
+{
+    g.setColour(velvet);
+    g.setFont(juce::Font("Courier New", 13.0f, juce::Font::bold));
+    g.drawText(label, area.removeFromLeft(36), juce::Justification::centredLeft);
+
+    auto toX = [&area](float db)
+    {
+        const float t = juce::jlimit(0.0f, 1.0f, (db - minDb) / -minDb);
+        return static_cast<float>(area.getX()) + t * static_cast<float>(area.getWidth());
+    };
+
+    const int barHeight = area.getHeight() / 2;
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const auto bar = area.withY(area.getY() + ch * barHeight).withHeight(barHeight).reduced(0, 1).toFloat();
+
+        g.setColour(velvet.withAlpha(0.25f));
+        g.fillRect(bar);
+
+        g.setColour(velvet);
+        g.fillRect(bar.withRight(toX(rmsDb[ch])));
+
+        // Peak marker turns red at or above 0 dBFS
+        g.setColour(peakDb[ch] >= 0.0f ? juce::Colours::red : juce::Colours::white);
+        const float x = toX(peakDb[ch]);
+        g.drawLine(x, bar.getY(), x, bar.getBottom(), 1.5f);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "LevelMeter.h"
+
+/**
+ * @class MeterComponent
+ * @brief Horizontal level meters for input, output and the wet tail.
+ *
+ * Polls LevelMeter::read() at 30 Hz (lock-free, so painting never holds
+ * up the audio thread) and draws one bar pair per side: RMS as the filled
+ * bar, peak as a marker line. Short-term loudness and wet energy are shown
+ * as text.
+ */
+class MeterComponent : public juce::Component,
+    private juce::Timer
+{
+public:
+    /**
+     * @brief Constructs the meter display.
+     * @param meter Source of the readings; must outlive this component.
+     */
+    explicit MeterComponent(const LevelMeter& meter);
+
+    /** @brief Destructor stops the timer. */
+    ~MeterComponent() override;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    // --- JUCE Timer callback ---
+    void timerCallback() override;
+
+    /**
+     * @brief Draws one labelled stereo bar pair.
+     * @param g Graphics context.
+     * @param area Bounds of the pair including its label.
+     * @param label Text drawn left of the bars.
+     * @param peakDb Peak levels (dBFS) per channel.
+     * @param rmsDb RMS levels (dBFS) per channel.
+     */
+    void drawPair(juce::Graphics& g, juce::Rectangle<int> area, const juce::String& label,
+        const float* peakDb, const float* rmsDb) const;
+
+    static constexpr float minDb = -60.0f; ///< Left end of the bars
+
+    const LevelMeter& meter;            ///< Reading source
+    LevelMeter::Readings readings;      ///< Last snapshot painted
+
+    // Prevent copying and enable leak detection
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterComponent)
+};
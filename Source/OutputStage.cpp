@@ -0,0 +1,339 @@
+#include "OutputStage.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Constructs the output stage and its smoothers.
+ *
+ * @param fs Sample rate in Hz.
+ * @param blockSize Maximum audio block size.
+ * @param rampSeconds Smoothing time for mix, width and gain.
+ * @throws std::invalid_argument if fs <= 0 or blockSize <= 0.
+ */
+OutputStage::OutputStage(double fs, int blockSize, double rampSeconds)
+    : blockSize(blockSize)
+{
+    if (fs <= 0.0 || blockSize <= 0)
+        throw std::invalid_argument("Sample rate and block size must be positive");
+
+    mixSmoothed.reset(fs, rampSeconds);
+    widthSmoothed.reset(fs, rampSeconds);
+    gainSmoothed.reset(fs, rampSeconds);
+
+    wetGain.resize(blockSize, 0.0f);
+    dryGain.resize(blockSize, 0.0f);
+    sideGain.resize(blockSize, 0.0f);
+}
+
+namespace
+{
+    constexpr int lanes = OutputStage::lanes;
+
+    /**
+     * @brief Lane-wise partial statistics of one channel.
+     *
+     * Sample i is added to lane i % lanes, so neighbouring samples never
+     * depend on each other and the reductions vectorize without reordering
+     * any float sum.
+     */
+    struct LaneLevels
+    {
+        float inputPeak[lanes] {};
+        float inputSquares[lanes] {};
+        float outputPeak[lanes] {};
+        float outputSquares[lanes] {};
+        float wetSquares[lanes] {};
+
+        void add(int lane, float in, float out, float wet)
+        {
+            inputPeak[lane] = std::max(inputPeak[lane], std::abs(in));
+            inputSquares[lane] += in * in;
+            outputPeak[lane] = std::max(outputPeak[lane], std::abs(out));
+            outputSquares[lane] += out * out;
+            wetSquares[lane] += wet * wet;
+        }
+
+        /** @brief Folds the lanes into channel ch of the target. */
+        void fold(OutputStage::Levels& levels, int ch) const
+        {
+            for (int k = 0; k < lanes; ++k)
+            {
+                levels.inputPeak[ch] = std::max(levels.inputPeak[ch], inputPeak[k]);
+                levels.inputSquares[ch] += inputSquares[k];
+                levels.outputPeak[ch] = std::max(levels.outputPeak[ch], outputPeak[k]);
+                levels.outputSquares[ch] += outputSquares[k];
+                levels.wetSquares[ch] += wetSquares[k];
+            }
+        }
+    };
+
+    /**
+     * @brief Calls step(i, lane) for every sample, in whole groups of lanes first.
+     */
+    template <typename Step>
+    inline void forEachLane(int numSamples, Step&& step)
+    {
+        int i = 0;
+        for (; i + lanes <= numSamples; i += lanes)
+            for (int k = 0; k < lanes; ++k)
+                step(i + k, k);
+        for (int k = 0; i < numSamples; ++i, ++k)
+            step(i, k);
+    }
+
+    /**
+     * @brief Stereo width + mix + gain kernel.
+     *
+     * out = wetGain * (mid ± sideGain·(L - R)) + dryGain * dry
+     *
+     * @tparam Ramping Per-sample gains come from arrays instead of constants.
+     * @tparam WetOnly The dry signal is not mixed in (mix == 1).
+     * @tparam Metered Input, output and wet statistics are added to levels.
+     */
+    template <bool Ramping, bool WetOnly, bool Metered>
+    void mixStereo(const float* wetL, const float* wetR, float* outL, float* outR, int numSamples,
+        const float* wetGain, const float* dryGain, const float* sideGain,
+        float wetConst, float dryConst, float sideConst, OutputStage::Levels* levels)
+    {
+        LaneLevels left, right;
+
+        forEachLane(numSamples, [&](int i, int k)
+        {
+            const float wg = Ramping ? wetGain[i] : wetConst;
+            const float sg = Ramping ? sideGain[i] : sideConst;
+
+            const float mid = 0.5f * (wetL[i] + wetR[i]);
+            const float side = sg * (wetL[i] - wetR[i]);
+
+            // The dry input is only read when it is mixed in or metered
+            const float dryL = (WetOnly && !Metered) ? 0.0f : outL[i];
+            const float dryR = (WetOnly && !Metered) ? 0.0f : outR[i];
+
+            float yL = wg * (mid + side);
+            float yR = wg * (mid - side);
+            if constexpr (!WetOnly)
+            {
+                const float dg = Ramping ? dryGain[i] : dryConst;
+                yL += dg * dryL;
+                yR += dg * dryR;
+            }
+            outL[i] = yL;
+            outR[i] = yR;
+
+            if constexpr (Metered)
+            {
+                left.add(k, dryL, yL, wetL[i]);
+                right.add(k, dryR, yR, wetR[i]);
+            }
+        });
+
+        if constexpr (Metered)
+        {
+            left.fold(*levels, 0);
+            right.fold(*levels, 1);
+            levels->numSamples += numSamples;
+        }
+    }
+
+    /**
+     * @brief Mono mix + gain kernel (width does not apply).
+     */
+    template <bool Ramping, bool WetOnly, bool Metered>
+    void mixMono(const float* wet, float* out, int numSamples,
+        const float* wetGain, const float* dryGain, float wetConst, float dryConst, OutputStage::Levels* levels)
+    {
+        LaneLevels mono;
+
+        forEachLane(numSamples, [&](int i, int k)
+        {
+            const float wg = Ramping ? wetGain[i] : wetConst;
+            const float dry = (WetOnly && !Metered) ? 0.0f : out[i];
+
+            float y = wg * wet[i];
+            if constexpr (!WetOnly)
+            {
+                const float dg = Ramping ? dryGain[i] : dryConst;
+                y += dg * dry;
+            }
+            out[i] = y;
+
+            if constexpr (Metered)
+                mono.add(k, dry, y, wet[i]);
+        });
+
+        if constexpr (Metered)
+        {
+            mono.fold(*levels, 0);
+            levels->numSamples += numSamples;
+        }
+    }
+
+    /**
+     * @brief Picks the metered or plain stereo kernel.
+     */
+    template <bool Ramping, bool WetOnly>
+    void runStereo(const float* wetL, const float* wetR, float* outL, float* outR, int numSamples,
+        const float* wetGain, const float* dryGain, const float* sideGain,
+        float wetConst, float dryConst, float sideConst, OutputStage::Levels* levels)
+    {
+        if (levels != nullptr)
+            mixStereo<Ramping, WetOnly, true>(wetL, wetR, outL, outR, numSamples, wetGain, dryGain, sideGain, wetConst, dryConst, sideConst, levels);
+        else
+            mixStereo<Ramping, WetOnly, false>(wetL, wetR, outL, outR, numSamples, wetGain, dryGain, sideGain, wetConst, dryConst, sideConst, levels);
+    }
+
+    /**
+     * @brief Picks the metered or plain mono kernel.
+     */
+    template <bool Ramping, bool WetOnly>
+    void runMono(const float* wet, float* out, int numSamples,
+        const float* wetGain, const float* dryGain, float wetConst, float dryConst, OutputStage::Levels* levels)
+    {
+        if (levels != nullptr)
+            mixMono<Ramping, WetOnly, true>(wet, out, numSamples, wetGain, dryGain, wetConst, dryConst, levels);
+        else
+            mixMono<Ramping, WetOnly, false>(wet, out, numSamples, wetGain, dryGain, wetConst, dryConst, levels);
+    }
+}
+
+/**
+ * @brief Runs the fused width / mix / gain pass for one block.
+ *
+ * Steps:
+ * 1. Update smoother targets (the first block snaps to them).
+ * 2. If any smoother ramps, expand per-sample wet, dry and side gains.
+ * 3. Run the matching kernel in-place over the caller's buffer. When the mix
+ *    is settled at exactly 1 the dry-reading term is compiled out (unless
+ *    metering needs the input). With a metering target the kernel also
+ *    gathers peaks and sums of squares.
+ *
+ * @param wet Wet buffer (channels 0 and 1 are used).
+ * @param io Caller's buffer: dry input on entry, mixed output on return.
+ * @param mix Dry/wet mix target.
+ * @param stereoWidth Stereo width target.
+ * @param outputGain Linear output gain target.
+ */
+void OutputStage::process(const juce::AudioBuffer<float>& wet,
+    juce::AudioBuffer<float>& io,
+    float mix,
+    float stereoWidth,
+    float outputGain)
+{
+    const int numSamples = juce::jmin(io.getNumSamples(), blockSize);
+    const int numChannels = juce::jmin(io.getNumChannels(), 2);
+    if (numChannels < 1 || numSamples <= 0)
+        return;
+
+    // Step 1: smoother targets
+    if (!primed)
+    {
+        mixSmoothed.setCurrentAndTargetValue(mix);
+        widthSmoothed.setCurrentAndTargetValue(stereoWidth);
+        gainSmoothed.setCurrentAndTargetValue(outputGain);
+        primed = true;
+    }
+    else
+    {
+        mixSmoothed.setTargetValue(mix);
+        widthSmoothed.setTargetValue(stereoWidth);
+        gainSmoothed.setTargetValue(outputGain);
+    }
+
+    const bool ramping = mixSmoothed.isSmoothing()
+        || widthSmoothed.isSmoothing()
+        || gainSmoothed.isSmoothing();
+    const bool wetOnly = !mixSmoothed.isSmoothing() && mixSmoothed.getTargetValue() == 1.0f;
+
+    // Step 2: per-sample gains while ramping
+    if (ramping)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float m = mixSmoothed.getNextValue();
+            const float g = gainSmoothed.getNextValue();
+            wetGain[i] = g * m;
+            dryGain[i] = g * (1.0f - m);
+            sideGain[i] = 0.5f * widthSmoothed.getNextValue();
+        }
+    }
+
+    const float m = mixSmoothed.getCurrentValue();
+    const float g = gainSmoothed.getCurrentValue();
+    const float wetConst = g * m;
+    const float dryConst = g * (1.0f - m);
+    const float sideConst = 0.5f * widthSmoothed.getCurrentValue();
+
+    // Step 3: fused kernel
+    if (numChannels == 2)
+    {
+        const float* wetL = wet.getReadPointer(0);
+        const float* wetR = wet.getReadPointer(1);
+        float* outL = io.getWritePointer(0);
+        float* outR = io.getWritePointer(1);
+
+        if (ramping)
+        {
+            if (wetOnly)
+                runStereo<true, true>(wetL, wetR, outL, outR, numSamples, wetGain.data(), dryGain.data(), sideGain.data(), wetConst, dryConst, sideConst, levels);
+            else
+                runStereo<true, false>(wetL, wetR, outL, outR, numSamples, wetGain.data(), dryGain.data(), sideGain.data(), wetConst, dryConst, sideConst, levels);
+        }
+        else
+        {
+            if (wetOnly)
+                runStereo<false, true>(wetL, wetR, outL, outR, numSamples, wetGain.data(), dryGain.data(), sideGain.data(), wetConst, dryConst, sideConst, levels);
+            else
+                runStereo<false, false>(wetL, wetR, outL, outR, numSamples, wetGain.data(), dryGain.data(), sideGain.data(), wetConst, dryConst, sideConst, levels);
+        }
+    }
+    else
+    {
+        const float* wetData = wet.getReadPointer(0);
+        float* out = io.getWritePointer(0);
+
+        if (ramping)
+        {
+            if (wetOnly)
+                runMono<true, true>(wetData, out, numSamples, wetGain.data(), dryGain.data(), wetConst, dryConst, levels);
+            else
+                runMono<true, false>(wetData, out, numSamples, wetGain.data(), dryGain.data(), wetConst, dryConst, levels);
+        }
+        else
+        {
+            if (wetOnly)
+                runMono<false, true>(wetData, out, numSamples, wetGain.data(), dryGain.data(), wetConst, dryConst, levels);
+            else
+                runMono<false, false>(wetData, out, numSamples, wetGain.data(), dryGain.data(), wetConst, dryConst, levels);
+        }
+    }
+}
+
+/**
+ * @brief Clears the primed flag, so the smoothers restart at the next targets.
+ */
+void OutputStage::reset()
+{
+    primed = false;
+}
+
+/**
+ * @brief Reports the per-sample gain arrays.
+ */
+void OutputStage::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, wetGain);
+    EngineMemory::visit(visit, dryGain);
+    EngineMemory::visit(visit, sideGain);
+}
+
+/**
+ * @brief Reports whether the smoothers are set, and their positions on the ramps.
+ */
+void OutputStage::visitState(const EngineState::Visitor& visit)
+{
+    EngineState::visit(visit, primed);
+    EngineState::visit(visit, mixSmoothed);
+    EngineState::visit(visit, widthSmoothed);
+    EngineState::visit(visit, gainSmoothed);
+}
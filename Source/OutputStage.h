@@ -0,0 +1,125 @@
+#pragma once
+
+// Standard library
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "EngineMemory.h"
+#include "EngineState.h"
+
+/**
+ * @class OutputStage
+ * @brief Fused output stage: stereo width, dry/wet mix and output gain in one pass.
+ *
+ * Reads the wet signal from the reverb's 8-channel buffer and the dry signal
+ * straight from the caller's buffer (which the input stage never modifies),
+ * and writes the result back in-place, so no dry copy is ever made.
+ *
+ * Mix, width and gain are smoothed. While any of them ramps, the per-sample
+ * wet/dry/side gains are expanded into small arrays first, so the mixing loop
+ * itself stays branch-free and vectorizable. When the mix sits at exactly 1
+ * (aux send use) the dry signal is not read at all.
+ *
+ * With setLevels() the same pass also gathers input, output and wet peaks
+ * and sums of squares for metering, reduced lane-wise so the loop still
+ * vectorizes.
+ */
+class OutputStage
+{
+public:
+    static constexpr int lanes = 8; ///< Interleaved partial sums per metering reduction
+
+    /**
+     * @struct Levels
+     * @brief Per-channel statistics gathered by the mixing pass (channel 1 stays 0 for mono).
+     */
+    struct Levels
+    {
+        float inputPeak[2] {};      ///< Largest |dry input|
+        float inputSquares[2] {};   ///< Sum of squared dry input samples
+        float outputPeak[2] {};     ///< Largest |mixed output|
+        float outputSquares[2] {};  ///< Sum of squared mixed output samples
+        float wetSquares[2] {};     ///< Sum of squared wet samples (before width, mix and gain)
+        int numSamples = 0;         ///< Samples accumulated since clear()
+
+        /** @brief Zeroes all statistics. */
+        void clear() { *this = Levels(); }
+    };
+
+    /**
+     * @brief Constructs the output stage.
+     * @param fs Sample rate in Hz.
+     * @param blockSize Maximum audio block size.
+     * @param rampSeconds Smoothing time for mix, width and gain.
+     * @throws std::invalid_argument if fs <= 0 or blockSize <= 0.
+     */
+    OutputStage(double fs, int blockSize, double rampSeconds = 0.02);
+
+    /** @brief Default constructor (produces an empty, uninitialized stage). */
+    OutputStage() = default;
+
+    /** @brief Destructor. */
+    ~OutputStage() = default;
+
+    // Copy operations are deleted to prevent accidental deep copies
+    OutputStage(const OutputStage&) = delete;
+    OutputStage& operator=(const OutputStage&) = delete;
+
+    // Move operations are defaulted (safe for internal buffers)
+    OutputStage(OutputStage&&) noexcept = default;
+    OutputStage& operator=(OutputStage&&) noexcept = default;
+
+    /**
+     * @brief Mixes the wet signal into the caller's buffer.
+     * @param wet Wet buffer (channels 0 and 1 are used).
+     * @param io Caller's buffer: dry input on entry, mixed output on return.
+     * @param mix Dry/wet mix target (0.0 = dry, 1.0 = fully wet).
+     * @param stereoWidth Stereo width target (applied to stereo only).
+     * @param outputGain Linear output gain target.
+     */
+    void process(const juce::AudioBuffer<float>& wet,
+        juce::AudioBuffer<float>& io,
+        float mix,
+        float stereoWidth,
+        float outputGain);
+
+    /**
+     * @brief Accumulates metering statistics into the given target from now on.
+     * @param target Statistics added to by every process() call (nullptr = no metering).
+     *        Must outlive its use; the caller clears it.
+     */
+    void setLevels(Levels* target) { levels = target; }
+
+    /**
+     * @brief Makes the next block jump to its parameter values instead of ramping.
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this stage.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the smoothers (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+private:
+    int blockSize = 0;    ///< Maximum processing block size
+    bool primed = false;  ///< False until the first block sets the smoothers
+    Levels* levels = nullptr; ///< Metering target (not owned)
+
+    juce::SmoothedValue<float> mixSmoothed;   ///< Smoothed dry/wet mix
+    juce::SmoothedValue<float> widthSmoothed; ///< Smoothed stereo width
+    juce::SmoothedValue<float> gainSmoothed;  ///< Smoothed output gain
+
+    std::vector<float> wetGain;  ///< Per-sample wet gain (gain * mix) while ramping
+    std::vector<float> dryGain;  ///< Per-sample dry gain (gain * (1 - mix)) while ramping
+    std::vector<float> sideGain; ///< Per-sample side gain (0.5 * width) while ramping
+};
@@ -2,9 +2,9 @@
 #include "PluginEditor.h"
 
 UmbraAudioProcessorEditor::UmbraAudioProcessorEditor(UmbraAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p), meterDisplay(p.meter)
 {
-    setSize(800, 300);
+    setSize(800, 340);
 
     auto makeKnob = [this](juce::Slider& knob, juce::Label& label, const juce::String& labelText,
         double min = 0.0, double max = 1.0, bool isFrequency = false)
@@ -73,6 +73,8 @@ UmbraAudioProcessorEditor::UmbraAudioProcessorEditor(UmbraAudioProcessor& p)
     spectrogram3D.setFFTProcessor(&audioProcessor.fftProcessor);
 
     // Removed startTimer here since timer is now in Spectrogram3DComponent
+
+    addAndMakeVisible(meterDisplay);
 }
 
 UmbraAudioProcessorEditor::~UmbraAudioProcessorEditor()
@@ -125,4 +127,8 @@ void UmbraAudioProcessorEditor::resized()
     int spectrogramY = totalHeight - spectrogramHeight;
 
     spectrogram3D.setBounds(spectrogramX, spectrogramY, spectrogramWidth, spectrogramHeight);
+
+    // Level meters between the knobs and the spectrogram
+    const int meterTop = knobTopMargin + knobHeight + spacing;
+    meterDisplay.setBounds(0, meterTop, totalWidth, juce::jmax(0, spectrogramY - meterTop - spacing));
 }
@@ -4,6 +4,7 @@
 #include "PluginProcessor.h"
 #include "CustomLookAndFeel.h"
 #include "Spectrogram3DComponent.h"
+#include "MeterComponent.h"
 
 class UmbraAudioProcessorEditor : public juce::AudioProcessorEditor
 {
@@ -47,6 +48,8 @@ private:
 
     Spectrogram3DComponent spectrogram3D;
 
+    MeterComponent meterDisplay;
+
     CustomLookAndFeel customLookAndFeel;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UmbraAudioProcessorEditor)
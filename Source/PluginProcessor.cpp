@@ -7,6 +7,10 @@ UmbraAudioProcessor::UmbraAudioProcessor()
 #if !JucePlugin_IsMidiEffect
 #if !JucePlugin_IsSynth
         .withInput("Input", juce::AudioChannelSet::stereo(), true)
+        .withInput("Send 1", juce::AudioChannelSet::stereo(), false)
+        .withInput("Send 2", juce::AudioChannelSet::stereo(), false)
+        .withInput("Send 3", juce::AudioChannelSet::stereo(), false)
+        .withInput("Send 4", juce::AudioChannelSet::stereo(), false)
 #endif
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)
 #endif
@@ -21,13 +25,29 @@ UmbraAudioProcessor::UmbraAudioProcessor()
             //  Add these missing parameters:
             std::make_unique<juce::AudioParameterFloat>("roomSize", "Room Size", 0.1f, 2.0f, 0.1f),
             std::make_unique<juce::AudioParameterFloat>("dampening", "Dampening", 20.0f, 20000.0f, 20.0f),
-            std::make_unique<juce::AudioParameterFloat>("initialDelay", "Initial Delay", 0.0f, 0.1f, 0.0f)
+            std::make_unique<juce::AudioParameterFloat>("initialDelay", "Initial Delay", 0.0f, 0.1f, 0.0f),
+
+            // Sidechain sends feeding the shared tail
+            std::make_unique<juce::AudioParameterFloat>("send1Level", "Send 1 Level", 0.0f, 1.0f, 1.0f),
+            std::make_unique<juce::AudioParameterFloat>("send1Delay", "Send 1 Delay", 0.0f, 0.1f, 0.0f),
+            std::make_unique<juce::AudioParameterFloat>("send2Level", "Send 2 Level", 0.0f, 1.0f, 1.0f),
+            std::make_unique<juce::AudioParameterFloat>("send2Delay", "Send 2 Delay", 0.0f, 0.1f, 0.0f),
+            std::make_unique<juce::AudioParameterFloat>("send3Level", "Send 3 Level", 0.0f, 1.0f, 1.0f),
+            std::make_unique<juce::AudioParameterFloat>("send3Delay", "Send 3 Delay", 0.0f, 0.1f, 0.0f),
+            std::make_unique<juce::AudioParameterFloat>("send4Level", "Send 4 Level", 0.0f, 1.0f, 1.0f),
+            std::make_unique<juce::AudioParameterFloat>("send4Delay", "Send 4 Delay", 0.0f, 0.1f, 0.0f)
 
         })
 
 #endif
 {
-    // Your existing code (if any) here
+    // Cache the send parameter pointers so processBlock never builds IDs
+    for (int i = 0; i < numSendBuses; ++i)
+    {
+        const juce::String prefix = "send" + juce::String(i + 1);
+        sendLevels[i] = parameters.getRawParameterValue(prefix + "Level");
+        sendDelays[i] = parameters.getRawParameterValue(prefix + "Delay");
+    }
 }
 
 
@@ -100,7 +120,17 @@ void UmbraAudioProcessor::changeProgramName(int index, const juce::String& newNa
 
 void UmbraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    r = std::make_unique<Reverb>(sampleRate, samplesPerBlock);
+    ReverbOptions options;
+    options.numSends = numSendBuses;
+
+    // Use this machine's autotuned thread count if one was stored (UmbraCLI autotune)
+    Autotuner::load(options);
+
+    r = std::make_unique<Reverb>(sampleRate, samplesPerBlock, options);
+
+    // The output stage gathers the meter statistics in its mixing pass
+    meter.prepare(sampleRate);
+    r->setLevels(&meter.getLevels());
 }
 
 
@@ -122,6 +152,14 @@ bool UmbraAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 #if !JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // Sends may be disabled, mono or stereo
+    for (int bus = 1; bus < layouts.inputBuses.size(); ++bus)
+    {
+        const auto& set = layouts.getChannelSet(true, bus);
+        if (!set.isDisabled() && set != juce::AudioChannelSet::mono() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
 #endif
     return true;
 #endif
@@ -130,23 +168,48 @@ bool UmbraAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 
 void UmbraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
-    const int numChannels = getTotalNumInputChannels();
+    // The host buffer also carries the send buses; the reverb runs on the main bus only
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    const int numChannels = getMainBusNumInputChannels();
     const int numSamples = buffer.getNumSamples();
 
-    for (int ch = numChannels; ch < getTotalNumOutputChannels(); ++ch)
+    for (int ch = numChannels; ch < getMainBusNumOutputChannels(); ++ch)
         buffer.clear(ch, 0, numSamples);
 
     // === PARAMETERS ===
-    float mix = *parameters.getRawParameterValue("mix");
-    float stereoWidth = *parameters.getRawParameterValue("stereoWidth");
-    float lowPass = *parameters.getRawParameterValue("lowPass");
-    float highPass = *parameters.getRawParameterValue("highPass");
-    float dampening = *parameters.getRawParameterValue("dampening");
-    float roomSize = *parameters.getRawParameterValue("roomSize");
-    float initialDelay = *parameters.getRawParameterValue("initialDelay");
-
-    r->process(buffer, mix, stereoWidth, lowPass, highPass, dampening, roomSize, initialDelay);
-    fftProcessor.pushSamples(buffer);
+    ReverbParameters target;
+    target.mix = *parameters.getRawParameterValue("mix");
+    target.stereoWidth = *parameters.getRawParameterValue("stereoWidth");
+    target.lowPass = *parameters.getRawParameterValue("lowPass");
+    target.highPass = *parameters.getRawParameterValue("highPass");
+    target.dampening = *parameters.getRawParameterValue("dampening");
+    target.roomSize = *parameters.getRawParameterValue("roomSize");
+    target.initialDelay = *parameters.getRawParameterValue("initialDelay");
+
+    // === SENDS ===
+    // Send i always maps to the reverb's input stage i, so enabling or
+    // disabling one bus never shifts the filter/pre-delay state of the others
+    for (int i = 0; i < numSendBuses; ++i)
+    {
+        auto* bus = getBus(true, i + 1);
+        sends[i].buffer = nullptr;
+        if (bus == nullptr || !bus->isEnabled() || bus->getNumberOfChannels() == 0)
+            continue;
+
+        const int first = getChannelIndexInProcessBlockBuffer(true, i + 1, 0);
+        sendBuffers[i].setDataToReferTo(buffer.getArrayOfWritePointers() + first,
+            bus->getNumberOfChannels(), numSamples);
+        sends[i].buffer = &sendBuffers[i];
+        sends[i].level = *sendLevels[i]; // ramped per sample by the reverb
+        sends[i].preDelay = *sendDelays[i];
+    }
+
+    // JUCE hands us one value per parameter per callback (no timestamps), so
+    // glide from the running values towards it in control-rate sub-blocks,
+    // starting in this callback
+    r->processSmoothed(mainBuffer, target, sends.data(), numSendBuses);
+    meter.update(mainBuffer);
+    fftProcessor.pushSamples(mainBuffer);
 }
 
 
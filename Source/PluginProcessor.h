@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <JuceHeader.h>
 #include "Reverb.h"
+#include "Autotuner.h"
 #include "FFTProcessor.h"
+#include "LevelMeter.h"
 
 class UmbraAudioProcessor : public juce::AudioProcessor
 {
@@ -41,12 +44,22 @@ public:
     // FFT related
     FFTProcessor fftProcessor;
 
+    // Input / output / wet levels and loudness, published lock-free each callback
+    LevelMeter meter;
+
     std::unique_ptr<Reverb> r;
 
     // Parameters
     juce::AudioProcessorValueTreeState parameters;
 
+    static constexpr int numSendBuses = 4; ///< Optional sidechain inputs sharing the reverb tail
+
 private:
+    std::array<juce::AudioBuffer<float>, numSendBuses> sendBuffers; ///< Views into the send buses
+    std::array<ReverbSend, numSendBuses> sends;                      ///< Send descriptors handed to the reverb
+    std::array<std::atomic<float>*, numSendBuses> sendLevels {};     ///< "sendNLevel" parameter values
+    std::array<std::atomic<float>*, numSendBuses> sendDelays {};     ///< "sendNDelay" parameter values
+
     //float previousLowPassCutoff = -1.0f;
     //float previousHighPassCutoff = -1.0f;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UmbraAudioProcessor)
@@ -67,3 +67,31 @@ void RRSFilter::process(float* block, int blockSize)
         block[i] = y;
     }
 }
+
+/**
+ * @brief Clears x[n-M] and y[n-1].
+ */
+void RRSFilter::reset()
+{
+    z_M.reset();
+    z_1.reset();
+}
+
+/**
+ * @brief Reports both delay lines and the block buffer.
+ */
+void RRSFilter::visitMemory(const EngineMemory::Visitor& visit)
+{
+    z_M.visitMemory(visit);
+    z_1.visitMemory(visit);
+    EngineMemory::visit(visit, y);
+}
+
+/**
+ * @brief Reports both delay lines; the block buffer is scratch.
+ */
+void RRSFilter::visitState(const EngineState::Visitor& visit)
+{
+    z_M.visitState(visit);
+    z_1.visitState(visit);
+}
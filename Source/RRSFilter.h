@@ -54,6 +54,23 @@ public:
      */
     void process(float* block, int blockSize);
 
+    /**
+     * @brief Clears the filter history (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this filter.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports x[n-M] and y[n-1] (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
 private:
     DelayLine z_M;          /**< Delay line for x[n-M] */
     DelayLine z_1;          /**< Delay line for y[n-1] */
@@ -1,68 +1,384 @@
 #include "Reverb.h"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+/**
+ * @brief Derives an independent seed for one stage from the topology seed.
+ *
+ * Stage indices are fixed (1-3 = d1-d3, 4-5 = fdn1-fdn2), so reordering the
+ * construction code never changes a topology.
+ *
+ * @param seed Topology seed.
+ * @param stage Stage index.
+ * @return Seed for that stage.
+ */
+uint32_t Reverb::stageSeed(uint32_t seed, uint32_t stage)
+{
+    std::seed_seq sequence{ seed, stage };
+    uint32_t result = 0;
+    sequence.generate(&result, &result + 1);
+    return result;
+}
+
+/**
+ * @brief Linearly interpolates every parameter between a and b.
+ */
+ReverbParameters ReverbParameters::interpolate(const ReverbParameters& a, const ReverbParameters& b, float t)
+{
+    auto lerp = [t](float x, float y) { return x + t * (y - x); };
+
+    ReverbParameters p;
+    p.mix = lerp(a.mix, b.mix);
+    p.stereoWidth = lerp(a.stereoWidth, b.stereoWidth);
+    p.lowPass = lerp(a.lowPass, b.lowPass);
+    p.highPass = lerp(a.highPass, b.highPass);
+    p.dampening = lerp(a.dampening, b.dampening);
+    p.roomSize = lerp(a.roomSize, b.roomSize);
+    p.initialDelay = lerp(a.initialDelay, b.initialDelay);
+    p.outputGain = lerp(a.outputGain, b.outputGain);
+    return p;
+}
+
+/**
+ * @brief Compares every parameter.
+ */
+bool ReverbParameters::operator==(const ReverbParameters& other) const
+{
+    return mix == other.mix && stereoWidth == other.stereoWidth
+        && lowPass == other.lowPass && highPass == other.highPass
+        && dampening == other.dampening && roomSize == other.roomSize
+        && initialDelay == other.initialDelay && outputGain == other.outputGain;
+}
 
 /**
  * @brief Constructs a Reverb with given sample rate and block size.
  *
  * Initializes:
- * - Three diffusers (DVN-based) with preconfigured pulse counts and sizes.
- * - Two FDNs for late reverb.
- * - Initial delay lines (pre-delay).
- * - Low/high-pass filters.
+ * - The coefficient table for fs (input filters and FDN damping).
+ * - The fused input stage (filters, pre-delay, upmix).
+ * - Three diffusers (DVN or allpass, per options) with preconfigured pulse counts and sizes.
+ * - Two FDNs for late reverb, or one 16-line FDN with absorption filters
+ *   (options.highOrderFDN; its delays are half as long, as 16 lines give
+ *   the density that two serial networks needed), all mixing with
+ *   options.feedbackMatrix.
+ * - The fused output stage (width, mix, gain).
+ * - The 8-channel wet buffer.
+ * - One input stage per extra send (options.numSends).
+ * - In Eco mode (options.earlyReflections), the early-reflection stage
+ *   instead of d1; the input rings then keep enough history for its taps.
+ * - In frozen mode (options.frozen), the IR grid renderer. Its chains are
+ *   built from the same resolved seed, so the grid reproduces this
+ *   instance's tail.
+ * - Finally, every page of engine memory is prefaulted, and pinned if
+ *   options.lockMemory is set. In deterministic frozen mode the grid is
+ *   then awaited, so when the frozen tail takes over never depends on
+ *   thread timing.
  *
  * @param fs Sample rate in Hz.
  * @param blockSize Maximum audio block size.
+ * @param options Engine selection per diffuser stage, FDN storage format and topology seed.
+ * @throws std::invalid_argument if frozen and earlyReflections are both set
+ *         (the early taps differ per lane, so the tail input is no longer two signals),
+ *         options.deterministic is set with seed 0, or a decay time is negative.
  */
-Reverb::Reverb(float fs, int blockSize)
+Reverb::Reverb(float fs, int blockSize, const ReverbOptions& options)
     : fs(fs), blockSize(blockSize),
-    d1(8, 200, 2000, blockSize, fs),
-    d2(8, 200, 2000, blockSize, fs),
-    d3(8, 200, 2000, blockSize, fs),
-    fdn1(8, static_cast<int>(0.1f * fs), blockSize),
-    fdn2(8, static_cast<int>(0.1f * fs), blockSize)
-{
-    // Pre-delay lines for first 2 channels
-    z.resize(2);
-    for (int ch = 0; ch < 2; ++ch)
-        z[ch] = DelayLine(static_cast<int>(0.1f * fs), 1.0f, blockSize);
-
-
-    // Initialize per-channel filters 
-    lowPassFilters.resize(2); 
-    highPassFilters.resize(2); 
-    
-    for (int ch = 0; ch < 2; ++ch)
-    {
-        lowPassFilters[ch].reset();
-        highPassFilters[ch].reset();
-
-        lowPassFilters[ch].setCoefficients(
-            juce::IIRCoefficients::makeLowPass(fs, 20000.0)
-        );
-
-        highPassFilters[ch].setCoefficients(
-            juce::IIRCoefficients::makeHighPass(fs, 20.0)
-        );
+    seed(options.seed != 0 ? options.seed : std::random_device{}()),
+    coefficients(fs),
+    input(fs, blockSize, 0.1f, options.earlyReflections ? EarlyReflections::maxReflectionTime : 0.0f),
+    d1(options.earlyReflections ? Diffuser()
+        : Diffuser(8, 200, 2000, blockSize, fs, options.d1Engine, stageSeed(seed, 1), options.diffuserThreads)),
+    d2(8, 200, 2000, blockSize, fs, options.d2Engine, stageSeed(seed, 2), options.diffuserThreads),
+    d3(8, 200, 2000, blockSize, fs, options.d3Engine, stageSeed(seed, 3), options.diffuserThreads),
+    fdn1(options.highOrderFDN
+        ? FDN(16, static_cast<int>(0.05f * fs), blockSize, options.feedbackMatrix, options.fdnStorage,
+            stageSeed(seed, 4), FDNDecay{ options.decayLow, options.decayHigh })
+        : FDN(8, static_cast<int>(0.1f * fs), blockSize, options.feedbackMatrix, options.fdnStorage, stageSeed(seed, 4))),
+    fdn2(options.highOrderFDN ? FDN()
+        : FDN(8, static_cast<int>(0.1f * fs), blockSize, options.feedbackMatrix, options.fdnStorage, stageSeed(seed, 5))),
+    output(fs, blockSize)
+{
+    if (options.deterministic && options.seed == 0)
+        throw std::invalid_argument("Deterministic mode needs a non-zero seed.");
+
+    useEarlyReflections = options.earlyReflections;
+    useHighOrderFDN = options.highOrderFDN;
+    microBlockSize = juce::jlimit(1, juce::jmax(1, blockSize),
+        options.microBlockSize > 0 && !options.deterministic ? options.microBlockSize : controlBlockSize);
+    rampLength = juce::jmax(1, static_cast<int>(std::round(smoothingSeconds * fs)));
+    if (useEarlyReflections)
+        early = EarlyReflections(fs, 8);
+
+    // Wet buffer for the 8-channel chain, sized once so process() never allocates
+    work.setSize(8, blockSize);
+
+    // Early stages for the extra inputs sharing this tail
+    sendInputs.reserve(juce::jmax(0, options.numSends));
+    for (int i = 0; i < options.numSends; ++i)
+        sendInputs.emplace_back(fs, blockSize, 0.1f,
+            options.earlyReflections ? EarlyReflections::maxReflectionTime : 0.0f);
+
+    // Level smoothers, silence for disabled sends and the ramp scratch
+    sendLevels.resize(sendInputs.size());
+    for (auto& level : sendLevels)
+        level.reset(fs, smoothingSeconds);
+    if (!sendInputs.empty())
+    {
+        sendSilence.setSize(2, blockSize);
+        sendSilence.clear();
+        sendGains.resize(static_cast<size_t>(blockSize));
+        if (useEarlyReflections)
+            sendWork.setSize(8, blockSize);
     }
 
-    // Store the current cutoff values so they can be updated dynamically later
-    previousLowPass = 20000.0f;
-    previousHighPass = 20.0f;
+    if (options.frozen)
+    {
+        if (options.earlyReflections)
+            throw std::invalid_argument("Frozen mode cannot be combined with early reflections.");
+
+        ReverbOptions chainOptions = options;
+        chainOptions.seed = seed;
+
+        frozenBlock.setSize(2, blockSize);
+        frozen = std::make_unique<FrozenTail>(fs, options.frozenGrid,
+            [fs, blockSize, chainOptions](float roomSize, float dampening, juce::AudioBuffer<float>& ir)
+            {
+                return renderTailResponses(fs, blockSize, chainOptions, roomSize, dampening, ir);
+            },
+            options.lockMemory);
+    }
+
+    prepareMemory(options.lockMemory);
+
+    if (options.deterministic)
+        waitForFrozenGrid();
+}
+
+/**
+ * @brief Resets every stage; the wet buffers are cleared as well, so no
+ *        stale samples can reach the output.
+ */
+void Reverb::reset()
+{
+    input.reset();
+    for (auto& send : sendInputs)
+        send.reset();
+
+    d1.reset();
+    d2.reset();
+    d3.reset();
+    fdn1.reset();
+    fdn2.reset();
+    output.reset();
+
+    if (frozen != nullptr)
+        frozen->reset();
+    liveTail = true; // the next block crossfades from the (cleared) live tail, as in a new engine
+
+    work.clear();
+    frozenBlock.clear();
+    rampStarted = false; // the next processSmoothed() call starts at its target
+    sendsPrimed = false; // and the send levels start at theirs
+}
+
+/**
+ * @brief Reports the regions of every stage, then the wet buffers.
+ *
+ * subBlock and sendBlock are views into caller buffers and own nothing.
+ */
+void Reverb::visitMemory(const EngineMemory::Visitor& visit)
+{
+    coefficients.visitMemory(visit);
+    input.visitMemory(visit);
+    EngineMemory::visit(visit, sendInputs);
+    for (auto& send : sendInputs)
+        send.visitMemory(visit);
+
+    d1.visitMemory(visit);
+    d2.visitMemory(visit);
+    d3.visitMemory(visit);
+    fdn1.visitMemory(visit);
+    fdn2.visitMemory(visit);
+    output.visitMemory(visit);
+
+    if (frozen != nullptr)
+        frozen->visitMemory(visit);
+
+    EngineMemory::visit(visit, work);
+    EngineMemory::visit(visit, frozenBlock);
+    EngineMemory::visit(visit, sendSilence);
+    EngineMemory::visit(visit, sendWork);
+    EngineMemory::visit(visit, sendGains);
+}
+
+/**
+ * @brief Reports the state of every stage in chain order, then the frozen tail switch.
+ *
+ * The wet buffers are overwritten by every block and the early reflections
+ * follow the room size, so neither holds state.
+ */
+void Reverb::visitState(const EngineState::Visitor& visit)
+{
+    input.visitState(visit);
+    for (auto& send : sendInputs)
+        send.visitState(visit);
+    EngineState::visit(visit, sendsPrimed);
+    EngineState::visit(visit, sendLevels);
+
+    d1.visitState(visit);
+    d2.visitState(visit);
+    d3.visitState(visit);
+    fdn1.visitState(visit);
+    fdn2.visitState(visit);
+    output.visitState(visit);
+
+    if (frozen != nullptr)
+        frozen->visitState(visit);
+
+    EngineState::visit(visit, liveTail);
+}
+
+/**
+ * @brief Header plus every region from visitState().
+ */
+size_t Reverb::getStateSize()
+{
+    return EngineState::getSize([this](const EngineState::Visitor& visit) { visitState(visit); });
+}
+
+/**
+ * @brief Copies every region from visitState() behind a header naming seed and sample rate.
+ */
+size_t Reverb::saveState(void* destination, size_t size)
+{
+    return EngineState::save([this](const EngineState::Visitor& visit) { visitState(visit); },
+        seed, fs, destination, size);
+}
+
+/**
+ * @brief Allocates a block of getStateSize() bytes and saves into it.
+ */
+juce::MemoryBlock Reverb::saveState()
+{
+    juce::MemoryBlock block(getStateSize());
+    saveState(block.getData(), block.getSize());
+    return block;
+}
+
+/**
+ * @brief Copies the snapshot back; waits for the frozen grid if the saved
+ *        engine had switched to it, so the next block convolves as well.
+ */
+void Reverb::restoreState(const void* data, size_t size)
+{
+    EngineState::restore([this](const EngineState::Visitor& visit) { visitState(visit); },
+        seed, fs, data, size);
+
+    if (!liveTail)
+        waitForFrozenGrid();
+}
+
+/**
+ * @brief Touches every page of engine memory, and pins it on request.
+ *
+ * Locking stops at the first refusal (see EngineMemory::Lock); the
+ * remaining regions are still prefaulted, so a low RLIMIT_MEMLOCK only
+ * loses the protection against swapping.
+ */
+void Reverb::prepareMemory(bool lock)
+{
+    memoryStats = {};
+    memoryLock.release();
+
+    visitMemory([this, lock](void* data, size_t bytes)
+    {
+        ++memoryStats.regions;
+        memoryStats.bytes += bytes;
+        memoryStats.pages += EngineMemory::prefault(data, bytes);
+        if (lock)
+            memoryLock.add(data, bytes);
+    });
+
+    memoryStats.lockedBytes = memoryLock.getLockedBytes();
+    memoryStats.lockFailed = memoryLock.hasFailed();
+}
+
+/**
+ * @brief Waits for the frozen grid, if frozen mode is on.
+ */
+bool Reverb::waitForFrozenGrid(int timeoutMs)
+{
+    return frozen == nullptr || frozen->waitUntilReady(timeoutMs);
+}
+
+/**
+ * @brief Renders the tail's responses on its two distinct inputs.
+ *
+ * Each input gets a fresh chain (without sends, early reflections or
+ * frozen mode) so both responses start from silence. The impulse goes
+ * straight into the wet buffer, bypassing the input stage, which stays live
+ * in frozen mode.
+ *
+ * @param fs Sample rate in Hz.
+ * @param blockSize Block size of the rendering chain.
+ * @param options Engine options of the instance being reproduced.
+ * @param roomSize Room size for the FDNs.
+ * @param dampening Dampening cutoff (Hz) for the FDNs.
+ * @param ir 4-channel response buffer (length = response length).
+ * @return False if the calling thread was asked to exit.
+ */
+bool Reverb::renderTailResponses(float fs, int blockSize, const ReverbOptions& options,
+    float roomSize, float dampening, juce::AudioBuffer<float>& ir)
+{
+    ReverbOptions chainOptions = options;
+    chainOptions.frozen = false;
+    chainOptions.earlyReflections = false;
+    chainOptions.numSends = 0;
+    chainOptions.lockMemory = false;
+
+    const int length = ir.getNumSamples();
+    for (int input = 0; input < 2; ++input)
+    {
+        Reverb chain(fs, blockSize, chainOptions);
+
+        for (int start = 0; start < length; start += blockSize)
+        {
+            if (juce::Thread::currentThreadShouldExit())
+                return false;
+
+            const int numSamples = juce::jmin(blockSize, length - start);
+            chain.work.setSize(8, numSamples, false, false, true);
+            chain.work.clear();
+
+            // Excitation 1 - z^-2 (see FrozenTail), placed once the block reaches sample 2
+            for (int n = 0; n < 3; ++n)
+            {
+                if (n == 1 || n < start || n >= start + numSamples)
+                    continue;
+
+                const float value = n == 0 ? 1.0f : -1.0f;
+                if (input == 0)
+                    chain.work.setSample(0, n - start, value);
+                else
+                    for (int lane = 1; lane < 8; ++lane)
+                        chain.work.setSample(lane, n - start, value);
+            }
+
+            chain.processTail(dampening, roomSize);
 
+            for (int ch = 0; ch < 2; ++ch)
+                ir.copyFrom(2 * input + ch, start, chain.work, ch, 0, numSamples);
+        }
+    }
+
+    return true;
 }
 
 /**
  * @brief Processes an audio buffer with the full reverb chain.
  *
- * Steps:
- * 1. Resize initial delay lines to match number of channels if needed.
- * 2. Update low/high-pass filters if their cutoff frequencies changed.
- * 3. Store a copy of the dry buffer.
- * 4. Apply high-pass and low-pass filtering in-place.
- * 5. Apply initial pre-delay per channel using DelayLine.
- * 6. Upscale buffer to 4 channels if original channels < 4.
- * 7. Apply three diffuser stages and two FDN stages.
- * 8. Apply stereo width adjustment (Mid/Side) if stereo.
- * 9. Mix dry and wet signals in-place using inline references.
+ * Convenience overload taking scalar parameters; see process(buffer, params).
  *
  * @param buffer Audio buffer to process.
  * @param mix Dry/wet mix (0.0 = dry, 1.0 = fully wet).
@@ -72,6 +388,7 @@ Reverb::Reverb(float fs, int blockSize)
  * @param dampening FDN damping coefficient.
  * @param roomSize Scaling factor for FDN delay indices.
  * @param initialDelay Pre-delay in seconds applied before reverb.
+ * @param outputGain Linear gain applied to the mixed output.
  */
 void Reverb::process(juce::AudioBuffer<float>& buffer,
     float mix,
@@ -80,98 +397,330 @@ void Reverb::process(juce::AudioBuffer<float>& buffer,
     float highPass,
     float dampening,
     float roomSize,
-    float initialDelay)
+    float initialDelay,
+    float outputGain)
 {
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    ReverbParameters params;
+    params.mix = mix;
+    params.stereoWidth = stereoWidth;
+    params.lowPass = lowPass;
+    params.highPass = highPass;
+    params.dampening = dampening;
+    params.roomSize = roomSize;
+    params.initialDelay = initialDelay;
+    params.outputGain = outputGain;
+
+    process(buffer, params);
+}
 
-    // Resize pre-delay lines if number of channels changed
-    if (z.size() != numChannels)
+/**
+ * @brief Processes a buffer of any length with constant parameters.
+ *
+ * Buffers longer than blockSize are processed in blockSize chunks through
+ * a non-owning view, so hosts that exceed the announced block size are safe.
+ *
+ * @param buffer Audio buffer to process in-place.
+ * @param params Parameter values for the whole buffer.
+ * @param sends Optional extra inputs summed into the shared tail.
+ * @param numSends Number of entries in sends.
+ */
+void Reverb::process(juce::AudioBuffer<float>& buffer, const ReverbParameters& params,
+    const ReverbSend* sends, int numSends)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= blockSize)
     {
-        z.resize(numChannels);
-        for (int ch = 0; ch < numChannels; ++ch)
-            z[ch] = DelayLine(static_cast<int>(0.1f * fs), 1.0f, blockSize);
+        processChunk(buffer, params, sends, numSends, 0);
+        return;
     }
 
-    // Update filters if cutoff changed - update all channel instances
-    if (lowPass != previousLowPass)
+    for (int start = 0; start < numSamples; start += blockSize)
     {
-        auto coeffs = juce::IIRCoefficients::makeLowPass(fs, lowPass);
-        for (int ch = 0; ch < numChannels; ++ch)
-            lowPassFilters[ch].setCoefficients(coeffs);
-        previousLowPass = lowPass;
+        const int length = juce::jmin(blockSize, numSamples - start);
+        subBlock.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+        processChunk(subBlock, params, sends, numSends, start);
     }
-    if (highPass != previousHighPass)
+}
+
+/**
+ * @brief Processes a buffer while ramping parameters from start to end.
+ *
+ * Splits the buffer into microBlockSize sub-blocks (controlBlockSize unless
+ * set through ReverbOptions, at most blockSize). Sub-block k uses the
+ * values interpolated at its last sample, so the final sub-block lands
+ * exactly on `end`. Within each sub-block, mix, width and gain are further
+ * smoothed per sample by the output stage.
+ *
+ * @param buffer Audio buffer to process in-place.
+ * @param start Parameter values at the start of the buffer.
+ * @param end Parameter values at the end of the buffer.
+ * @param sends Optional extra inputs summed into the shared tail.
+ * @param numSends Number of entries in sends.
+ */
+void Reverb::processRamp(juce::AudioBuffer<float>& buffer,
+    const ReverbParameters& start,
+    const ReverbParameters& end,
+    const ReverbSend* sends,
+    int numSends)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= 0)
+        return;
+
+    const int step = microBlockSize;
+
+    for (int offset = 0; offset < numSamples; offset += step)
     {
-        auto coeffs = juce::IIRCoefficients::makeHighPass(fs, highPass);
-        for (int ch = 0; ch < numChannels; ++ch)
-            highPassFilters[ch].setCoefficients(coeffs);
-        previousHighPass = highPass;
+        const int length = juce::jmin(step, numSamples - offset);
+        const float t = static_cast<float>(offset + length) / static_cast<float>(numSamples);
+
+        subBlock.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), offset, length);
+        processChunk(subBlock, ReverbParameters::interpolate(start, end, t), sends, numSends, offset);
     }
+}
+
+/**
+ * @brief Processes a buffer while gliding from the running values to target.
+ *
+ * A target different from the last one restarts the ramp from the values
+ * of the last sub-block, wherever the previous ramp was, so changes take
+ * effect in the callback that brings them and interrupted ramps never
+ * jump. Each sub-block advances the ramp by its length and runs with the
+ * values at its end, like processRamp(); once the ramp is complete the
+ * sub-blocks run with the target itself.
+ *
+ * @param buffer Audio buffer to process in-place.
+ * @param target Values to reach.
+ * @param sends Optional extra inputs summed into the shared tail.
+ * @param numSends Number of entries in sends.
+ */
+void Reverb::processSmoothed(juce::AudioBuffer<float>& buffer,
+    const ReverbParameters& target,
+    const ReverbSend* sends,
+    int numSends)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= 0)
+        return;
 
+    if (!rampStarted)
+    {
+        rampFrom = rampTo = rampValues = target;
+        rampPosition = rampLength;
+        rampStarted = true;
+    }
+    else if (target != rampTo)
+    {
+        rampFrom = rampValues;
+        rampTo = target;
+        rampPosition = 0;
+    }
 
-    // Store dry copy
-    juce::AudioBuffer<float> dry;
-    dry.makeCopyOf(buffer);
+    const int step = microBlockSize;
 
-    // Apply filters with proper channel isolation
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int offset = 0; offset < numSamples; offset += step)
     {
-        float* channelData = buffer.getWritePointer(ch);
+        const int length = juce::jmin(step, numSamples - offset);
+        if (rampPosition < rampLength)
+        {
+            rampPosition = juce::jmin(rampLength, rampPosition + length);
+            rampValues = rampPosition == rampLength ? rampTo
+                : ReverbParameters::interpolate(rampFrom, rampTo,
+                    static_cast<float>(rampPosition) / static_cast<float>(rampLength));
+        }
+
+        subBlock.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), offset, length);
+        processChunk(subBlock, rampValues, sends, numSends, offset);
+    }
+}
+
+/**
+ * @brief Processes a buffer with precomputed values per sub-block.
+ *
+ * Same sub-block grid as processRamp(): sub-block k covers samples
+ * [k * microBlockSize, (k + 1) * microBlockSize) and runs with points[k].
+ *
+ * @param buffer Audio buffer to process in-place.
+ * @param points Parameter values per sub-block.
+ * @param numPoints Number of entries in points.
+ * @param sends Optional extra inputs summed into the shared tail.
+ * @param numSends Number of entries in sends.
+ * @throws std::invalid_argument if numPoints does not cover the buffer.
+ */
+void Reverb::processAutomation(juce::AudioBuffer<float>& buffer,
+    const ReverbParameters* points,
+    int numPoints,
+    const ReverbSend* sends,
+    int numSends)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= 0)
+        return;
 
-        // Apply high-pass first, then low-pass
-        highPassFilters[ch].processSamples(channelData, numSamples);
-        lowPassFilters[ch].processSamples(channelData, numSamples);
+    const int step = microBlockSize;
+    if (points == nullptr || numPoints < (numSamples + step - 1) / step)
+        throw std::invalid_argument("Automation needs one parameter set per sub-block.");
+
+    for (int offset = 0, k = 0; offset < numSamples; offset += step, ++k)
+    {
+        const int length = juce::jmin(step, numSamples - offset);
+        subBlock.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), offset, length);
+        processChunk(subBlock, points[k], sends, numSends, offset);
     }
+}
+
+/**
+ * @brief Runs the full reverb chain on at most blockSize samples.
+ *
+ * Steps:
+ * 1. Fused input stage: high-pass, low-pass, pre-delay and upmix into the
+ *    8-channel wet buffer in one blocked kernel. The caller's buffer is left
+ *    untouched and serves as the dry signal.
+ *    In Eco mode the input stage only fills its rings and the early
+ *    reflections tap them instead (replacing the first diffuser).
+ * 2. Each send runs its own input stage and is added at its send level,
+ *    ramped per sample while the level changes. Muted and disabled sends
+ *    keep filling their rings (disabled ones with silence).
+ * 3. Apply the diffuser and FDN stages (once for all inputs). In frozen
+ *    mode, once the grid is ready, the frozen tail convolves wet lanes 0
+ *    and 1 instead; its first block crossfades from the live tail.
+ * 4. Fused output stage: stereo width (Mid/Side), dry/wet mix and output gain
+ *    in one pass back into the caller's buffer (dry = main input only).
+ *
+ * @param buffer Audio buffer to process.
+ * @param params Parameter values for this block.
+ * @param sends Extra inputs (full-length buffers).
+ * @param numSends Number of extra inputs.
+ * @param offset Position of this chunk within the send buffers.
+ */
+void Reverb::processChunk(juce::AudioBuffer<float>& buffer, const ReverbParameters& params,
+    const ReverbSend* sends, int numSends, int offset)
+{
+    const int numSamples = buffer.getNumSamples();
 
+    // Fused input conditioning straight into the 8-channel wet buffer
+    work.setSize(8, numSamples, false, false, true);
+    input.setCutoffs(params.lowPass, params.highPass, coefficients);
 
-    // Apply pre-delay
-    for (int ch = 0; ch < numChannels; ++ch)
+    const int preDelay = static_cast<int>(params.initialDelay * fs);
+    if (useEarlyReflections)
     {
-        float* bufferPtr = buffer.getWritePointer(ch);
-        for (int i = 0; i < numSamples; ++i)
+        early.setRoomSize(params.roomSize);
+        input.push(buffer);
+        early.process(input, preDelay, work, 1.0f, false);
+    }
+    else
+    {
+        input.process(buffer, work, preDelay);
+    }
+
+    // Extra inputs: own early stage each, summed into the shared tail. A
+    // disabled send is fed silence and a muted one still fills its rings,
+    // so neither comes back with stale audio or filter state
+    const int activeSends = juce::jmin(numSends, static_cast<int>(sendInputs.size()));
+    for (int i = 0; i < activeSends; ++i)
+    {
+        const ReverbSend& send = sends[i];
+        const bool enabled = send.buffer != nullptr && send.buffer->getNumChannels() > 0;
+        const float target = enabled ? send.level : 0.0f;
+        auto& level = sendLevels[static_cast<size_t>(i)];
+        if (sendsPrimed)
+            level.setTargetValue(target);
+        else
+            level.setCurrentAndTargetValue(target);
+
+        auto& source = enabled ? *send.buffer : sendSilence;
+        sendBlock.setDataToReferTo(source.getArrayOfWritePointers(),
+            source.getNumChannels(), enabled ? offset : 0, numSamples);
+        sendInputs[i].setCutoffs(params.lowPass, params.highPass, coefficients);
+
+        const int sendDelay = static_cast<int>(send.preDelay * fs);
+        if (!level.isSmoothing())
         {
-            float inSample = bufferPtr[i];
-            bufferPtr[i] = z[ch].readSample(static_cast<int>(initialDelay * fs));
-            z[ch].writeSample(inSample);
+            const float gain = level.getTargetValue();
+            if (gain == 0.0f)
+            {
+                sendInputs[i].push(sendBlock);
+            }
+            else if (useEarlyReflections)
+            {
+                sendInputs[i].push(sendBlock);
+                early.process(sendInputs[i], sendDelay, work, gain, true);
+            }
+            else
+            {
+                sendInputs[i].processAdd(sendBlock, work, sendDelay, gain);
+            }
+            continue;
         }
-    }
 
-    // Upscale to 8 channels 
-    buffer.setSize(8, numSamples, true, true, true);
-    const float* lastChannelData = buffer.getReadPointer(numChannels - 1);
-    for (int ch = numChannels; ch < 8; ++ch)
-        buffer.copyFrom(ch, 0, lastChannelData, numSamples);
-
-    // Apply reverb chain
-    d1.process(buffer);
-    fdn1.process(buffer, dampening, fs, roomSize);
-    d2.process(buffer);
-    fdn2.process(buffer, dampening, fs, roomSize);
-    d3.process(buffer);
-
-    // Stereo width adjustment (Mid/Side)
-    if (numChannels == 2)
-    {
-        float* left = buffer.getWritePointer(0);
-        float* right = buffer.getWritePointer(1);
-        for (int i = 0; i < numSamples; ++i)
+        // Per-sample level while the smoother glides
+        for (int n = 0; n < numSamples; ++n)
+            sendGains[static_cast<size_t>(n)] = level.getNextValue();
+
+        if (useEarlyReflections)
         {
-            float mid = 0.5f * (left[i] + right[i]);
-            float side = 0.5f * (left[i] - right[i]) * stereoWidth;
-            left[i] = mid + side;
-            right[i] = mid - side;
+            sendInputs[i].push(sendBlock);
+            sendWork.setSize(8, numSamples, false, false, true);
+            early.process(sendInputs[i], sendDelay, sendWork, 1.0f, false);
+            for (int ch = 0; ch < work.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::addWithMultiply(work.getWritePointer(ch),
+                    sendWork.getReadPointer(ch), sendGains.data(), numSamples);
+        }
+        else
+        {
+            sendInputs[i].processAdd(sendBlock, work, sendDelay, sendGains.data());
         }
     }
+    sendsPrimed = true;
 
-    // Inline wet reference
-    auto& wet = buffer;
+    // Apply reverb chain; the frozen tail records its input from the start
+    bool convolved = false;
+    if (frozen != nullptr)
+    {
+        frozenBlock.setSize(2, numSamples, false, false, true);
+        convolved = frozen->process(work.getReadPointer(0), work.getReadPointer(1),
+            frozenBlock.getWritePointer(0), frozenBlock.getWritePointer(1),
+            numSamples, params.roomSize, params.dampening);
+    }
+
+    if (liveTail)
+        processTail(params.dampening, params.roomSize);
 
-    // Mix dry and wet signals for first 2 channels
-    for (int ch = 0; ch < 2; ++ch)
+    if (convolved)
     {
-        for (int i = 0; i < numSamples; ++i)
-            wet.getWritePointer(ch)[i] = mix * wet.getWritePointer(ch)[i] +
-            (1.0f - mix) * dry.getReadPointer(ch)[i];
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            if (liveTail)
+            {
+                work.applyGainRamp(ch, 0, numSamples, 1.0f, 0.0f);
+                work.addFromWithRamp(ch, 0, frozenBlock.getReadPointer(ch), numSamples, 0.0f, 1.0f);
+            }
+            else
+            {
+                work.copyFrom(ch, 0, frozenBlock, ch, 0, numSamples);
+            }
+        }
+        liveTail = false;
     }
+
+    // Width, mix and gain in one pass; the buffer still holds the dry input
+    output.process(work, buffer, params.mix, params.stereoWidth, params.outputGain);
+}
+
+/**
+ * @brief Runs the diffuser and FDN stages on the wet buffer in place.
+ *
+ * @param dampening FDN damping cutoff (Hz), or the absorption crossover.
+ * @param roomSize FDN delay scaling.
+ */
+void Reverb::processTail(float dampening, float roomSize)
+{
+    if (!useEarlyReflections)
+        d1.process(work);
+    fdn1.process(work, dampening, coefficients, roomSize);
+    d2.process(work);
+    if (!useHighOrderFDN)
+        fdn2.process(work, dampening, coefficients, roomSize);
+    d3.process(work);
 }
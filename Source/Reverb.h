@@ -4,13 +4,112 @@
 #include <JuceHeader.h>
 
 // Project headers
+#include "CoefficientTable.h"
 #include "Diffuser.h"
+#include "EarlyReflections.h"
+#include "EngineMemory.h"
+#include "EngineState.h"
 #include "FDN.h"
+#include "FrozenTail.h"
+#include "InputConditioner.h"
+#include "OutputStage.h"
 
 // Standard library
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+/**
+ * @struct ReverbOptions
+ * @brief Construction-time engine choices for Reverb.
+ *
+ * Allows trading quality for CPU per stage, e.g. DVN for d1 and allpass
+ * diffusion for d2/d3 when CPU is tight.
+ */
+struct ReverbOptions
+{
+    Diffuser::Engine d1Engine = Diffuser::Engine::DVN; ///< Engine for the first diffuser
+    Diffuser::Engine d2Engine = Diffuser::Engine::DVN; ///< Engine for the second diffuser
+    Diffuser::Engine d3Engine = Diffuser::Engine::DVN; ///< Engine for the third diffuser
+
+    DelayLine::Storage fdnStorage = DelayLine::Storage::Float32; ///< FDN delay line sample format
+    FeedbackMatrixType feedbackMatrix = FeedbackMatrixType::Hadamard; ///< Mixing matrix of every FDN (see FeedbackMatrix.h)
+
+    int numSends = 0; ///< Extra inputs feeding the shared tail (each with its own early stage)
+
+    bool earlyReflections = false; ///< Eco: multi-tap early reflections replace the first diffuser
+
+    bool highOrderFDN = false; ///< One 16-line FDN with per-line absorption filters replaces fdn1 + fdn2
+    float decayLow = 6.0f;     ///< highOrderFDN: T60 (seconds) below the dampening frequency, at roomSize 1
+    float decayHigh = 2.0f;    ///< highOrderFDN: T60 (seconds) above the dampening frequency, at roomSize 1
+
+    bool frozen = false;          ///< Convolve with a pre-rendered IR grid instead of the live tail
+    FrozenTail::Grid frozenGrid;  ///< Grid rendered in the background when frozen is set
+
+    uint32_t seed = 0; ///< Topology seed for all diffusers and FDNs (0 = new random topology)
+
+    bool lockMemory = false; ///< Pin the engine memory with mlock within the current limit (off in the plugin; falls back to prefaulting only)
+
+    int microBlockSize = 0;  ///< processRamp() sub-block length (0 = Reverb::controlBlockSize)
+    int diffuserThreads = 0; ///< OpenMP threads per DVN diffuser on blocks of Diffuser::minParallelSamples or more (0 = OpenMP default, 1 = serial)
+
+    /**
+     * Bit-reproducible output: the same seed, input and parameters give the
+     * same bits with any diffuserThreads and on every machine running the
+     * same build (same compiler, flags and instruction set). Requires a
+     * non-zero seed, ignores microBlockSize (so ramps land on the same
+     * samples whatever the caller configured) and, in frozen mode, waits for the IR grid at construction
+     * so the convolved tail takes over at the first block.
+     */
+    bool deterministic = false;
+};
+
+/**
+ * @struct ReverbSend
+ * @brief One extra input mixed into the shared diffuser/FDN tail.
+ *
+ * A send with no buffer (or no channels) is fed silence at level 0, so its
+ * filters and pre-delay ring keep running and it comes back without stale
+ * audio. Level changes glide over Reverb::smoothingSeconds.
+ */
+struct ReverbSend
+{
+    juce::AudioBuffer<float>* buffer = nullptr; ///< Input audio (same length as the main buffer), or nullptr if disabled
+    float level = 1.0f;                         ///< Linear send level (smoothed)
+    float preDelay = 0.0f;                      ///< Pre-delay (seconds) for this input
+};
+
+/**
+ * @struct ReverbParameters
+ * @brief One set of user parameter values for Reverb::process.
+ */
+struct ReverbParameters
+{
+    float mix = 1.0f;            ///< Dry/wet mix (0.0 = dry, 1.0 = fully wet)
+    float stereoWidth = 1.0f;    ///< Stereo width factor
+    float lowPass = 20000.0f;    ///< Low-pass cutoff (Hz)
+    float highPass = 20.0f;      ///< High-pass cutoff (Hz)
+    float dampening = 8000.0f;   ///< FDN damping cutoff (Hz)
+    float roomSize = 1.0f;       ///< FDN delay scaling
+    float initialDelay = 0.0f;   ///< Pre-delay (seconds)
+    float outputGain = 1.0f;     ///< Linear output gain
+
+    /**
+     * @brief Linear interpolation between two parameter sets.
+     * @param a Values at t = 0.
+     * @param b Values at t = 1.
+     * @param t Interpolation position in [0, 1].
+     */
+    static ReverbParameters interpolate(const ReverbParameters& a, const ReverbParameters& b, float t);
+
+    /** @brief True if every value is equal. */
+    bool operator==(const ReverbParameters& other) const;
+
+    /** @brief True if any value differs. */
+    bool operator!=(const ReverbParameters& other) const { return !(*this == other); }
+};
+
 /**
  * @class Reverb
  * @brief Implements a multi-stage reverb with diffusers, FDNs, and filtering.
@@ -21,18 +120,53 @@
  *
  * The processing chain is roughly:
  * initial delay -> diffuser1 -> FDN1 -> diffuser2 -> FDN2 -> diffuser3 -> stereo width -> dry/wet mix
+ *
+ * Extra inputs (sends) each get their own cheap input stage (filters and
+ * pre-delay) and are summed into the same 8-channel tail, so the late
+ * reverb is computed once for all of them.
+ *
+ * With ReverbOptions::earlyReflections the first diffuser is replaced by a
+ * multi-tap early-reflection stage reading the pre-delay rings directly.
+ *
+ * With ReverbOptions::highOrderFDN the two 8-line FDNs are replaced by one
+ * 16-line FDN with shorter prime delays and Jot absorption filters, so the
+ * late decay follows decayLow / decayHigh (split at the dampening
+ * frequency) on every line, with roughly half the delay memory.
+ *
+ * With ReverbOptions::frozen the diffuser/FDN tail is rendered to impulse
+ * responses over a roomSize x dampening grid on a background thread and
+ * then replaced by FrozenTail, which interpolates between grid points as
+ * the parameters move. The live tail runs until the grid is ready.
+ *
+ * The complete processing state can be saved and restored as one flat
+ * snapshot (saveState() / restoreState()), so long offline renders can be
+ * checkpointed, resumed, or continued on another machine.
+ *
+ * Filter coefficients for the input filters and the FDN damping are looked
+ * up in a CoefficientTable designed when the Reverb is built, so the
+ * cutoffs can be modulated every sub-block without transcendental math.
+ *
+ * All engine memory is prefaulted when the Reverb is built, so the audio
+ * thread does not take page faults on first use; with
+ * ReverbOptions::lockMemory it is also pinned against swapping.
  */
 class Reverb
 {
 public:
+    static constexpr int controlBlockSize = 32; ///< Sub-block length for automation ramps
+    static constexpr double smoothingSeconds = 0.02; ///< processSmoothed() and send level ramp length
+
     /**
      * @brief Constructs the Reverb with a given sample rate and block size.
      * @param fs Sample rate in Hz.
      * @param blockSize Maximum block size for internal buffers.
+     * @param options Engine selection per stage.
      *
      * Initializes initial delay lines, diffusers, FDNs, and filters.
+     * @throws std::invalid_argument if frozen and earlyReflections are both set,
+     *         deterministic is set without a seed, or a decay time is negative.
      */
-    Reverb(float fs, int blockSize);
+    Reverb(float fs, int blockSize, const ReverbOptions& options = {});
 
     /** @brief Default constructor (produces uninitialized Reverb). */
     Reverb() = default;
@@ -48,6 +182,113 @@ public:
     Reverb(Reverb&&) noexcept = default;
     Reverb& operator=(Reverb&&) noexcept = default;
 
+    /**
+     * @brief Returns the topology seed in use.
+     *
+     * Equal to ReverbOptions::seed, or the randomly drawn seed if that was 0;
+     * constructing another Reverb with this seed reproduces the same topology.
+     */
+    uint32_t getSeed() const { return seed; }
+
+    /**
+     * @brief Derives the seed of one stage from a topology seed.
+     * @param seed Topology seed.
+     * @param stage Stage index: 1-3 = diffusers d1-d3, 4-5 = fdn1-fdn2.
+     * @return Seed passed to that stage's constructor.
+     */
+    static uint32_t stageSeed(uint32_t seed, uint32_t stage);
+
+    /** @brief Size, prefaulted pages and pinned bytes of the engine memory. */
+    const EngineMemory::Stats& getMemoryStats() const { return memoryStats; }
+
+    /**
+     * @brief Clears all processing state, as if the engine had only seen silence.
+     *
+     * Allocates nothing, so an engine (with its prefaulted or pinned memory)
+     * can be reused for another offline job instead of being rebuilt. The
+     * topology is kept: processing after reset() matches a new Reverb with the
+     * same seed. A rendered frozen grid is kept as well.
+     */
+    void reset();
+
+    /**
+     * @brief Gathers metering statistics in the output mixing pass.
+     * @param levels Target the output stage adds every processed block to
+     *        (nullptr = off). Not owned; the caller reads and clears it.
+     */
+    void setLevels(OutputStage::Levels* levels) { output.setLevels(levels); }
+
+    /**
+     * @brief Reports every heap region the processing chain owns.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports every region holding processing state (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+    /** @brief Size in bytes of a state snapshot of this engine. */
+    size_t getStateSize();
+
+    /**
+     * @brief Writes a snapshot of the complete processing state (no allocation).
+     * @param destination Receives the snapshot.
+     * @param size Capacity of destination (at least getStateSize()).
+     * @return Bytes written.
+     * @throws std::invalid_argument if size is smaller than getStateSize().
+     *
+     * Not thread-safe with process(): call it between blocks on the
+     * processing thread.
+     */
+    size_t saveState(void* destination, size_t size);
+
+    /**
+     * @brief Writes a snapshot of the complete processing state into a new block.
+     * @return Snapshot of getStateSize() bytes.
+     */
+    juce::MemoryBlock saveState();
+
+    /**
+     * @brief Continues from a snapshot taken with saveState().
+     * @param data Snapshot.
+     * @param size Size of the snapshot in bytes.
+     * @throws std::invalid_argument if the snapshot comes from an engine with
+     *         another seed, sample rate or options (the state is then unchanged).
+     *
+     * Processing after restoreState() gives the same output as the saved
+     * engine would have from that point on, provided both were built with
+     * the same seed and options. If the saved engine was running the frozen
+     * tail, the grid is awaited first; a snapshot taken while the grid was
+     * still rendering only continues exactly in deterministic mode, where
+     * the grid is always ready.
+     */
+    void restoreState(const void* data, size_t size);
+
+    /**
+     * @brief Waits for the frozen IR grid to be rendered.
+     * @param timeoutMs Maximum wait in milliseconds (-1 = no limit, 0 = poll).
+     * @return True if the tail is convolved from now on (or frozen mode is off).
+     */
+    bool waitForFrozenGrid(int timeoutMs = -1);
+
+    /**
+     * @brief Renders the responses of the diffuser/FDN tail for FrozenTail.
+     * @param fs Sample rate in Hz.
+     * @param blockSize Block size of the rendering chain.
+     * @param options Engine options (seed must be non-zero to match another instance).
+     * @param roomSize Room size for the FDNs.
+     * @param dampening Dampening cutoff (Hz) for the FDNs.
+     * @param ir 4-channel buffer, its length is the response length. Channel
+     *        2 * i + o receives wet channel o for the excitation 1 - z^-2 on wet
+     *        lane 0 (i = 0) or lanes 1-7 (i = 1).
+     * @return False if the calling thread was asked to exit first.
+     */
+    static bool renderTailResponses(float fs, int blockSize, const ReverbOptions& options,
+        float roomSize, float dampening, juce::AudioBuffer<float>& ir);
+
     /**
      * @brief Processes an audio buffer in-place with the reverb chain.
      * @param buffer Audio buffer to process (numChannels x numSamples).
@@ -58,9 +299,11 @@ public:
      * @param dampening FDN damping coefficient (controls tail absorption).
      * @param roomSize Scales delay indices for perceived room size.
      * @param initialDelay Initial pre-delay time (seconds) applied before reverb.
+     * @param outputGain Linear gain applied to the mixed output.
      *
      * The function updates the buffer in-place, including filtering, initial delay,
-     * diffusers, FDNs, stereo width adjustment, and dry/wet mixing.
+     * diffusers, FDNs, stereo width adjustment, and dry/wet mixing. Mix, width and
+     * output gain are smoothed; at mix == 1 the dry signal is not touched.
      */
     void process(juce::AudioBuffer<float>& buffer,
         float mix,
@@ -69,19 +312,142 @@ public:
         float highPass,
         float dampening,
         float roomSize,
-        float initialDelay);
+        float initialDelay,
+        float outputGain = 1.0f);
+
+    /**
+     * @brief Processes an audio buffer with one parameter set.
+     * @param buffer Audio buffer to process in-place (any length).
+     * @param params Parameter values for the whole buffer.
+     * @param sends Optional extra inputs summed into the shared tail.
+     * @param numSends Number of entries in sends (at most ReverbOptions::numSends).
+     */
+    void process(juce::AudioBuffer<float>& buffer, const ReverbParameters& params,
+        const ReverbSend* sends = nullptr, int numSends = 0);
+
+    /**
+     * @brief Processes an audio buffer while ramping parameters across it.
+     * @param buffer Audio buffer to process in-place (any length).
+     * @param start Parameter values at the start of the buffer.
+     * @param end Parameter values at the end of the buffer.
+     * @param sends Optional extra inputs summed into the shared tail.
+     * @param numSends Number of entries in sends (at most ReverbOptions::numSends).
+     *
+     * The buffer is split into sub-blocks of controlBlockSize samples (or
+     * ReverbOptions::microBlockSize); each sub-block runs with the linearly
+     * interpolated values at its end, so automation resolution no longer
+     * depends on the host buffer size.
+     */
+    void processRamp(juce::AudioBuffer<float>& buffer,
+        const ReverbParameters& start,
+        const ReverbParameters& end,
+        const ReverbSend* sends = nullptr,
+        int numSends = 0);
+
+    /**
+     * @brief Processes an audio buffer while gliding towards new parameter values.
+     * @param buffer Audio buffer to process in-place (any length).
+     * @param target Values to reach.
+     * @param sends Optional extra inputs summed into the shared tail.
+     * @param numSends Number of entries in sends (at most ReverbOptions::numSends).
+     *
+     * For realtime hosts that only know the current values. The engine
+     * keeps the values it is running with; a new target starts a linear
+     * ramp of smoothingSeconds from those values, advanced per sub-block
+     * as in processRamp(). A change therefore starts moving in the first
+     * sub-block of the callback that brings it, and the glide time does not
+     * depend on the host buffer size. The first call after construction or
+     * reset() starts at target.
+     */
+    void processSmoothed(juce::AudioBuffer<float>& buffer,
+        const ReverbParameters& target,
+        const ReverbSend* sends = nullptr,
+        int numSends = 0);
+
+    /**
+     * @brief Processes an audio buffer with one parameter set per control block.
+     * @param buffer Audio buffer to process in-place (any length).
+     * @param points Values for each consecutive sub-block of getMicroBlockSize()
+     *        samples (the last one may be shorter), e.g. evaluated automation.
+     * @param numPoints Number of entries in points.
+     * @param sends Optional extra inputs summed into the shared tail.
+     * @param numSends Number of entries in sends (at most ReverbOptions::numSends).
+     * @throws std::invalid_argument if numPoints does not cover the buffer.
+     *
+     * Runs the same sub-blocks as processRamp(), with the values taken from
+     * points instead of a straight line, so any automation curve reaches the
+     * filters, the FDN coefficients and the output smoothers at control rate.
+     */
+    void processAutomation(juce::AudioBuffer<float>& buffer,
+        const ReverbParameters* points,
+        int numPoints,
+        const ReverbSend* sends = nullptr,
+        int numSends = 0);
+
+    /** @brief Sub-block length of processRamp() and processAutomation() in samples. */
+    int getMicroBlockSize() const { return microBlockSize; }
 
 private:
+    /**
+     * @brief Runs the chain on at most blockSize samples.
+     * @param buffer Audio buffer (or sub-block view) to process in-place.
+     * @param params Parameter values for this block.
+     * @param sends Extra inputs (full-length buffers).
+     * @param numSends Number of extra inputs.
+     * @param offset Position of this chunk within the send buffers.
+     */
+    void processChunk(juce::AudioBuffer<float>& buffer, const ReverbParameters& params,
+        const ReverbSend* sends, int numSends, int offset);
+
+    /**
+     * @brief Runs the diffuser and FDN stages on the wet buffer.
+     * @param dampening FDN damping cutoff (Hz).
+     * @param roomSize FDN delay scaling.
+     */
+    void processTail(float dampening, float roomSize);
+
+    /**
+     * @brief Prefaults (and optionally pins) every region from visitMemory().
+     * @param lock Pin the regions as well.
+     */
+    void prepareMemory(bool lock);
+
     float fs = 0.0f;          ///< Sample rate in Hz.
     int blockSize = 0;         ///< Maximum processing block size.
+    int microBlockSize = controlBlockSize; ///< processRamp() sub-block length (<= blockSize)
+
+    // --- processSmoothed() ramp ---
+    ReverbParameters rampFrom;    ///< Values the current ramp started at
+    ReverbParameters rampTo;      ///< Values the current ramp ends at (the last target)
+    ReverbParameters rampValues;  ///< Values of the last processed sub-block
+    int rampLength = 1;           ///< Ramp length in samples (smoothingSeconds)
+    int rampPosition = 0;         ///< Samples of the current ramp already processed
+    bool rampStarted = false;     ///< False until the first processSmoothed() call (or after reset())
+    uint32_t seed = 0;         ///< Resolved topology seed (declared before the DSP members it seeds)
+    CoefficientTable coefficients; ///< Input filter and FDN damping designs for fs (looked up per sub-block)
 
     // --- DSP members ---
-    std::vector<DelayLine> z;  ///< Initial delay lines (pre-delays for each channel)
-    Diffuser d1, d2, d3;       ///< Diffuser stages (DVN-based diffusion)
-    FDN fdn1, fdn2;            ///< Feedback delay networks for late reverb
-
-    std::vector<juce::IIRFilter> lowPassFilters;   ///< Per-channel low-pass filters (simulate HF absorption)
-    std::vector<juce::IIRFilter> highPassFilters;  ///< Per-channel high-pass filters (remove subsonic rumble)
-    float previousLowPass = 0.0f;   ///< Last applied low-pass cutoff
-    float previousHighPass = 0.0f;  ///< Last applied high-pass cutoff
+    InputConditioner input;    ///< Fused HP/LP filtering, pre-delay and 8-channel upmix
+    std::vector<InputConditioner> sendInputs; ///< Per-send early stage (own filters state and pre-delay)
+    std::vector<juce::SmoothedValue<float>> sendLevels; ///< Per-send level smoothers
+    bool sendsPrimed = false;  ///< False until the first block (or after reset()); the first levels are not ramped
+    Diffuser d1, d2, d3;       ///< Diffuser stages (DVN or allpass diffusion)
+    EarlyReflections early;    ///< Multi-tap early reflections (replaces d1 when enabled)
+    bool useEarlyReflections = false; ///< True if early replaces d1
+    FDN fdn1, fdn2;            ///< Feedback delay networks for late reverb (fdn1 alone in high-order mode)
+    bool useHighOrderFDN = false; ///< True if fdn1 is the 16-line absorption FDN and fdn2 is unused
+    OutputStage output;        ///< Fused stereo width, dry/wet mix and output gain
+    std::unique_ptr<FrozenTail> frozen; ///< IR grid convolution replacing the tail (frozen mode only)
+    bool liveTail = true;      ///< False once the frozen tail has taken over
+
+    juce::AudioBuffer<float> work; ///< 8-channel wet buffer (preallocated to blockSize)
+    juce::AudioBuffer<float> subBlock; ///< Non-owning view into the caller's buffer
+    juce::AudioBuffer<float> sendBlock; ///< Non-owning view into a send buffer
+    juce::AudioBuffer<float> sendSilence; ///< Zeros fed to disabled sends (2 channels, preallocated)
+    juce::AudioBuffer<float> sendWork; ///< Early reflections of a ramping send (8 channels, Eco mode with sends only)
+    std::vector<float> sendGains; ///< Per-sample send level while it ramps
+    juce::AudioBuffer<float> frozenBlock; ///< Frozen tail output (2 channels, preallocated)
+
+    EngineMemory::Stats memoryStats; ///< Outcome of prepareMemory()
+    EngineMemory::Lock memoryLock;   ///< Pinned regions (declared last, released before the memory is freed)
 };
@@ -0,0 +1,268 @@
+#include "SharedDVNConvolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Constructs the shared pulse grid.
+ *
+ * Positions and widths follow DVNConvolver: one pulse per grid segment of
+ * Td = fs / p samples, width in [Td / 2, Td], position random within the
+ * segment. Signs are drawn per pulse for every lane.
+ *
+ * @param N Number of audio channels.
+ * @param M Number of pulses.
+ * @param p Pulses per second (controls temporal density).
+ * @param maxBlockSize Maximum audio block size.
+ * @param fs Sample rate in Hz (used for the pulse timing grid).
+ * @param seed Seed for the pulse grid and signs.
+ * @throws std::invalid_argument if N < 1, M < 1 or p < 1.
+ */
+SharedDVNConvolver::SharedDVNConvolver(int N, int M, int p, int maxBlockSize, double fs, uint32_t seed)
+    : N(N), M(M), maxBlockSize(maxBlockSize)
+{
+    if (N < 1)
+        throw std::invalid_argument("Number of channels must be at least 1.");
+    if (M < 1 || p < 1)
+        throw std::invalid_argument("Pulse count and density must be at least 1.");
+
+    numLanes = ((N + lanes - 1) / lanes) * lanes;
+
+    const int Td = static_cast<int>(fs / static_cast<double>(p));
+    const int wmin = Td / 2;
+    const int wmax = Td;
+    const double epsilon = 1.0 / 4096.0;
+
+    feedback = static_cast<float>(1.0 - epsilon);
+    normalization = 1.0f / std::pow(float(M * (wmax - wmin + 1)), 19.0f / 30.0f);
+
+    k.resize(M);
+    signs.resize(static_cast<size_t>(M) * numLanes);
+    std::vector<std::vector<int>> byWidth(wmax - wmin + 1);
+
+    juce::Random rng(static_cast<juce::int64>(seed));
+    for (int m = 0; m < M; ++m)
+    {
+        const int width = static_cast<int>(std::round(rng.nextFloat() * (wmax - wmin) + wmin));
+        k[m] = static_cast<int>(std::round(m * Td + rng.nextFloat() * (Td - width)));
+        byWidth[width - wmin].push_back(m);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            signs[static_cast<size_t>(m) * numLanes + lane] = rng.nextBool() ? 1.0f : -1.0f;
+    }
+
+    for (int w = 0; w <= wmax - wmin; ++w)
+    {
+        if (byWidth[w].empty())
+            continue;
+
+        WidthGroup g;
+        g.width = wmin + w;
+        g.feedforward = static_cast<float>(std::pow(1.0 - epsilon, static_cast<double>(g.width)));
+        g.pulses = std::move(byWidth[w]);
+        g.history = makeRing(g.width + 1);
+        groups.push_back(std::move(g));
+    }
+
+    input = makeRing(*std::max_element(k.begin(), k.end()));
+
+    // The group sum is computed in whole tiles, so it may run up to tile - 1
+    // frames past the block
+    const size_t blockFrames = static_cast<size_t>(maxBlockSize) * numLanes;
+    frames.assign(blockFrames, 0.0f);
+    group.assign(blockFrames + static_cast<size_t>(tile) * numLanes, 0.0f);
+    taps.assign(M, nullptr);
+    sum.assign(blockFrames, 0.0f);
+    y1.assign(numLanes, 0.0f);
+    y2.assign(numLanes, 0.0f);
+}
+
+/**
+ * @brief Allocates a mirrored ring for delays up to maxDelay.
+ *
+ * One extra tile of frames lets tiled reads run past the block end.
+ * @param maxDelay Largest delay that will be read from the ring.
+ * @return Zero-initialized ring.
+ */
+SharedDVNConvolver::Ring SharedDVNConvolver::makeRing(int maxDelay) const
+{
+    Ring ring;
+    ring.size = maxDelay + maxBlockSize + tile;
+    ring.data.assign(2 * static_cast<size_t>(ring.size) * numLanes, 0.0f);
+    return ring;
+}
+
+/**
+ * @brief Writes frames into both copies of the ring.
+ */
+void SharedDVNConvolver::writeFrames(Ring& ring, const float* source, int numFrames) const
+{
+    // At most two contiguous runs: up to the end of the ring, then from the start
+    const int first = std::min(numFrames, ring.size - ring.write);
+    const size_t firstCount = static_cast<size_t>(first) * numLanes;
+    const size_t restCount = static_cast<size_t>(numFrames - first) * numLanes;
+    float* data = ring.data.data();
+
+    std::copy(source, source + firstCount, data + static_cast<size_t>(ring.write) * numLanes);
+    std::copy(source, source + firstCount, data + static_cast<size_t>(ring.write + ring.size) * numLanes);
+    std::copy(source + firstCount, source + firstCount + restCount, data);
+    std::copy(source + firstCount, source + firstCount + restCount, data + static_cast<size_t>(ring.size) * numLanes);
+
+    ring.write = (ring.write + numFrames) % ring.size;
+}
+
+/**
+ * @brief Start of the delayed block; the mirror copy keeps it contiguous.
+ */
+const float* SharedDVNConvolver::readFrames(const Ring& ring, int delay, int numFrames) const
+{
+    int read = ring.write - delay - numFrames;
+    if (read < 0)
+        read += ring.size;
+    return ring.data.data() + static_cast<size_t>(read) * numLanes;
+}
+
+/**
+ * @brief Processes one block for all channels.
+ *
+ * Steps:
+ * 1. Interleave the channels into frames and append them to the input ring.
+ * 2. Per width group: sum its pulse taps (one planar read and one lane-wide
+ *    multiply-add per pulse, tile frames at a time with the sums held in
+ *    registers), append the sum to the group history and add
+ *    sum - (1-e)^W * sum[n - W - 1] to the feedforward total.
+ * 3. Run the shared recursion y[n] = total[n] + (1-e) y[n-2] per lane.
+ * 4. Normalize and deinterleave back into the channels.
+ *
+ * @param buffer Audio buffer with at least N channels and at most maxBlockSize samples.
+ */
+void SharedDVNConvolver::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    float* const* channels = buffer.getArrayOfWritePointers();
+
+    // Step 1: interleave and store
+    for (int n = 0; n < numSamples; ++n)
+        for (int lane = 0; lane < numLanes; ++lane)
+            frames[static_cast<size_t>(n) * numLanes + lane] = lane < N ? channels[lane][n] : 0.0f;
+    writeFrames(input, frames.data(), numSamples);
+
+    const int count = numSamples * numLanes;
+    std::fill(sum.begin(), sum.begin() + count, 0.0f);
+
+    // Step 2: pulse taps and RRS feedforward per width group
+    for (auto& g : groups)
+    {
+        const int numPulses = static_cast<int>(g.pulses.size());
+        for (int j = 0; j < numPulses; ++j)
+            taps[j] = readFrames(input, k[g.pulses[j]], numSamples);
+
+        // Accumulate tile frames x lanes in registers across all pulses, so
+        // every tap is read once and the group sum is stored once
+        for (int base = 0; base < numLanes; base += lanes)
+        {
+            for (int n = 0; n < numSamples; n += tile)
+            {
+                float acc[tile][lanes] = {};
+                const size_t offset = static_cast<size_t>(n) * numLanes + base;
+
+                for (int j = 0; j < numPulses; ++j)
+                {
+                    const float* tap = taps[j] + offset;
+                    const float* sign = signs.data() + static_cast<size_t>(g.pulses[j]) * numLanes + base;
+
+                    for (int t = 0; t < tile; ++t)
+                        for (int lane = 0; lane < lanes; ++lane)
+                            acc[t][lane] += sign[lane] * tap[static_cast<size_t>(t) * numLanes + lane];
+                }
+
+                for (int t = 0; t < tile; ++t)
+                    for (int lane = 0; lane < lanes; ++lane)
+                        group[offset + static_cast<size_t>(t) * numLanes + lane] = acc[t][lane];
+            }
+        }
+
+        writeFrames(g.history, group.data(), numSamples);
+        const float* delayed = readFrames(g.history, g.width + 1, numSamples);
+
+        for (int i = 0; i < count; ++i)
+            sum[i] += group[i] - g.feedforward * delayed[i];
+    }
+
+    // Step 3: shared recursion
+    for (int i = 0; i < count; i += numLanes)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const float y = sum[i + lane] + feedback * y2[lane];
+            y2[lane] = y1[lane];
+            y1[lane] = y;
+            frames[i + lane] = y * normalization;
+        }
+    }
+
+    // Step 4: deinterleave
+    for (int lane = 0; lane < N; ++lane)
+        for (int n = 0; n < numSamples; ++n)
+            channels[lane][n] = frames[static_cast<size_t>(n) * numLanes + lane];
+}
+
+/**
+ * @brief Zeroes the rings and the per-lane recursion state.
+ */
+void SharedDVNConvolver::reset()
+{
+    std::fill(input.data.begin(), input.data.end(), 0.0f);
+    input.write = 0;
+
+    for (auto& g : groups)
+    {
+        std::fill(g.history.data.begin(), g.history.data.end(), 0.0f);
+        g.history.write = 0;
+    }
+
+    std::fill(y1.begin(), y1.end(), 0.0f);
+    std::fill(y2.begin(), y2.end(), 0.0f);
+}
+
+/**
+ * @brief Reports the pulse tables, every ring and the interleaved scratch.
+ */
+void SharedDVNConvolver::visitMemory(const EngineMemory::Visitor& visit)
+{
+    EngineMemory::visit(visit, k);
+    EngineMemory::visit(visit, signs);
+    EngineMemory::visit(visit, groups);
+
+    for (auto& g : groups)
+    {
+        EngineMemory::visit(visit, g.pulses);
+        EngineMemory::visit(visit, g.history.data);
+    }
+
+    EngineMemory::visit(visit, input.data);
+    EngineMemory::visit(visit, frames);
+    EngineMemory::visit(visit, group);
+    EngineMemory::visit(visit, sum);
+    EngineMemory::visit(visit, y1);
+    EngineMemory::visit(visit, y2);
+    EngineMemory::visit(visit, taps);
+}
+
+/**
+ * @brief Reports the rings with their write positions and y[n - 1], y[n - 2].
+ */
+void SharedDVNConvolver::visitState(const EngineState::Visitor& visit)
+{
+    EngineState::visit(visit, input.data);
+    EngineState::visit(visit, input.write);
+
+    for (auto& g : groups)
+    {
+        EngineState::visit(visit, g.history.data);
+        EngineState::visit(visit, g.history.write);
+    }
+
+    EngineState::visit(visit, y1);
+    EngineState::visit(visit, y2);
+}
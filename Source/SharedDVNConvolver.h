@@ -0,0 +1,140 @@
+#pragma once
+
+// Standard library
+#include <vector>
+#include <cstdint>
+
+// JUCE
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Project headers
+#include "EngineMemory.h"
+#include "EngineState.h"
+
+/**
+ * @class SharedDVNConvolver
+ * @brief Multi-channel dark velvet noise convolver with one pulse grid for all channels.
+ *
+ * Drop-in alternative to the per-channel DVNConvolver set of Diffuser. All
+ * channels share pulse positions and widths; each channel has its own sign
+ * pattern, which is what decides how the pulses sum, so channels stay
+ * decorrelated. With a shared layout the delay memory is interleaved by
+ * channel, and every pulse tap is one planar read feeding all channels with
+ * a single vector multiply-accumulate (8 channels per SIMD group).
+ *
+ * The filtering matches DVNConvolver: each width group is an RRS filter
+ * y[n] = x[n] - (1-e)^W x[n-W-1] + (1-e) y[n-2]. Every group shares the
+ * recursive coefficient (1-e), so the groups only keep their own feedforward
+ * history and one recursion runs on the summed output.
+ */
+class SharedDVNConvolver
+{
+public:
+    static constexpr int lanes = 8; ///< Channels processed together per SIMD group
+    static constexpr int tile = 4;  ///< Frames accumulated in registers per pass
+
+    /**
+     * @brief Constructs the shared pulse grid and per-channel signs.
+     * @param N Number of audio channels.
+     * @param M Number of pulses.
+     * @param p Pulses per second (controls temporal density).
+     * @param maxBlockSize Maximum audio block size.
+     * @param fs Sample rate in Hz (used for the pulse timing grid).
+     * @param seed Seed for the pulse grid and signs.
+     * @throws std::invalid_argument if N < 1, M < 1 or p < 1.
+     */
+    SharedDVNConvolver(int N, int M, int p, int maxBlockSize, double fs, uint32_t seed = 0);
+
+    /** @brief Default constructor (produces an empty, uninitialized convolver). */
+    SharedDVNConvolver() = default;
+
+    /** @brief Destructor. */
+    ~SharedDVNConvolver() = default;
+
+    // Copy operations are deleted to prevent accidental deep copies
+    SharedDVNConvolver(const SharedDVNConvolver&) = delete;
+    SharedDVNConvolver& operator=(const SharedDVNConvolver&) = delete;
+
+    // Move operations are defaulted (safe for internal buffers)
+    SharedDVNConvolver(SharedDVNConvolver&&) noexcept = default;
+    SharedDVNConvolver& operator=(SharedDVNConvolver&&) noexcept = default;
+
+    /**
+     * @brief Processes an audio buffer in-place.
+     * @param buffer Audio buffer with at least N channels and at most maxBlockSize samples.
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Clears the input history, width group histories and recursions (no allocation).
+     */
+    void reset();
+
+    /**
+     * @brief Reports the heap regions owned by this convolver.
+     * @param visit Receives each region (see EngineMemory).
+     */
+    void visitMemory(const EngineMemory::Visitor& visit);
+
+    /**
+     * @brief Reports the input and group histories and the recursion states (see EngineState).
+     * @param visit Receives each region.
+     */
+    void visitState(const EngineState::Visitor& visit);
+
+private:
+    /**
+     * @struct Ring
+     * @brief Mirrored ring of interleaved frames ([position][lane]).
+     *
+     * Frames are stored twice (size apart), so any block of frames up to the
+     * ring size is contiguous in memory.
+     */
+    struct Ring
+    {
+        std::vector<float> data; ///< 2 * size frames of numLanes samples
+        int size = 0;            ///< Frames per copy
+        int write = 0;           ///< Next frame to write
+    };
+
+    /**
+     * @struct WidthGroup
+     * @brief Pulses sharing one width, filtered by one RRS feedforward section.
+     */
+    struct WidthGroup
+    {
+        int width = 0;            ///< Pulse width W (samples)
+        float feedforward = 0.0f; ///< (1 - e)^W
+        std::vector<int> pulses;  ///< Indices into k / signs
+        Ring history;             ///< Summed group input, for x[n - W - 1]
+    };
+
+    /** @brief Allocates a ring holding maxDelay + maxBlockSize + tile frames. */
+    Ring makeRing(int maxDelay) const;
+
+    /** @brief Appends numFrames interleaved frames to a ring. */
+    void writeFrames(Ring& ring, const float* source, int numFrames) const;
+
+    /** @brief Returns numFrames contiguous frames delayed by delay frames. */
+    const float* readFrames(const Ring& ring, int delay, int numFrames) const;
+
+    int N = 0;            ///< Number of channels
+    int numLanes = 0;     ///< N rounded up to a multiple of lanes
+    int M = 0;            ///< Number of pulses
+    int maxBlockSize = 0; ///< Largest block accepted by process()
+
+    float feedback = 0.0f;      ///< Shared RRS recursion coefficient (1 - e)
+    float normalization = 0.0f; ///< Output gain, as in DVNConvolver
+
+    std::vector<int> k;             ///< Shared pulse positions (samples)
+    std::vector<float> signs;       ///< Per-pulse, per-lane signs ([pulse][lane])
+    std::vector<WidthGroup> groups; ///< Non-empty width groups
+
+    Ring input;                ///< Interleaved input history
+    std::vector<float> frames; ///< Interleaved scratch (input, then output)
+    std::vector<float> group;  ///< Interleaved sum of one width group (tile-padded)
+    std::vector<float> sum;    ///< Interleaved feedforward sum of all groups
+    std::vector<float> y1;     ///< Per-lane y[n - 1]
+    std::vector<float> y2;     ///< Per-lane y[n - 2]
+    std::vector<const float*> taps; ///< Tap read pointers of the current group
+};
@@ -0,0 +1,245 @@
+#include "AcousticMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * @brief Runs a JUCE biquad over a double signal in place (direct form I).
+     */
+    void applyBiquad(std::vector<double>& x, const juce::IIRCoefficients& c)
+    {
+        const double b0 = c.coefficients[0], b1 = c.coefficients[1], b2 = c.coefficients[2];
+        const double a1 = c.coefficients[3], a2 = c.coefficients[4];
+
+        double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+        for (double& sample : x)
+        {
+            const double y = b0 * sample + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = sample;
+            y2 = y1;
+            y1 = y;
+            sample = y;
+        }
+    }
+
+    /**
+     * @brief Schroeder integration of a double signal, in dB.
+     */
+    std::vector<double> schroeder(const std::vector<double>& x)
+    {
+        std::vector<double> edc(x.size(), -std::numeric_limits<double>::infinity());
+        double energy = 0.0;
+        for (size_t i = x.size(); i-- > 0;)
+        {
+            energy += x[i] * x[i];
+            edc[i] = energy;
+        }
+
+        const double total = edc.empty() ? 0.0 : edc[0];
+        for (double& e : edc)
+            e = (total > 0.0 && e > 0.0) ? 10.0 * std::log10(e / total)
+                                         : -std::numeric_limits<double>::infinity();
+        return edc;
+    }
+}
+
+/**
+ * @brief Backward-integrated energy, normalized to the total energy.
+ */
+std::vector<double> AcousticMetrics::energyDecayCurve(const float* ir, int length)
+{
+    return schroeder(std::vector<double>(ir, ir + length));
+}
+
+/**
+ * @brief Maximum absolute dB difference over the samples where both curves are above floorDb.
+ */
+double AcousticMetrics::decayCurveDifference(const std::vector<double>& a,
+    const std::vector<double>& b,
+    double floorDb)
+{
+    double worst = 0.0;
+    const size_t length = std::min(a.size(), b.size());
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (a[i] < floorDb || b[i] < floorDb)
+            break;
+        worst = std::max(worst, std::abs(a[i] - b[i]));
+    }
+    return worst;
+}
+
+/**
+ * @brief Least-squares line through the EDC between fromDb and toDb, extrapolated to 60 dB.
+ */
+double AcousticMetrics::decayTime(const std::vector<double>& edc, double fs, double fromDb, double toDb)
+{
+    const auto first = std::find_if(edc.begin(), edc.end(), [fromDb](double e) { return e <= fromDb; });
+    const auto last = std::find_if(first, edc.end(), [toDb](double e) { return e <= toDb; });
+    if (first == edc.end() || last == edc.end() || last - first < 2)
+        return 0.0;
+
+    // Linear regression of level (dB) against time (s)
+    double sumT = 0.0, sumE = 0.0, sumTT = 0.0, sumTE = 0.0;
+    const double count = static_cast<double>(last - first + 1);
+    for (auto it = first; it <= last; ++it)
+    {
+        const double t = static_cast<double>(it - edc.begin()) / fs;
+        sumT += t;
+        sumE += *it;
+        sumTT += t * t;
+        sumTE += t * *it;
+    }
+
+    const double slope = (count * sumTE - sumT * sumE) / (count * sumTT - sumT * sumT);
+    return slope < 0.0 ? -60.0 / slope : 0.0;
+}
+
+/**
+ * @brief Octave-band filtering (two cascaded band-pass biquads, Q = sqrt 2) followed by a T30 fit.
+ *
+ * Bands whose centre is above 0.4 * fs report 0.
+ */
+std::vector<double> AcousticMetrics::octaveBandDecayTimes(const float* ir, int length, double fs,
+    const std::vector<double>& centres)
+{
+    std::vector<double> times;
+    times.reserve(centres.size());
+
+    for (double centre : centres)
+    {
+        if (centre >= 0.4 * fs)
+        {
+            times.push_back(0.0);
+            continue;
+        }
+
+        std::vector<double> band(ir, ir + length);
+        const auto coefficients = juce::IIRCoefficients::makeBandPass(fs, centre, juce::MathConstants<double>::sqrt2);
+        applyBiquad(band, coefficients);
+        applyBiquad(band, coefficients);
+
+        times.push_back(decayTime(schroeder(band), fs));
+    }
+
+    return times;
+}
+
+/**
+ * @brief Abel & Huang normalized echo density.
+ *
+ * For each hop: the Hann-weighted fraction of window samples whose magnitude
+ * exceeds the window's weighted standard deviation, divided by the fraction
+ * expected for Gaussian noise (erfc(1 / sqrt 2)).
+ */
+std::vector<double> AcousticMetrics::echoDensityProfile(const float* ir, int length, double fs,
+    int hop, double window)
+{
+    const int half = juce::jmax(1, static_cast<int>(0.5 * window * fs));
+    const double gaussianFraction = std::erfc(1.0 / std::sqrt(2.0));
+
+    std::vector<double> weights(2 * half + 1);
+    for (int i = 0; i <= 2 * half; ++i)
+        weights[i] = 0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi * (i + 1) / (2 * half + 2));
+
+    std::vector<double> profile;
+    profile.reserve(length / juce::jmax(1, hop) + 1);
+
+    for (int centre = 0; centre < length; centre += juce::jmax(1, hop))
+    {
+        const int start = juce::jmax(0, centre - half);
+        const int end = juce::jmin(length - 1, centre + half);
+
+        double weightSum = 0.0, energy = 0.0;
+        for (int n = start; n <= end; ++n)
+        {
+            const double w = weights[n - centre + half];
+            weightSum += w;
+            energy += w * static_cast<double>(ir[n]) * ir[n];
+        }
+
+        const double sigma = std::sqrt(energy / weightSum);
+        double outside = 0.0;
+        for (int n = start; n <= end; ++n)
+            if (std::abs(static_cast<double>(ir[n])) > sigma)
+                outside += weights[n - centre + half];
+
+        profile.push_back(sigma > 0.0 ? outside / weightSum / gaussianFraction : 0.0);
+    }
+
+    return profile;
+}
+
+/**
+ * @brief First profile point at or above the threshold, converted to seconds.
+ */
+double AcousticMetrics::mixingTime(const std::vector<double>& profile, double fs, int hop, double threshold)
+{
+    for (size_t i = 0; i < profile.size(); ++i)
+        if (profile[i] >= threshold)
+            return static_cast<double>(i) * hop / fs;
+
+    return -1.0;
+}
+
+/**
+ * @brief 1/3-octave band energy comparison of two responses.
+ *
+ * Both responses are zero-padded to the next power of two and transformed
+ * once; band energies are summed bin powers between the band edges.
+ */
+double AcousticMetrics::spectralDifference(const float* a, const float* b, int length, double fs,
+    double& maxDifference)
+{
+    int order = 1;
+    while ((1 << order) < length)
+        ++order;
+    const int size = 1 << order;
+
+    juce::dsp::FFT fft(order);
+    std::vector<float> spectrumA(2 * static_cast<size_t>(size), 0.0f);
+    std::vector<float> spectrumB(2 * static_cast<size_t>(size), 0.0f);
+    std::copy(a, a + length, spectrumA.begin());
+    std::copy(b, b + length, spectrumB.begin());
+    fft.performFrequencyOnlyForwardTransform(spectrumA.data());
+    fft.performFrequencyOnlyForwardTransform(spectrumB.data());
+
+    const double binWidth = fs / size;
+    const double top = std::min(16000.0, 0.45 * fs);
+
+    double sum = 0.0;
+    int bands = 0;
+    maxDifference = 0.0;
+
+    for (int k = -13; ; ++k)
+    {
+        const double centre = 1000.0 * std::pow(2.0, k / 3.0);
+        if (centre < 50.0)
+            continue;
+        if (centre > top)
+            break;
+
+        const int lo = juce::jmax(1, static_cast<int>(centre * std::pow(2.0, -1.0 / 6.0) / binWidth));
+        const int hi = juce::jmin(size / 2, static_cast<int>(centre * std::pow(2.0, 1.0 / 6.0) / binWidth));
+
+        double energyA = 0.0, energyB = 0.0;
+        for (int bin = lo; bin <= hi; ++bin)
+        {
+            energyA += static_cast<double>(spectrumA[bin]) * spectrumA[bin];
+            energyB += static_cast<double>(spectrumB[bin]) * spectrumB[bin];
+        }
+
+        if (energyA <= 0.0 || energyB <= 0.0)
+            continue;
+
+        const double difference = std::abs(10.0 * std::log10(energyA / energyB));
+        sum += difference;
+        maxDifference = std::max(maxDifference, difference);
+        ++bands;
+    }
+
+    return bands > 0 ? sum / bands : 0.0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// Standard library
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+/**
+ * @class AcousticMetrics
+ * @brief Room-acoustic measures of an impulse response.
+ *
+ * Provides the measures the equivalence bench compares:
+ * - Energy decay curve (Schroeder backward integration).
+ * - Reverberation time T60 per octave band (T30 fit, -5 to -35 dB).
+ * - Normalized echo density profile (Abel & Huang) and the mixing time.
+ * - Spectral difference between two responses in 1/3-octave bands.
+ *
+ * All analysis runs in double precision.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class AcousticMetrics
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    AcousticMetrics() = delete;
+
+    /**
+     * @brief Schroeder energy decay curve.
+     * @param ir Impulse response.
+     * @param length Number of samples.
+     * @return EDC in dB, 0 dB at the first sample (-inf where the energy is zero).
+     */
+    static std::vector<double> energyDecayCurve(const float* ir, int length);
+
+    /**
+     * @brief Largest difference between two energy decay curves above a floor.
+     * @param a First EDC (dB).
+     * @param b Second EDC (dB).
+     * @param floorDb Samples where either curve is below this level are ignored.
+     * @return Maximum absolute difference in dB.
+     */
+    static double decayCurveDifference(const std::vector<double>& a,
+        const std::vector<double>& b,
+        double floorDb = -60.0);
+
+    /**
+     * @brief Reverberation time from a linear fit of the EDC.
+     * @param edc Energy decay curve (dB).
+     * @param fs Sample rate in Hz.
+     * @param fromDb Start of the fit range.
+     * @param toDb End of the fit range.
+     * @return Extrapolated 60 dB decay time in seconds, or 0 if the range is not reached.
+     */
+    static double decayTime(const std::vector<double>& edc, double fs,
+        double fromDb = -5.0, double toDb = -35.0);
+
+    /**
+     * @brief T60 per octave band.
+     * @param ir Impulse response.
+     * @param length Number of samples.
+     * @param fs Sample rate in Hz.
+     * @param centres Octave band centre frequencies (Hz).
+     * @return One T60 (seconds) per band.
+     */
+    static std::vector<double> octaveBandDecayTimes(const float* ir, int length, double fs,
+        const std::vector<double>& centres);
+
+    /**
+     * @brief Normalized echo density profile.
+     * @param ir Impulse response.
+     * @param length Number of samples.
+     * @param fs Sample rate in Hz.
+     * @param hop Profile resolution in samples.
+     * @param window Analysis window length in seconds.
+     * @return One value per hop; ~1 for Gaussian-like (fully mixed) noise.
+     */
+    static std::vector<double> echoDensityProfile(const float* ir, int length, double fs,
+        int hop = 48, double window = 0.02);
+
+    /**
+     * @brief Time at which the echo density profile first reaches a threshold.
+     * @param profile Echo density profile.
+     * @param fs Sample rate in Hz.
+     * @param hop Profile resolution in samples.
+     * @param threshold Density treated as fully mixed.
+     * @return Mixing time in seconds, or -1 if never reached.
+     */
+    static double mixingTime(const std::vector<double>& profile, double fs, int hop = 48,
+        double threshold = 1.0);
+
+    /**
+     * @brief Spectral difference between two responses in 1/3-octave bands.
+     * @param a First response.
+     * @param b Second response.
+     * @param length Number of samples (both).
+     * @param fs Sample rate in Hz.
+     * @param maxDifference Receives the largest band difference (dB).
+     * @return Mean absolute band difference in dB over 50 Hz - 16 kHz.
+     */
+    static double spectralDifference(const float* a, const float* b, int length, double fs,
+        double& maxDifference);
+};
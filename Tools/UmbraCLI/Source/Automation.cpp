@@ -0,0 +1,247 @@
+#include "Automation.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int tileSize = 256; ///< Sub-block values evaluated per pass (on the stack)
+
+    /** UmbraCLI option names, in Automation::Parameter order. */
+    constexpr const char* parameterNames[Automation::numParameters] = {
+        "mix", "width", "lowpass", "highpass", "damping", "room", "predelay", "gain"
+    };
+
+    /** ReverbParameters fields, in Automation::Parameter order. */
+    constexpr float ReverbParameters::* parameterFields[Automation::numParameters] = {
+        &ReverbParameters::mix,
+        &ReverbParameters::stereoWidth,
+        &ReverbParameters::lowPass,
+        &ReverbParameters::highPass,
+        &ReverbParameters::dampening,
+        &ReverbParameters::roomSize,
+        &ReverbParameters::initialDelay,
+        &ReverbParameters::outputGain
+    };
+
+    bool isNumber(const juce::var& v)
+    {
+        return v.isInt() || v.isInt64() || v.isDouble();
+    }
+}
+
+/**
+ * @brief Parses a JSON object of [time, value] lists per parameter name.
+ *
+ * @param json Curve description.
+ * @return The parsed curves.
+ * @throws std::invalid_argument on malformed JSON, an unknown parameter name
+ *         or a breakpoint that is not two finite numbers.
+ */
+Automation Automation::parse(const juce::String& json)
+{
+    juce::var root;
+    const auto result = juce::JSON::parse(json, root);
+    if (result.failed())
+        throw std::invalid_argument("Invalid automation JSON: " + result.getErrorMessage().toStdString());
+
+    const auto* object = root.getDynamicObject();
+    if (object == nullptr)
+        throw std::invalid_argument("Automation must be a JSON object of parameter curves.");
+
+    Automation automation;
+    for (const auto& property : object->getProperties())
+    {
+        const auto name = property.name.toString();
+        Parameter parameter;
+        if (!parameterFromName(name, parameter))
+            throw std::invalid_argument("Unknown automation parameter \"" + name.toStdString() + "\"");
+
+        const auto* list = property.value.getArray();
+        if (list == nullptr)
+            throw std::invalid_argument("Curve \"" + name.toStdString() + "\" must be a list of [time, value] pairs.");
+
+        std::vector<Breakpoint> points;
+        points.reserve(static_cast<size_t>(list->size()));
+        for (const auto& entry : *list)
+        {
+            const auto* pair = entry.getArray();
+            if (pair == nullptr || pair->size() != 2 || !isNumber((*pair)[0]) || !isNumber((*pair)[1]))
+                throw std::invalid_argument("Curve \"" + name.toStdString() + "\" has a breakpoint that is not [time, value].");
+
+            const Breakpoint point{ static_cast<double>((*pair)[0]), static_cast<float>(static_cast<double>((*pair)[1])) };
+            if (!std::isfinite(point.time) || !std::isfinite(point.value))
+                throw std::invalid_argument("Curve \"" + name.toStdString() + "\" has a non-finite breakpoint.");
+            points.push_back(point);
+        }
+        automation.setCurve(parameter, std::move(points));
+    }
+    return automation;
+}
+
+/**
+ * @brief Reads a curve file and parses it.
+ *
+ * @param file JSON curve file.
+ * @return The parsed curves.
+ * @throws std::runtime_error if the file cannot be read.
+ * @throws std::invalid_argument if its contents are invalid.
+ */
+Automation Automation::loadFromFile(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        throw std::runtime_error("Cannot read automation " + file.getFullPathName().toStdString());
+    return parse(file.loadFileAsString());
+}
+
+/**
+ * @brief Maps an UmbraCLI option name to a parameter.
+ *
+ * @param name Option name without dashes.
+ * @param parameter Receives the parameter if the name is known.
+ * @return False for an unknown name.
+ */
+bool Automation::parameterFromName(const juce::String& name, Parameter& parameter)
+{
+    for (int i = 0; i < numParameters; ++i)
+    {
+        if (name == parameterNames[i])
+        {
+            parameter = static_cast<Parameter>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Stores a curve sorted by time.
+ *
+ * The sort is stable, so breakpoints sharing a time keep their order and
+ * form a jump from the first value to the last.
+ *
+ * @param parameter Parameter to automate.
+ * @param points Breakpoints (empty removes the curve).
+ */
+void Automation::setCurve(Parameter parameter, std::vector<Breakpoint> points)
+{
+    std::stable_sort(points.begin(), points.end(),
+        [](const Breakpoint& a, const Breakpoint& b) { return a.time < b.time; });
+    curves[index(parameter)] = std::move(points);
+}
+
+/** @brief True if no parameter has a curve. */
+bool Automation::isEmpty() const
+{
+    return std::all_of(curves.begin(), curves.end(),
+        [](const std::vector<Breakpoint>& curve) { return curve.empty(); });
+}
+
+/**
+ * @brief Evaluates one curve at first, first + step, ... (in samples).
+ *
+ * Walks the grid segment by segment: one binary search finds the segment of
+ * the next grid point, the number of grid points before the segment ends
+ * follows from its end time, and those points are filled as a + b * j,
+ * which vectorizes. Positions are converted to seconds in double precision,
+ * so the curve stays exact over multi-hour renders.
+ *
+ * @param parameter Automated parameter.
+ * @param sampleRate Sample rate in Hz.
+ * @param first Render position of the first grid point.
+ * @param step Samples between grid points.
+ * @param count Number of grid points.
+ * @param values Receives count values.
+ */
+void Automation::evaluate(Parameter parameter, double sampleRate, int64_t first, int step, int count, float* values) const
+{
+    const auto& curve = curves[index(parameter)];
+    jassert(!curve.empty() && step > 0);
+
+    const double secondsPerStep = static_cast<double>(step) / sampleRate;
+
+    for (int k = 0; k < count;)
+    {
+        const double t = static_cast<double>(first + static_cast<int64_t>(k) * step) / sampleRate;
+        const auto next = std::upper_bound(curve.begin(), curve.end(), t,
+            [](double time, const Breakpoint& b) { return time < b.time; });
+
+        // Grid points from k on that lie before the end of this segment (at least one)
+        int n = count - k;
+        if (next != curve.end())
+        {
+            const double end = std::ceil((next->time * sampleRate - static_cast<double>(first)) / static_cast<double>(step));
+            n = static_cast<int>(juce::jlimit<double>(1.0, static_cast<double>(count - k), end - static_cast<double>(k)));
+        }
+
+        float a = 0.0f;
+        float b = 0.0f;
+        if (next == curve.begin())
+            a = curve.front().value;
+        else if (next == curve.end())
+            a = curve.back().value;
+        else
+        {
+            const auto& prev = *(next - 1);
+            const double slope = (static_cast<double>(next->value) - prev.value) / (next->time - prev.time);
+            a = static_cast<float>(prev.value + slope * (t - prev.time));
+            b = static_cast<float>(slope * secondsPerStep);
+        }
+
+        float* out = values + k;
+        for (int j = 0; j < n; ++j)
+            out[j] = a + b * static_cast<float>(j);
+        k += n;
+    }
+}
+
+/**
+ * @brief Fills the parameter sets of one process call's sub-blocks.
+ *
+ * Every set starts as base; each automated parameter is then evaluated on
+ * the sub-block grid in stack tiles and written into its field. A short
+ * last sub-block is re-evaluated at the end of the call, as processRamp()
+ * does.
+ *
+ * @param base Values of the parameters without a curve.
+ * @param sampleRate Sample rate in Hz.
+ * @param position Render position of the first sample of the call.
+ * @param numSamples Length of the call.
+ * @param step Sub-block length.
+ * @param points Receives ceil(numSamples / step) parameter sets.
+ */
+void Automation::evaluateBlocks(const ReverbParameters& base, double sampleRate, int64_t position,
+    int numSamples, int step, ReverbParameters* points) const
+{
+    const int numPoints = (numSamples + step - 1) / step;
+    std::fill(points, points + numPoints, base);
+
+    const bool shortLast = numSamples % step != 0;
+    float tile[tileSize];
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        const auto parameter = static_cast<Parameter>(i);
+        if (!isAutomated(parameter))
+            continue;
+
+        for (int k = 0; k < numPoints; k += tileSize)
+        {
+            const int count = juce::jmin(tileSize, numPoints - k);
+            evaluate(parameter, sampleRate, position + static_cast<int64_t>(k + 1) * step, step, count, tile);
+            if (shortLast && k + count == numPoints)
+                evaluate(parameter, sampleRate, position + numSamples, 1, 1, tile + count - 1);
+            scatter(parameter, tile, count, points + k);
+        }
+    }
+}
+
+/**
+ * @brief Writes values into one field of consecutive parameter sets.
+ */
+void Automation::scatter(Parameter parameter, const float* values, int count, ReverbParameters* points)
+{
+    const auto field = parameterFields[index(parameter)];
+    for (int k = 0; k < count; ++k)
+        points[k].*field = values[k];
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+// Standard library
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class Automation
+ * @brief Breakpoint curves for the reverb parameters of an offline render.
+ *
+ * Each parameter can have a piecewise-linear curve over render time
+ * (seconds from the first input sample, the tail included). Before the
+ * first and after the last breakpoint the curve holds; two breakpoints at
+ * the same time make a jump. Parameters without a curve keep their
+ * constant value.
+ *
+ * Curves are evaluated on a regular sample grid, one parameter at a time:
+ * the grid points falling into one segment are a plain arithmetic
+ * sequence, filled by a branch-free loop the compiler vectorizes, so a
+ * whole chunk of control blocks costs a few segment lookups plus a fill.
+ * evaluateBlocks() produces the per-sub-block values Reverb::processAutomation
+ * takes, so the curves drive the engine's filter, FDN coefficient and
+ * output smoothing updates directly.
+ *
+ * Curve files are JSON objects mapping parameter names (the UmbraCLI
+ * option names: mix, width, lowpass, highpass, damping, room, predelay,
+ * gain) to [time, value] pairs:
+ *
+ *     { "lowpass": [[0, 20000], [12.5, 800]], "mix": [[0, 0.2], [30, 1]] }
+ */
+class Automation
+{
+public:
+    /**
+     * @enum Parameter
+     * @brief Automatable fields of ReverbParameters.
+     */
+    enum class Parameter
+    {
+        Mix,
+        StereoWidth,
+        LowPass,
+        HighPass,
+        Dampening,
+        RoomSize,
+        InitialDelay,
+        OutputGain
+    };
+
+    static constexpr int numParameters = 8; ///< Entries in Parameter
+
+    /**
+     * @struct Breakpoint
+     * @brief One point of a curve.
+     */
+    struct Breakpoint
+    {
+        double time = 0.0; ///< Render time in seconds
+        float value = 0.0f; ///< Parameter value at that time
+    };
+
+    /** @brief Creates an empty set (every parameter constant). */
+    Automation() = default;
+
+    /**
+     * @brief Parses curves from JSON text (see the class description).
+     * @param json Object mapping parameter names to [time, value] pairs.
+     * @return The parsed curves.
+     * @throws std::invalid_argument on malformed JSON, an unknown parameter
+     *         name or a breakpoint that is not two finite numbers.
+     */
+    static Automation parse(const juce::String& json);
+
+    /**
+     * @brief Loads and parses a curve file.
+     * @param file JSON curve file.
+     * @return The parsed curves.
+     * @throws std::runtime_error if the file cannot be read.
+     * @throws std::invalid_argument if its contents are invalid (see parse()).
+     */
+    static Automation loadFromFile(const juce::File& file);
+
+    /**
+     * @brief Looks up a parameter by its UmbraCLI option name.
+     * @param name e.g. "lowpass" or "room".
+     * @param parameter Receives the parameter if the name is known.
+     * @return False for an unknown name.
+     */
+    static bool parameterFromName(const juce::String& name, Parameter& parameter);
+
+    /**
+     * @brief Replaces the curve of one parameter.
+     * @param parameter Parameter to automate.
+     * @param points Breakpoints in any order (sorted by time, stable for
+     *        jumps); an empty list removes the curve.
+     */
+    void setCurve(Parameter parameter, std::vector<Breakpoint> points);
+
+    /** @brief True if no parameter has a curve. */
+    bool isEmpty() const;
+
+    /** @brief True if the parameter has a curve. */
+    bool isAutomated(Parameter parameter) const { return !curves[index(parameter)].empty(); }
+
+    /**
+     * @brief Evaluates one curve on a regular sample grid.
+     * @param parameter Automated parameter (must have a curve).
+     * @param sampleRate Sample rate of the render in Hz.
+     * @param first Render position (in samples) of the first grid point.
+     * @param step Samples between grid points (1 = per-sample values).
+     * @param count Number of grid points.
+     * @param values Receives count values.
+     */
+    void evaluate(Parameter parameter, double sampleRate, int64_t first, int step, int count, float* values) const;
+
+    /**
+     * @brief Evaluates all parameters for the sub-blocks of one process call.
+     * @param base Values of the parameters without a curve.
+     * @param sampleRate Sample rate of the render in Hz.
+     * @param position Render position of the first sample of the call.
+     * @param numSamples Length of the call.
+     * @param step Sub-block length (Reverb::getMicroBlockSize()).
+     * @param points Receives ceil(numSamples / step) parameter sets.
+     *
+     * Like Reverb::processRamp(), sub-block k takes the values at its end,
+     * position + min((k + 1) * step, numSamples).
+     */
+    void evaluateBlocks(const ReverbParameters& base, double sampleRate, int64_t position,
+        int numSamples, int step, ReverbParameters* points) const;
+
+private:
+    static int index(Parameter parameter) { return static_cast<int>(parameter); }
+
+    /**
+     * @brief Copies values into one field of consecutive parameter sets.
+     */
+    static void scatter(Parameter parameter, const float* values, int count, ReverbParameters* points);
+
+    std::array<std::vector<Breakpoint>, numParameters> curves; ///< Sorted breakpoints per parameter
+};
@@ -0,0 +1,235 @@
+#include "DeterminismCheck.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief One execution path: diffuser team size, metering, engine reuse.
+     */
+    struct Path
+    {
+        std::string name;
+        int threads = 1;     ///< ReverbOptions::diffuserThreads
+        bool metered = false; ///< Gather levels in the output pass
+        bool reused = false;  ///< Render once, reset, and keep the second render
+    };
+
+    const char* engineName(Diffuser::Engine engine)
+    {
+        switch (engine)
+        {
+        case Diffuser::Engine::SharedDVN: return "shared";
+        case Diffuser::Engine::Allpass: return "allpass";
+        default: return "dvn";
+        }
+    }
+
+    /**
+     * @brief Parameter targets of one callback.
+     *
+     * Quarter 1 holds the base values (settled kernels), quarter 2 ramps to a
+     * smaller, darker room at mix 1, quarter 3 holds there (the wet-only
+     * kernel), quarter 4 ramps back.
+     */
+    ReverbParameters automation(const ReverbParameters& base, int callback, int numCallbacks)
+    {
+        ReverbParameters far = base;
+        far.roomSize = base.roomSize * 0.5f;
+        far.dampening = base.dampening * 0.25f;
+        far.initialDelay = base.initialDelay + 0.01f;
+        far.stereoWidth = base.stereoWidth * 0.5f;
+        far.mix = 1.0f;
+
+        const float phase = 4.0f * static_cast<float>(callback) / static_cast<float>(juce::jmax(1, numCallbacks));
+        if (phase < 1.0f)
+            return base;
+        if (phase < 2.0f)
+            return ReverbParameters::interpolate(base, far, phase - 1.0f);
+        if (phase < 3.0f)
+            return far;
+        return ReverbParameters::interpolate(far, base, juce::jmin(1.0f, phase - 3.0f));
+    }
+
+    /**
+     * @brief Renders the input through one engine in host-sized callbacks.
+     *
+     * Held stretches go through process(), which hands the diffusers whole
+     * callbacks (so multi-threaded paths really run on the team); ramps go
+     * through processRamp(), whose sub-blocks always run serially.
+     */
+    void render(Reverb& reverb, const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+        const ReverbParameters& base, int blockSize)
+    {
+        output.makeCopyOf(input);
+        const int numCallbacks = (output.getNumSamples() + blockSize - 1) / blockSize;
+
+        ReverbParameters previous = automation(base, 0, numCallbacks);
+        for (int i = 0; i < numCallbacks; ++i)
+        {
+            const int start = i * blockSize;
+            const int numSamples = juce::jmin(blockSize, output.getNumSamples() - start);
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), start, numSamples);
+
+            const auto target = automation(base, i, numCallbacks);
+            if (target == previous)
+                reverb.process(block, target);
+            else
+                reverb.processRamp(block, previous, target);
+            previous = target;
+        }
+    }
+
+    /**
+     * @brief 64-bit FNV-1a over the raw sample bits, channel by channel.
+     */
+    uint64_t digest(const juce::AudioBuffer<float>& buffer)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(buffer.getReadPointer(ch));
+            const size_t size = static_cast<size_t>(buffer.getNumSamples()) * sizeof(float);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    /**
+     * @brief First frame whose bits differ in any channel, or -1.
+     */
+    int64_t firstMismatch(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int n = 0; n < a.getNumSamples(); ++n)
+            for (int ch = 0; ch < a.getNumChannels(); ++ch)
+                if (std::memcmp(a.getReadPointer(ch, n), b.getReadPointer(ch, n), sizeof(float)) != 0)
+                    return n;
+        return -1;
+    }
+}
+
+/**
+ * @brief Renders every path of every engine and compares the bits.
+ *
+ * Steps:
+ * 1. Seeded stereo noise input of config.seconds.
+ * 2. Per engine: the reference (deterministic, one diffuser thread, no
+ *    metering), then 2..N threads, metered, reused after reset and rebuilt.
+ *    Thread counts are only varied for the DVN engine, the others run no
+ *    threads.
+ * 3. Each path's output is compared bitwise with the reference.
+ *
+ * @param config Render settings.
+ * @return Digest and comparison per path.
+ * @throws std::invalid_argument if the seed is 0, or the length or block size is not positive.
+ */
+DeterminismCheck::Result DeterminismCheck::run(const Config& config)
+{
+    const int length = static_cast<int>(config.seconds * config.fs);
+    if (length <= 0 || config.blockSize <= 0)
+        throw std::invalid_argument("Render length and block size must be positive");
+    if (config.seed == 0)
+        throw std::invalid_argument("Deterministic renders need a non-zero seed");
+
+    const int maxThreads = config.maxThreads > 0 ? config.maxThreads
+        : juce::jlimit(1, 8, juce::SystemStats::getNumCpus());
+
+    // Step 1: input
+    juce::AudioBuffer<float> input(2, length);
+    juce::Random random(static_cast<juce::int64>(config.seed));
+    for (int ch = 0; ch < 2; ++ch)
+        for (int n = 0; n < length; ++n)
+            input.setSample(ch, n, random.nextFloat() * 0.5f - 0.25f);
+
+    Result result;
+    result.passed = true;
+
+    for (const auto engine : config.engines)
+    {
+        // Step 2: paths
+        std::vector<Path> paths { { "reference", 1, false, false } };
+        if (engine == Diffuser::Engine::DVN)
+            for (int t = 2; t <= maxThreads; ++t)
+                paths.push_back({ std::to_string(t) + " threads", t, false, false });
+        paths.push_back({ "metered", 1, true, false });
+        paths.push_back({ "reset and reused", maxThreads, false, true });
+        paths.push_back({ "rebuilt", maxThreads, false, false });
+
+        juce::AudioBuffer<float> reference;
+        for (const auto& path : paths)
+        {
+            ReverbOptions options = config.options;
+            options.d1Engine = options.d2Engine = options.d3Engine = engine;
+            options.seed = config.seed;
+            options.diffuserThreads = path.threads;
+            options.deterministic = true;
+
+            Render entry;
+            entry.engine = engineName(engine);
+            entry.path = path.name;
+
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            Reverb reverb(static_cast<float>(config.fs), config.blockSize, options);
+            OutputStage::Levels levels;
+            if (path.metered)
+                reverb.setLevels(&levels);
+
+            juce::AudioBuffer<float> output;
+            render(reverb, input, output, config.parameters, config.blockSize);
+            if (path.reused)
+            {
+                reverb.reset();
+                render(reverb, input, output, config.parameters, config.blockSize);
+            }
+            entry.seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+            entry.digest = digest(output);
+
+            // Step 3: compare
+            if (reference.getNumSamples() == 0)
+            {
+                reference.makeCopyOf(output);
+                entry.identical = true;
+            }
+            else
+            {
+                entry.firstMismatch = firstMismatch(reference, output);
+                entry.identical = entry.firstMismatch < 0;
+            }
+
+            result.passed = result.passed && entry.identical;
+            result.renders.push_back(entry);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief One line per path: engine, path, digest, time and verdict.
+ */
+juce::String DeterminismCheck::format(const Config& config, const Result& result)
+{
+    juce::String report;
+    report << "seed " << static_cast<int>(config.seed) << ", " << config.seconds << " s at "
+           << config.fs << " Hz, block " << config.blockSize << "\n";
+
+    for (const auto& r : result.renders)
+    {
+        report << (r.identical ? "  ok    " : "  FAIL  ")
+               << juce::String(r.engine).paddedRight(' ', 9)
+               << juce::String(r.path).paddedRight(' ', 18)
+               << juce::String::toHexString(static_cast<juce::int64>(r.digest)).paddedLeft('0', 16)
+               << "  " << juce::String(r.seconds, 2) << " s";
+        if (!r.identical)
+            report << "  (first difference at frame " << static_cast<juce::int64>(r.firstMismatch) << ")";
+        report << "\n";
+    }
+
+    report << (result.passed ? "PASS" : "FAIL") << "\n";
+    return report;
+}
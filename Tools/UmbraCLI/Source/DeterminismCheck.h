@@ -0,0 +1,97 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class DeterminismCheck
+ * @brief Verifies that deterministic mode gives the same bits on every execution path.
+ *
+ * For each diffuser engine the same noise input is rendered with the same
+ * seed and automation (settled, ramping and fully wet stretches, so every
+ * output kernel runs) through several paths:
+ * - 1 to N OpenMP threads per DVN diffuser,
+ * - the metered output kernel (Reverb::setLevels),
+ * - an engine reused through Reverb::reset(),
+ * - a second engine built from scratch.
+ * Every render must match the single-threaded reference bit for bit. The
+ * reference's 64-bit digest is reported as well, so render nodes can
+ * compare it across machines. That comparison only holds for the same
+ * build: a different compiler, different flags or another target
+ * instruction set (AVX vs SSE2, a different libm) may round differently.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class DeterminismCheck
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    DeterminismCheck() = delete;
+
+    /**
+     * @struct Config
+     * @brief What to render.
+     */
+    struct Config
+    {
+        double fs = 48000.0;          ///< Sample rate in Hz
+        int blockSize = 512;          ///< Callback and engine block size
+        double seconds = 4.0;         ///< Rendered length
+        uint32_t seed = 1;            ///< Topology and input seed
+        int maxThreads = 0;           ///< Largest diffuser team tried (0 = CPU count, at most 8)
+        std::vector<Diffuser::Engine> engines { Diffuser::Engine::DVN,
+            Diffuser::Engine::SharedDVN, Diffuser::Engine::Allpass }; ///< Engines checked
+        ReverbOptions options;        ///< Storage, early reflections, frozen mode (engines, seed and threads are overridden)
+        ReverbParameters parameters;  ///< Values at the start and end of the automation
+    };
+
+    /**
+     * @struct Render
+     * @brief One execution path compared against its engine's reference.
+     */
+    struct Render
+    {
+        std::string engine;          ///< Diffuser engine name
+        std::string path;            ///< Execution path
+        uint64_t digest = 0;         ///< FNV-1a digest of the output bits
+        bool identical = false;      ///< Bitwise equal to the reference (true for the reference)
+        int64_t firstMismatch = -1;  ///< First differing frame (-1 if identical)
+        double seconds = 0.0;        ///< Wall-clock render time
+    };
+
+    /**
+     * @struct Result
+     * @brief Outcome of the check.
+     */
+    struct Result
+    {
+        std::vector<Render> renders; ///< References first, then the other paths, per engine
+        bool passed = false;         ///< Every render identical to its reference
+    };
+
+    /**
+     * @brief Runs the check.
+     * @param config Render settings.
+     * @return Digest and comparison per path.
+     * @throws std::invalid_argument if the seed is 0, or the length or block size is not positive.
+     */
+    static Result run(const Config& config);
+
+    /**
+     * @brief Formats a result as a plain-text report.
+     * @param config Settings the result was produced with.
+     * @param result Check outcome.
+     * @return Multi-line report.
+     */
+    static juce::String format(const Config& config, const Result& result);
+};
@@ -0,0 +1,155 @@
+#include "EquivalenceBench.h"
+#include "AcousticMetrics.h"
+#include "ReferenceReverb.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    const std::vector<double> octaveCentres = { 125.0, 250.0, 500.0, 1000.0, 2000.0, 4000.0, 8000.0 };
+
+    /**
+     * @brief Appends one check and returns whether it passed.
+     */
+    bool addCheck(EquivalenceBench::Result& result, const std::string& name,
+        double reference, double candidate, double deviation, double tolerance)
+    {
+        EquivalenceBench::Check check;
+        check.name = name;
+        check.reference = reference;
+        check.candidate = candidate;
+        check.deviation = deviation;
+        check.tolerance = tolerance;
+        check.passed = deviation <= tolerance;
+        result.checks.push_back(check);
+        return check.passed;
+    }
+}
+
+/**
+ * @brief Renders both impulse responses and compares every measure.
+ *
+ * Steps:
+ * 1. Stereo unit impulse of config.seconds.
+ * 2. Reference render (ReferenceReverb) and optimized render (Reverb with the
+ *    candidate options and the same seed), both timed.
+ * 3. Per output channel: EDC difference, T60 per octave, mixing time and
+ *    1/3-octave spectral difference, each against its tolerance.
+ *
+ * @param config Render and tolerance settings.
+ * @return Checks, peak sample error and timings.
+ * @throws std::invalid_argument if the seed is 0 or the length is not positive.
+ */
+EquivalenceBench::Result EquivalenceBench::run(const Config& config)
+{
+    const int length = static_cast<int>(config.seconds * config.fs);
+    if (length <= 0)
+        throw std::invalid_argument("Render length must be positive");
+
+    // Step 1: impulse
+    juce::AudioBuffer<float> impulse(2, length);
+    impulse.clear();
+    impulse.setSample(0, 0, 1.0f);
+    impulse.setSample(1, 0, 1.0f);
+
+    Result result;
+
+    // Step 2: renders
+    juce::AudioBuffer<float> referenceOut;
+    {
+        ReferenceReverb reference(config.fs, config.seed);
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        reference.render(impulse, referenceOut, config.parameters);
+        result.referenceSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+    }
+
+    juce::AudioBuffer<float> candidateOut;
+    candidateOut.makeCopyOf(impulse);
+    {
+        ReverbOptions options = config.candidate;
+        options.seed = config.seed;
+        Reverb candidate(static_cast<float>(config.fs), config.blockSize, options);
+        candidate.waitForFrozenGrid(); // frozen candidates convolve from the first sample
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        candidate.process(candidateOut, config.parameters);
+        result.candidateSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+    }
+
+    // Step 3: measures
+    const auto& tol = config.tolerances;
+    bool passed = true;
+    double peak = 0.0, peakError = 0.0;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const float* ref = referenceOut.getReadPointer(ch);
+        const float* cand = candidateOut.getReadPointer(ch);
+        const juce::String side = ch == 0 ? "L" : "R";
+
+        for (int n = 0; n < length; ++n)
+        {
+            peak = std::max(peak, static_cast<double>(std::abs(ref[n])));
+            peakError = std::max(peakError, static_cast<double>(std::abs(ref[n] - cand[n])));
+        }
+
+        const auto edcRef = AcousticMetrics::energyDecayCurve(ref, length);
+        const auto edcCand = AcousticMetrics::energyDecayCurve(cand, length);
+        const double edcDiff = AcousticMetrics::decayCurveDifference(edcRef, edcCand);
+        passed &= addCheck(result, (side + " EDC").toStdString(), 0.0, 0.0, edcDiff, tol.decayCurveDb);
+
+        const auto t60Ref = AcousticMetrics::octaveBandDecayTimes(ref, length, config.fs, octaveCentres);
+        const auto t60Cand = AcousticMetrics::octaveBandDecayTimes(cand, length, config.fs, octaveCentres);
+        for (size_t band = 0; band < octaveCentres.size(); ++band)
+        {
+            if (t60Ref[band] <= 0.0)
+                continue;
+
+            const double deviation = std::abs(t60Cand[band] - t60Ref[band]) / t60Ref[band];
+            const juce::String name = side + " T60 " + juce::String(static_cast<int>(octaveCentres[band])) + " Hz";
+            passed &= addCheck(result, name.toStdString(), t60Ref[band], t60Cand[band], deviation, tol.decayTimeRelative);
+        }
+
+        const double mixRef = AcousticMetrics::mixingTime(AcousticMetrics::echoDensityProfile(ref, length, config.fs), config.fs);
+        const double mixCand = AcousticMetrics::mixingTime(AcousticMetrics::echoDensityProfile(cand, length, config.fs), config.fs);
+        passed &= addCheck(result, (side + " mixing time").toStdString(), mixRef, mixCand,
+            std::abs(mixCand - mixRef), tol.mixingTimeSeconds);
+
+        double spectralMax = 0.0;
+        const double spectralMean = AcousticMetrics::spectralDifference(ref, cand, length, config.fs, spectralMax);
+        passed &= addCheck(result, (side + " spectrum mean").toStdString(), 0.0, 0.0, spectralMean, tol.spectralMeanDb);
+        passed &= addCheck(result, (side + " spectrum max").toStdString(), 0.0, 0.0, spectralMax, tol.spectralMaxDb);
+    }
+
+    result.peakErrorDb = (peak > 0.0 && peakError > 0.0) ? 20.0 * std::log10(peakError / peak) : -200.0;
+    result.passed = passed;
+    return result;
+}
+
+/**
+ * @brief One line per check, then timings and the overall verdict.
+ */
+juce::String EquivalenceBench::format(const Config& config, const Result& result)
+{
+    juce::String report;
+    report << "seed " << static_cast<int>(config.seed) << ", " << config.seconds << " s at "
+           << config.fs << " Hz, block " << config.blockSize << "\n";
+
+    for (const auto& check : result.checks)
+    {
+        report << (check.passed ? "  ok    " : "  FAIL  ") << juce::String(check.name).paddedRight(' ', 20)
+               << " ref " << juce::String(check.reference, 4)
+               << "  opt " << juce::String(check.candidate, 4)
+               << "  dev " << juce::String(check.deviation, 4)
+               << " (tol " << juce::String(check.tolerance, 4) << ")\n";
+    }
+
+    const double audioSeconds = config.seconds;
+    report << "peak sample error " << juce::String(result.peakErrorDb, 1) << " dB re. peak\n";
+    report << "reference render " << juce::String(result.referenceSeconds, 3) << " s ("
+           << juce::String(audioSeconds / juce::jmax(1.0e-9, result.referenceSeconds), 1) << "x realtime)\n";
+    report << "optimized render " << juce::String(result.candidateSeconds, 3) << " s ("
+           << juce::String(audioSeconds / juce::jmax(1.0e-9, result.candidateSeconds), 1) << "x realtime)\n";
+    report << (result.passed ? "PASS" : "FAIL") << "\n";
+    return report;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class EquivalenceBench
+ * @brief Renders one impulse response through the reference and the optimized engine and compares them.
+ *
+ * Both engines are built from the same topology seed. The stereo impulse
+ * response of each is analyzed with AcousticMetrics, every measure is checked
+ * against a tolerance, and the CPU time of both renders is reported.
+ *
+ * The default candidate (default ReverbOptions) implements the same
+ * algorithm as the reference, so any difference beyond float rounding means
+ * an optimization changed the sound. Non-default candidates (allpass
+ * diffusers, 16-bit delay storage, early reflections) are different
+ * algorithms; the same report then shows how far they move the metrics.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class EquivalenceBench
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    EquivalenceBench() = delete;
+
+    /**
+     * @struct Tolerances
+     * @brief Largest accepted deviation per measure.
+     */
+    struct Tolerances
+    {
+        double decayCurveDb = 0.5;        ///< EDC difference above -60 dB
+        double decayTimeRelative = 0.05;  ///< Per-octave T60 deviation (fraction)
+        double mixingTimeSeconds = 0.005; ///< Echo density mixing time deviation
+        double spectralMeanDb = 0.5;      ///< Mean 1/3-octave difference
+        double spectralMaxDb = 1.5;       ///< Largest 1/3-octave difference
+    };
+
+    /**
+     * @struct Config
+     * @brief What to render and how.
+     */
+    struct Config
+    {
+        double fs = 48000.0;          ///< Sample rate in Hz
+        int blockSize = 512;          ///< Block size of the optimized engine
+        double seconds = 8.0;         ///< Impulse response length
+        uint32_t seed = 1;            ///< Topology seed shared by both engines
+        ReverbParameters parameters;  ///< Constant parameter values
+        ReverbOptions candidate;      ///< Options of the optimized engine (seed is overridden)
+        Tolerances tolerances;        ///< Pass/fail limits
+    };
+
+    /**
+     * @struct Check
+     * @brief One compared measure.
+     */
+    struct Check
+    {
+        std::string name;      ///< Measure name
+        double reference = 0;  ///< Reference value
+        double candidate = 0;  ///< Optimized value
+        double deviation = 0;  ///< Deviation in the tolerance's unit
+        double tolerance = 0;  ///< Accepted deviation
+        bool passed = false;   ///< deviation <= tolerance
+    };
+
+    /**
+     * @struct Result
+     * @brief Outcome of one bench run.
+     */
+    struct Result
+    {
+        std::vector<Check> checks;     ///< All compared measures
+        double peakErrorDb = 0.0;      ///< Peak sample difference relative to the reference peak
+        double referenceSeconds = 0.0; ///< CPU time of the reference render
+        double candidateSeconds = 0.0; ///< CPU time of the optimized render
+        bool passed = false;           ///< All checks passed
+    };
+
+    /**
+     * @brief Runs the bench.
+     * @param config Render and tolerance settings.
+     * @return Measured deviations and timings.
+     * @throws std::invalid_argument if the seed is 0 or the length is not positive.
+     */
+    static Result run(const Config& config);
+
+    /**
+     * @brief Formats a result as a plain-text report.
+     * @param config Settings the result was produced with.
+     * @param result Bench outcome.
+     * @return Multi-line report.
+     */
+    static juce::String format(const Config& config, const Result& result);
+};
@@ -0,0 +1,774 @@
+/**
+ * @file Main.cpp
+ * @brief Command line tools for the Umbra engine (benchmarks and offline checks).
+ *
+ * Usage: UmbraCLI <command> [options]; run with --help for the command list.
+ */
+
+// Standard library
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Autotuner.h"
+#include "Automation.h"
+#include "DeterminismCheck.h"
+#include "EquivalenceBench.h"
+#include "MappedWavReader.h"
+#include "OfflineRenderer.h"
+#include "ReverbService.h"
+#include "ScalingBench.h"
+#include "SelfCheck.h"
+#include "ServiceClient.h"
+#include "SweepRenderer.h"
+
+namespace
+{
+    /**
+     * @brief Reads a numeric option ("--name=value" or "--name value"), or returns a default.
+     */
+    double numberOption(const juce::ArgumentList& args, const juce::String& name, double fallback)
+    {
+        return args.containsOption(name) ? args.getValueForOption(name).getDoubleValue() : fallback;
+    }
+
+    /**
+     * @brief Parses the engine options shared by all commands.
+     */
+    ReverbOptions parseOptions(const juce::ArgumentList& args)
+    {
+        ReverbOptions options;
+
+        const auto engine = args.getValueForOption("--engine");
+        if (engine == "allpass")
+            options.d1Engine = options.d2Engine = options.d3Engine = Diffuser::Engine::Allpass;
+        else if (engine == "shared")
+            options.d1Engine = options.d2Engine = options.d3Engine = Diffuser::Engine::SharedDVN;
+        else if (engine.isNotEmpty() && engine != "dvn")
+            juce::ConsoleApplication::fail("Unknown --engine (use dvn, shared or allpass)");
+
+        const auto storage = args.getValueForOption("--storage");
+        if (storage == "fp16")
+            options.fdnStorage = DelayLine::Storage::Float16;
+        else if (storage == "bf16")
+            options.fdnStorage = DelayLine::Storage::BFloat16;
+        else if (storage.isNotEmpty() && storage != "float")
+            juce::ConsoleApplication::fail("Unknown --storage (use float, fp16 or bf16)");
+
+        const auto matrix = args.getValueForOption("--matrix");
+        if (matrix == "householder")
+            options.feedbackMatrix = FeedbackMatrixType::Householder;
+        else if (matrix == "velvet")
+            options.feedbackMatrix = FeedbackMatrixType::Velvet;
+        else if (matrix.isNotEmpty() && matrix != "hadamard")
+            juce::ConsoleApplication::fail("Unknown --matrix (use hadamard, householder or velvet)");
+
+        options.earlyReflections = args.containsOption("--early");
+
+        // --fdn16 [--decay=LOW[,HIGH]] (T60 seconds at room size 1)
+        options.highOrderFDN = args.containsOption("--fdn16");
+        if (args.containsOption("--decay"))
+        {
+            const auto decay = args.getValueForOption("--decay");
+            options.decayLow = decay.upToFirstOccurrenceOf(",", false, true).getFloatValue();
+            options.decayHigh = decay.containsChar(',')
+                ? decay.fromFirstOccurrenceOf(",", false, true).getFloatValue()
+                : options.decayLow;
+            if (options.decayLow <= 0.0f || options.decayHigh <= 0.0f)
+                juce::ConsoleApplication::fail("Invalid --decay (use e.g. --decay=6,2)");
+        }
+
+        // --frozen or --frozen=RxD (roomSize x dampening grid points)
+        if (args.containsOption("--frozen"))
+        {
+            options.frozen = true;
+            const auto grid = args.getValueForOption("--frozen");
+            if (grid.isNotEmpty())
+            {
+                options.frozenGrid.roomSizePoints = grid.upToFirstOccurrenceOf("x", false, true).getIntValue();
+                options.frozenGrid.dampeningPoints = grid.fromFirstOccurrenceOf("x", false, true).getIntValue();
+                if (options.frozenGrid.roomSizePoints < 1 || options.frozenGrid.dampeningPoints < 1)
+                    juce::ConsoleApplication::fail("Invalid --frozen grid (use e.g. --frozen=3x3)");
+            }
+            options.frozenGrid.maxSeconds = static_cast<float>(numberOption(args, "--ir-seconds", options.frozenGrid.maxSeconds));
+        }
+        options.seed = static_cast<uint32_t>(numberOption(args, "--seed", 0.0));
+        options.deterministic = args.containsOption("--deterministic");
+        return options;
+    }
+
+    /**
+     * @brief Parses the reverb parameters shared by all commands.
+     */
+    ReverbParameters parseParameters(const juce::ArgumentList& args)
+    {
+        ReverbParameters parameters;
+        parameters.roomSize = static_cast<float>(numberOption(args, "--room", parameters.roomSize));
+        parameters.dampening = static_cast<float>(numberOption(args, "--damping", parameters.dampening));
+        parameters.lowPass = static_cast<float>(numberOption(args, "--lowpass", parameters.lowPass));
+        parameters.highPass = static_cast<float>(numberOption(args, "--highpass", parameters.highPass));
+        parameters.initialDelay = static_cast<float>(numberOption(args, "--predelay", parameters.initialDelay));
+        parameters.mix = static_cast<float>(numberOption(args, "--mix", parameters.mix));
+        parameters.stereoWidth = static_cast<float>(numberOption(args, "--width", parameters.stereoWidth));
+        parameters.outputGain = static_cast<float>(numberOption(args, "--gain", parameters.outputGain));
+        return parameters;
+    }
+
+    /**
+     * @brief Reads a sweep axis: "a,b,c" lists values, "lo:hi:n" spaces n values
+     *        evenly from lo to hi. Without the option the single fallback is used.
+     */
+    std::vector<float> valueList(const juce::ArgumentList& args, const juce::String& name, float fallback)
+    {
+        if (!args.containsOption(name))
+            return { fallback };
+
+        const auto text = args.getValueForOption(name);
+        std::vector<float> values;
+        if (text.containsChar(':'))
+        {
+            const auto range = juce::StringArray::fromTokens(text, ":", "");
+            const int count = range.size() == 3 ? range[2].getIntValue() : 0;
+            if (count < 1)
+                juce::ConsoleApplication::fail("Invalid " + name + " range (use lo:hi:n)");
+
+            const float lo = range[0].getFloatValue();
+            const float hi = range[1].getFloatValue();
+            for (int i = 0; i < count; ++i)
+                values.push_back(count == 1 ? lo : lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(count - 1));
+            return values;
+        }
+
+        for (const auto& value : juce::StringArray::fromTokens(text, ",", ""))
+            if (value.trim().isNotEmpty())
+                values.push_back(value.getFloatValue());
+        if (values.empty())
+            juce::ConsoleApplication::fail("Invalid " + name + " (use a,b,c or lo:hi:n)");
+        return values;
+    }
+
+    /**
+     * @brief "bench": reference-versus-optimized equivalence check.
+     */
+    void runBench(const juce::ArgumentList& args)
+    {
+        EquivalenceBench::Config config;
+        config.fs = numberOption(args, "--fs", config.fs);
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.seconds = numberOption(args, "--seconds", config.seconds);
+        config.candidate = parseOptions(args);
+        config.parameters = parseParameters(args);
+        config.seed = config.candidate.seed != 0 ? config.candidate.seed : 1;
+
+        const auto result = EquivalenceBench::run(config);
+        std::cout << EquivalenceBench::format(config, result);
+
+        if (!result.passed)
+            juce::ConsoleApplication::fail("Optimized engine deviates from the reference", 1);
+    }
+
+    /**
+     * @brief "check": deterministic pass/fail checks of engine components.
+     */
+    void runCheck(const juce::ArgumentList& args)
+    {
+        juce::StringArray groups;
+        if (args.containsOption("--only"))
+            groups = juce::StringArray::fromTokens(args.getValueForOption("--only"), ",", "");
+
+        SelfCheck::Result result;
+        try
+        {
+            result = SelfCheck::run(groups);
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+
+        std::cout << SelfCheck::format(result);
+
+        if (!result.passed)
+            juce::ConsoleApplication::fail("Engine self-check failed", 1);
+    }
+
+    /**
+     * @brief "render": streams a WAV file through the reverb.
+     */
+    void runRender(const juce::ArgumentList& args)
+    {
+        if (args.size() < 3)
+            juce::ConsoleApplication::fail("Usage: render <input.wav> <output.wav> [options]");
+
+        OfflineRenderer::Config config;
+        config.input = args[1].resolveAsExistingFile();
+        config.output = args[2].resolveAsFile();
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.chunkSize = static_cast<int>(numberOption(args, "--chunk", config.chunkSize));
+        config.bitDepth = static_cast<int>(numberOption(args, "--bits", config.bitDepth));
+        config.tailSeconds = numberOption(args, "--tail", config.tailSeconds);
+        config.options = parseOptions(args);
+        config.parameters = parseParameters(args);
+        config.checkpointSeconds = numberOption(args, "--checkpoint-every", config.checkpointSeconds);
+        config.stopSeconds = numberOption(args, "--stop-at", config.stopSeconds);
+        if (args.containsOption("--checkpoint"))
+            config.checkpoint = args.getFileForOption("--checkpoint");
+        if (args.containsOption("--resume"))
+            config.resume = args.getExistingFileForOption("--resume");
+
+        try
+        {
+            if (args.containsOption("--automation"))
+                config.automation = Automation::loadFromFile(args.getExistingFileForOption("--automation"));
+
+            const auto stats = OfflineRenderer::render(config);
+            const double audioSeconds = static_cast<double>(stats.outputSamples) / stats.sampleRate;
+
+            std::cout << stats.outputSamples << " samples (" << audioSeconds << " s) in " << stats.seconds << " s, "
+                      << audioSeconds / juce::jmax(1.0e-9, stats.seconds) << "x realtime, "
+                      << stats.writerWaitSeconds << " s waiting for the writer";
+            if (config.options.frozen)
+                std::cout << ", " << stats.gridSeconds << " s rendering the IR grid";
+            std::cout << "\n";
+
+            if (stats.startSample > 0)
+                std::cout << "resumed at frame " << stats.startSample << "\n";
+            if (stats.checkpoints > 0)
+                std::cout << stats.checkpoints << " checkpoints, the last at frame " << stats.endSample
+                          << " (" << config.checkpoint.getFullPathName() << ")\n";
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+    }
+
+    /**
+     * @brief "scale": multi-instance throughput and cache contention.
+     */
+    void runScale(const juce::ArgumentList& args)
+    {
+        ScalingBench::Config config;
+        config.fs = numberOption(args, "--fs", config.fs);
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.seconds = numberOption(args, "--seconds", config.seconds);
+        config.threads = static_cast<int>(numberOption(args, "--threads", config.threads));
+        config.parameters = parseParameters(args);
+
+        if (args.containsOption("--instances"))
+        {
+            config.instances.clear();
+            for (const auto& count : juce::StringArray::fromTokens(args.getValueForOption("--instances"), ",", ""))
+                if (count.getIntValue() > 0)
+                    config.instances.push_back(count.getIntValue());
+            if (config.instances.empty())
+                juce::ConsoleApplication::fail("Invalid --instances (use e.g. --instances=1,8,50)");
+        }
+
+        // Every engine x storage combination unless --engine / --storage narrow it down
+        config.variants = ScalingBench::allVariants(parseOptions(args));
+        const auto engine = args.getValueForOption("--engine");
+        const auto storage = args.getValueForOption("--storage");
+        config.variants.erase(std::remove_if(config.variants.begin(), config.variants.end(),
+            [&](const ScalingBench::Variant& v)
+            {
+                return (engine.isNotEmpty() && !v.name.startsWith(engine + " /"))
+                    || (storage.isNotEmpty() && !v.name.endsWith("/ " + storage));
+            }),
+            config.variants.end());
+
+        try
+        {
+            std::cout << ScalingBench::format(config, ScalingBench::run(config));
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+    }
+
+    /**
+     * @brief "faults": counts minor page faults during the first callbacks.
+     *
+     * The input is generated and the frozen grid finished before counting
+     * starts, so every fault counted is taken inside Reverb::process.
+     */
+    void runFaults(const juce::ArgumentList& args)
+    {
+        const double fs = numberOption(args, "--fs", 48000.0);
+        const int blockSize = static_cast<int>(numberOption(args, "--block", 512.0));
+        const int callbacks = static_cast<int>(numberOption(args, "--callbacks", 100.0));
+        const auto maxFaults = static_cast<int64_t>(numberOption(args, "--max-faults", 0.0));
+        if (blockSize < 1 || callbacks < 1)
+            juce::ConsoleApplication::fail("--block and --callbacks must be positive");
+
+        auto options = parseOptions(args);
+        options.lockMemory = args.containsOption("--lock");
+        const auto parameters = parseParameters(args);
+
+        if (EngineMemory::getMinorPageFaults() < 0)
+            juce::ConsoleApplication::fail("Page fault counters are not available on this platform");
+
+        Reverb reverb(static_cast<float>(fs), blockSize, options);
+        reverb.waitForFrozenGrid();
+
+        juce::AudioBuffer<float> input(2, blockSize * callbacks);
+        juce::Random random(1);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int n = 0; n < input.getNumSamples(); ++n)
+                input.setSample(ch, n, random.nextFloat() * 0.5f - 0.25f);
+
+        std::vector<int64_t> faults(static_cast<size_t>(callbacks), 0);
+        for (int i = 0; i < callbacks; ++i)
+        {
+            juce::AudioBuffer<float> block(input.getArrayOfWritePointers(), 2, i * blockSize, blockSize);
+            const auto before = EngineMemory::getMinorPageFaults();
+            reverb.process(block, parameters);
+            faults[static_cast<size_t>(i)] = EngineMemory::getMinorPageFaults() - before;
+        }
+
+        const auto& memory = reverb.getMemoryStats();
+        std::cout << "Engine memory: " << memory.bytes / 1024 << " KB in " << memory.regions << " regions, "
+                  << memory.pages << " pages prefaulted";
+        if (options.lockMemory)
+            std::cout << ", " << memory.lockedBytes / 1024 << " KB locked"
+                      << (memory.lockFailed ? " (RLIMIT_MEMLOCK reached, rest only prefaulted)" : "");
+        std::cout << "\n";
+
+        int64_t total = 0;
+        for (int i = 0; i < callbacks; ++i)
+        {
+            total += faults[static_cast<size_t>(i)];
+            if (faults[static_cast<size_t>(i)] > 0)
+                std::cout << "  callback " << i << ": " << faults[static_cast<size_t>(i)] << " minor faults\n";
+        }
+        std::cout << total << " minor page faults in " << callbacks << " callbacks of " << blockSize << " samples\n";
+
+        if (total > maxFaults)
+            juce::ConsoleApplication::fail("Page faults on the audio path", 1);
+    }
+
+    /**
+     * @brief "autotune": benchmarks diffuser thread counts.
+     *
+     * Prints every candidate and, unless --no-save is given, stores the
+     * winner where the plugin loads it at prepare time.
+     */
+    void runAutotune(const juce::ArgumentList& args)
+    {
+        Autotuner::Config config;
+        config.fs = numberOption(args, "--fs", config.fs);
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.seconds = numberOption(args, "--seconds", config.seconds);
+        config.options = parseOptions(args);
+
+        if (args.containsOption("--threads"))
+        {
+            for (const auto& count : juce::StringArray::fromTokens(args.getValueForOption("--threads"), ",", ""))
+                if (count.getIntValue() > 0)
+                    config.threadCounts.push_back(count.getIntValue());
+            if (config.threadCounts.empty())
+                juce::ConsoleApplication::fail("Invalid --threads (use e.g. --threads=1,2,4)");
+        }
+
+        Autotuner::Result result;
+        try
+        {
+            result = Autotuner::run(config);
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+
+        std::cout << "Machine: " << result.machine << "\n"
+                  << "Host block " << config.blockSize << " at " << config.fs << " Hz, "
+                  << config.seconds << " s per candidate\n\n"
+                  << "  threads   mean us    p99 us\n";
+        for (const auto& c : result.candidates)
+            std::cout << juce::String(c.diffuserThreads).paddedLeft(' ', 9)
+                      << juce::String(c.meanMicros, 1).paddedLeft(' ', 10)
+                      << juce::String(c.p99Micros, 1).paddedLeft(' ', 10)
+                      << (c.diffuserThreads == result.best.diffuserThreads ? "  <- best" : "")
+                      << "\n";
+
+        if (args.containsOption("--no-save"))
+            return;
+        if (!Autotuner::save(result))
+            juce::ConsoleApplication::fail("Could not write the autotune settings");
+        std::cout << "\nSaved for this machine.\n";
+    }
+
+    /**
+     * @brief "sweep": renders one input through a parameter grid in parallel.
+     */
+    void runSweep(const juce::ArgumentList& args)
+    {
+        if (args.size() < 3)
+            juce::ConsoleApplication::fail("Usage: sweep <input.wav> <output-directory> [options]");
+
+        SweepRenderer::Config config;
+        config.input = args[1].resolveAsExistingFile();
+        config.outputDirectory = args[2].resolveAsFile();
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.bitDepth = static_cast<int>(numberOption(args, "--bits", config.bitDepth));
+        config.tailSeconds = numberOption(args, "--tail", config.tailSeconds);
+        config.rt60Seconds = numberOption(args, "--rt60-seconds", config.rt60Seconds);
+        config.threads = static_cast<int>(numberOption(args, "--threads", config.threads));
+        config.writeAudio = !args.containsOption("--no-audio");
+        config.options = parseOptions(args);
+        config.base = parseParameters(args);
+
+        config.grid.roomSize = valueList(args, "--rooms", config.base.roomSize);
+        config.grid.dampening = valueList(args, "--dampings", config.base.dampening);
+        config.grid.lowPass = valueList(args, "--lowpasses", config.base.lowPass);
+        config.grid.highPass = valueList(args, "--highpasses", config.base.highPass);
+        config.grid.initialDelay = valueList(args, "--predelays", config.base.initialDelay);
+
+        SweepRenderer::Summary summary;
+        try
+        {
+            summary = SweepRenderer::run(config);
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+
+        std::cout << summary.renders.size() << " renders of " << summary.inputSamples << " samples at "
+                  << summary.sampleRate << " Hz on " << summary.threads << " threads (seed " << summary.seed << "), "
+                  << summary.seconds << " s including " << summary.decodeSeconds << " s decoding\n\n"
+                  << "  index    room   damping   lowpass  highpass  predelay    rt60  energy dB  peak dB     cpu s  x realtime\n";
+        for (const auto& r : summary.renders)
+            std::cout << juce::String(r.index).paddedLeft(' ', 7)
+                      << juce::String(r.parameters.roomSize, 2).paddedLeft(' ', 8)
+                      << juce::String(r.parameters.dampening, 0).paddedLeft(' ', 10)
+                      << juce::String(r.parameters.lowPass, 0).paddedLeft(' ', 10)
+                      << juce::String(r.parameters.highPass, 0).paddedLeft(' ', 10)
+                      << juce::String(r.parameters.initialDelay, 3).paddedLeft(' ', 10)
+                      << juce::String(r.rt60, 2).paddedLeft(' ', 8)
+                      << juce::String(r.energyDb, 1).paddedLeft(' ', 11)
+                      << juce::String(r.peakDb, 1).paddedLeft(' ', 9)
+                      << juce::String(r.cpuSeconds, 3).paddedLeft(' ', 10)
+                      << juce::String(r.realtime, 1).paddedLeft(' ', 12)
+                      << "\n";
+        std::cout << "\nMetrics written to " << config.outputDirectory.getChildFile("sweep.csv").getFullPathName() << "\n";
+    }
+
+    /**
+     * @brief "determinism": bitwise comparison of every execution path.
+     */
+    void runDeterminism(const juce::ArgumentList& args)
+    {
+        DeterminismCheck::Config config;
+        config.fs = numberOption(args, "--fs", config.fs);
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.seconds = numberOption(args, "--seconds", config.seconds);
+        config.maxThreads = static_cast<int>(numberOption(args, "--threads", config.maxThreads));
+        config.options = parseOptions(args);
+        config.parameters = parseParameters(args);
+        if (config.options.seed != 0)
+            config.seed = config.options.seed;
+
+        // Half wet by default, so the automation runs the dry-mixing kernels too
+        if (!args.containsOption("--mix"))
+            config.parameters.mix = 0.5f;
+
+        const auto engine = args.getValueForOption("--engine");
+        if (engine.isNotEmpty())
+            config.engines = { config.options.d1Engine };
+
+        DeterminismCheck::Result result;
+        try
+        {
+            result = DeterminismCheck::run(config);
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+
+        std::cout << DeterminismCheck::format(config, result);
+        if (!result.passed)
+            juce::ConsoleApplication::fail("Output depends on the execution path", 1);
+    }
+    /**
+     * @brief "serve": runs the reverb service until SIGINT / SIGTERM (or --seconds).
+     */
+    void runServe(const juce::ArgumentList& args)
+    {
+        if (!args.containsOption("--socket"))
+            juce::ConsoleApplication::fail("Usage: serve --socket=PATH [options]");
+
+        ReverbService::Config config;
+        config.socket = args.getFileForOption("--socket");
+        config.engines = static_cast<int>(numberOption(args, "--engines", config.engines));
+        config.workers = static_cast<int>(numberOption(args, "--workers", config.workers));
+        config.fs = numberOption(args, "--fs", config.fs);
+        config.blockSize = static_cast<int>(numberOption(args, "--block", config.blockSize));
+        config.seconds = numberOption(args, "--seconds", config.seconds);
+        config.options = parseOptions(args);
+
+        std::cout << "Serving " << config.engines << " engines on " << config.socket.getFullPathName()
+                  << " (" << config.workers << " workers, " << config.fs << " Hz, block " << config.blockSize << ")\n"
+                  << std::flush;
+
+        ReverbService::Stats stats;
+        try
+        {
+            stats = ReverbService::run(config);
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+
+        const double audioSeconds = static_cast<double>(stats.frames) / config.fs;
+        std::cout << stats.sessions << " sessions (" << stats.refused << " refused), "
+                  << stats.rejectedSettings << " settings rejected, " << stats.jobs << " jobs, "
+                  << audioSeconds << " s of audio in " << stats.seconds << " s\n"
+                  << stats.deadlineMisses << " deadline misses, worst " << stats.worstLatenessMs << " ms late\n";
+    }
+
+    /**
+     * @brief "remote": streams a WAV file through a running service.
+     *
+     * Keeps the input ring as full as the service lets it and drains the
+     * output as it appears; the output is written from this thread.
+     */
+    void runRemote(const juce::ArgumentList& args)
+    {
+        if (args.size() < 3 || !args.containsOption("--socket"))
+            juce::ConsoleApplication::fail("Usage: remote <input.wav> <output.wav> --socket=PATH [options]");
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+        std::signal(SIGPIPE, SIG_IGN); // A service that goes away is reported, not fatal
+#endif
+
+        const auto parameters = parseParameters(args);
+        ServiceSettings settings;
+        settings.mix = parameters.mix;
+        settings.stereoWidth = parameters.stereoWidth;
+        settings.lowPass = parameters.lowPass;
+        settings.highPass = parameters.highPass;
+        settings.dampening = parameters.dampening;
+        settings.roomSize = parameters.roomSize;
+        settings.initialDelay = parameters.initialDelay;
+        settings.outputGain = parameters.outputGain;
+
+        constexpr int chunkSize = 4096;
+        const auto outputFile = args[2].resolveAsFile();
+        const int bitDepth = static_cast<int>(numberOption(args, "--bits", 24.0));
+
+        try
+        {
+            MappedWavReader reader(args[1].resolveAsExistingFile());
+            const int numChannels = juce::jmin(2, reader.getNumChannels());
+            const int64_t total = reader.getLengthInSamples()
+                + static_cast<int64_t>(numberOption(args, "--tail", 2.0) * reader.getSampleRate());
+
+            ServiceClient client(args.getValueForOption("--socket").toStdString(), numChannels, reader.getSampleRate(),
+                static_cast<int>(numberOption(args, "--capacity", 16384.0)), numberOption(args, "--deadline", 20.0), settings);
+
+            auto stream = outputFile.createOutputStream();
+            if (stream == nullptr || !stream->openedOk())
+                throw std::runtime_error("Cannot open " + outputFile.getFullPathName().toStdString());
+            stream->setPosition(0);
+            stream->truncate();
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wav.createWriterFor(stream.get(), reader.getSampleRate(), static_cast<unsigned int>(numChannels), bitDepth, {}, 0));
+            if (writer == nullptr)
+                throw std::runtime_error("Cannot create a WAV writer for " + outputFile.getFullPathName().toStdString());
+            stream.release(); // now owned by the writer
+
+            juce::AudioBuffer<float> staged(2, chunkSize), received(2, chunkSize);
+            int stagedStart = 0, stagedEnd = 0;
+            int64_t sent = 0, done = 0;
+            const double start = juce::Time::getMillisecondCounterHiRes();
+
+            while (done < total)
+            {
+                // Refill the staging block: input first, then silence for the tail
+                if (stagedStart == stagedEnd && sent < total)
+                {
+                    stagedStart = 0;
+                    stagedEnd = reader.read(staged, chunkSize);
+                    if (stagedEnd == 0)
+                    {
+                        stagedEnd = static_cast<int>(juce::jmin<int64_t>(total - sent, chunkSize));
+                        staged.clear();
+                    }
+                }
+
+                if (stagedStart < stagedEnd)
+                {
+                    const float* channels[2] = { staged.getReadPointer(0, stagedStart), staged.getReadPointer(1, stagedStart) };
+                    const int accepted = client.write(channels, stagedEnd - stagedStart);
+                    stagedStart += accepted;
+                    sent += accepted;
+                }
+
+                const int count = client.read(received.getArrayOfWritePointers(), chunkSize);
+                if (count > 0)
+                {
+                    writer->writeFromFloatArrays(received.getArrayOfReadPointers(), numChannels, count);
+                    done += count;
+                }
+                else if (!client.waitForOutput(5000))
+                {
+                    throw std::runtime_error("Reverb service stopped responding");
+                }
+            }
+
+            const double seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+            const double audioSeconds = static_cast<double>(done) / reader.getSampleRate();
+            std::cout << done << " samples (" << audioSeconds << " s) through the service in " << seconds << " s, "
+                      << audioSeconds / juce::jmax(1.0e-9, seconds) << "x realtime (service block "
+                      << client.getBlockSize() << ")\n";
+        }
+        catch (const std::exception& e)
+        {
+            juce::ConsoleApplication::fail(e.what());
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Umbra command line tools", true);
+
+    app.addCommand({ "bench",
+        "bench [--seed=N] [--seconds=S] [--fs=HZ] [--block=N] [--engine=dvn|shared|allpass] "
+        "[--storage=float|fp16|bf16] [--early] [--frozen[=RxD]] [--ir-seconds=S] "
+        "[--room=X] [--damping=HZ] [--predelay=S]",
+        "Compares the optimized engine against the frozen scalar reference",
+        "Renders one impulse response through both engines with the same topology seed, "
+        "compares energy decay, octave-band T60, echo density and spectrum against "
+        "tolerances, and reports the render time of both. Exits with 1 on failure.",
+        runBench });
+
+    app.addCommand({ "check",
+        "check [--only=GROUP,...]",
+        "Runs deterministic pass/fail checks of engine components",
+        "Checks each component against fixed limits with fixed inputs and seeds, so the "
+        "verdict is the same on every machine. Groups: " + SelfCheck::getGroups().joinIntoString(", ")
+        + " (default all). Exits with 1 on failure.",
+        runCheck });
+
+    app.addCommand({ "render",
+        "render <input.wav> <output.wav> [--tail=S] [--bits=16|24|32] [--chunk=N] [--block=N] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--seed=N] "
+        "[--deterministic] [--frozen[=RxD]] [--ir-seconds=S] "
+        "[--room=X] [--damping=HZ] [--predelay=S] [--mix=X] [--width=X] [--gain=X] "
+        "[--lowpass=HZ] [--highpass=HZ] [--automation=FILE] "
+        "[--checkpoint=FILE] [--checkpoint-every=S] [--resume=FILE] [--stop-at=S]",
+        "Streams a WAV / RF64 file through the reverb",
+        "Reads the input through a memory map, processes it in fixed chunks and writes "
+        "through a background writer, so memory use does not grow with the file length. "
+        "--frozen renders an R x D grid of tail responses over room size and damping "
+        "first (default 3x3) and convolves instead of running the live tail. "
+        "--checkpoint saves the render position and engine state every --checkpoint-every "
+        "seconds of audio (default 60) and at the end; --resume continues from such a file "
+        "into a new output holding the rest of the render, bit-exact with an uninterrupted "
+        "job. --stop-at ends the job early, e.g. to hand the render to another machine. "
+        "--fdn16 replaces the two 8-line FDNs with one 16-line FDN whose absorption filters "
+        "follow --decay (T60 below and above the damping frequency, default 6,2 seconds). "
+        "--matrix picks the FDN feedback matrix (default hadamard). "
+        "--automation reads breakpoint curves (JSON: parameter name -> [[seconds, value], ...]) "
+        "that override the constant value of their parameters, evaluated per control block.",
+        runRender });
+
+    app.addCommand({ "scale",
+        "scale [--instances=1,2,4,...] [--threads=T] [--block=N] [--seconds=S] [--fs=HZ] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--frozen[=RxD]] "
+        "[--room=X] [--damping=HZ]",
+        "Measures throughput and cache contention as the instance count grows",
+        "Runs N reverbs on T pinned worker threads in lockstep rounds and reports aggregate "
+        "throughput, mean and p99 callback time against the block budget, and the LLC miss "
+        "rate (Linux perf counters). Runs every engine and storage format unless "
+        "--engine / --storage select one.",
+        runScale });
+
+    app.addCommand({ "faults",
+        "faults [--callbacks=N] [--block=N] [--fs=HZ] [--lock] [--max-faults=N] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--seed=N] "
+        "[--frozen[=RxD]] [--ir-seconds=S] [--room=X] [--damping=HZ] [--predelay=S]",
+        "Counts page faults taken during the first callbacks",
+        "Builds the reverb (prefaulting its memory, and locking it with --lock), then "
+        "processes N callbacks of noise and counts the minor page faults inside each. "
+        "Exits with 1 if the total exceeds --max-faults (default 0).",
+        runFaults });
+
+    app.addCommand({ "autotune",
+        "autotune [--block=N] [--fs=HZ] [--seconds=S] [--threads=1,2,4,...] [--no-save] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early]",
+        "Finds the fastest diffuser thread count for this machine",
+        "Renders automated noise through every OpenMP thread count of the DVN diffusers, "
+        "reports mean and p99 callback times, and stores the lowest-p99 candidate in the "
+        "per-user settings the plugin loads at prepare time (keyed by CPU model and core "
+        "count). The plugin never runs this itself.",
+        runAutotune });
+
+    app.addCommand({ "sweep",
+        "sweep <input.wav> <output-directory> [--rooms=LIST] [--dampings=LIST] [--lowpasses=LIST] "
+        "[--highpasses=LIST] [--predelays=LIST] [--threads=T] [--tail=S] [--rt60-seconds=S] "
+        "[--no-audio] [--bits=16|24|32] [--block=N] [--engine=dvn|shared|allpass] "
+        "[--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--seed=N] [--deterministic] [--frozen[=RxD]] "
+        "[--ir-seconds=S] [--room=X] [--damping=HZ] [--lowpass=HZ] [--highpass=HZ] [--predelay=S] "
+        "[--mix=X] [--width=X] [--gain=X]",
+        "Renders one input through every combination of a parameter grid in parallel",
+        "Decodes the input once, then renders each grid point on a pool of T workers (default "
+        "one per CPU), each reusing one engine through an allocation-free reset. A LIST is "
+        "a,b,c or lo:hi:n; unswept parameters take their single-value option. Writes one WAV "
+        "per point (unless --no-audio) and sweep.csv with the wet RT60, output energy relative "
+        "to the input, peak level and CPU time of every render.",
+        runSweep });
+
+    app.addCommand({ "determinism",
+        "determinism [--threads=N] [--seconds=S] [--fs=HZ] [--block=N] [--seed=N] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--frozen[=RxD]] "
+        "[--ir-seconds=S] [--room=X] [--damping=HZ] [--mix=X]",
+        "Checks that deterministic mode gives identical bits on every execution path",
+        "Renders seeded noise with automation through each diffuser engine in deterministic "
+        "mode: single-threaded, with 2..N diffuser threads (DVN), with metering, after "
+        "Reverb::reset() and rebuilt. Every render must match the single-threaded one bit "
+        "for bit. The reference digest can be compared across machines running the same "
+        "build (same compiler, flags and target instruction set); other builds may round "
+        "differently. Exits with 1 on any difference.",
+        runDeterminism });
+
+    app.addCommand({ "serve",
+        "serve --socket=PATH [--engines=N] [--workers=T] [--fs=HZ] [--block=N] [--seconds=S] "
+        "[--engine=dvn|shared|allpass] [--storage=float|fp16|bf16] [--early] [--fdn16] [--decay=LOW[,HIGH]] [--matrix=hadamard|householder|velvet] [--seed=N] "
+        "[--deterministic] [--frozen[=RxD]] [--ir-seconds=S]",
+        "Runs a local reverb service for other processes",
+        "Builds a pool of N engines (default 4) and listens on a Unix socket. Each client "
+        "(see ServiceClient, or the remote command) holds one engine and exchanges audio "
+        "through lock-free rings in shared memory; T worker threads (default 2) process "
+        "blocks earliest deadline first. Parameter changes and resets from clients are "
+        "ramped in without rebuilding the engine. Runs until SIGINT / SIGTERM or for "
+        "--seconds, then prints session, job and deadline-miss counts.",
+        runServe });
+
+    app.addCommand({ "remote",
+        "remote <input.wav> <output.wav> --socket=PATH [--tail=S] [--bits=16|24|32] [--capacity=N] "
+        "[--deadline=MS] [--room=X] [--damping=HZ] [--lowpass=HZ] [--highpass=HZ] [--predelay=S] "
+        "[--mix=X] [--width=X] [--gain=X]",
+        "Streams a WAV / RF64 file through a running reverb service",
+        "Opens a session with the service on PATH (ring of --capacity frames, default 16384, "
+        "and a --deadline budget in milliseconds, default 20), streams the input plus --tail "
+        "seconds of silence through it and writes the result. The file's sample rate must "
+        "match the service's.",
+        runRemote });
+
+    return app.findAndRunCommand(juce::ArgumentList(argc, argv));
+}
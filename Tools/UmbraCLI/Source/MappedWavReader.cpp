@@ -0,0 +1,203 @@
+#include "MappedWavReader.h"
+#include <cstring>
+#include <stdexcept>
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <sys/mman.h>
+ #include <unistd.h>
+ #define UMBRA_HAS_MADVISE 1
+#else
+ #define UMBRA_HAS_MADVISE 0
+#endif
+
+namespace
+{
+    constexpr int64_t adviceWindowBytes = 8 << 20; ///< Prefetch / release granularity
+
+    constexpr uint16_t formatPcm = 0x0001;
+    constexpr uint16_t formatFloat = 0x0003;
+    constexpr uint16_t formatExtensible = 0xFFFE;
+
+    bool hasTag(const uint8_t* p, const char* tag)
+    {
+        return std::memcmp(p, tag, 4) == 0;
+    }
+
+    /**
+     * @brief Converts interleaved little-endian frames to non-interleaved float.
+     */
+    template <typename SampleType>
+    void deinterleave(const uint8_t* source, int numSourceChannels,
+        float* const* destination, int numDestChannels, int numSamples)
+    {
+        using SourceFormat = juce::AudioData::Format<SampleType, juce::AudioData::LittleEndian>;
+        using DestFormat = juce::AudioData::Format<juce::AudioData::Float32, juce::AudioData::NativeEndian>;
+
+        juce::AudioData::deinterleaveSamples(
+            juce::AudioData::InterleavedSource<SourceFormat>{ source, numSourceChannels },
+            juce::AudioData::NonInterleavedDest<DestFormat>{ destination, numDestChannels },
+            numSamples);
+    }
+}
+
+/**
+ * @brief Maps the file, parses the header and advises sequential access.
+ *
+ * @param file WAV, RF64 or BW64 file.
+ * @throws std::runtime_error if the file cannot be mapped or is not a
+ *         supported uncompressed WAV.
+ */
+MappedWavReader::MappedWavReader(const juce::File& file)
+    : map(std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly))
+{
+    if (map->getData() == nullptr)
+        throw std::runtime_error("Cannot map " + file.getFullPathName().toStdString());
+
+    base = static_cast<const uint8_t*>(map->getData());
+    fileSize = static_cast<int64_t>(map->getSize());
+
+    parseHeader();
+
+#if UMBRA_HAS_MADVISE
+    madvise(const_cast<uint8_t*>(base), static_cast<size_t>(fileSize), MADV_SEQUENTIAL);
+#endif
+    adviseWindow();
+}
+
+/**
+ * @brief Walks the chunk list.
+ *
+ * RIFF chunk sizes are 32-bit; in RF64/BW64 files the data chunk size is
+ * 0xFFFFFFFF and the real 64-bit size comes from the ds64 chunk. Chunks are
+ * padded to an even length. A data chunk running past the end of the file
+ * (truncated recording) is clamped to whole frames.
+ *
+ * @throws std::runtime_error on a malformed or unsupported file.
+ */
+void MappedWavReader::parseHeader()
+{
+    if (fileSize < 12 || !hasTag(base + 8, "WAVE")
+        || !(hasTag(base, "RIFF") || hasTag(base, "RF64") || hasTag(base, "BW64")))
+        throw std::runtime_error("Not a WAV file");
+
+    int64_t ds64DataSize = -1;
+    int64_t dataSize = -1;
+    int bitsPerSample = 0;
+    uint16_t formatTag = 0;
+
+    int64_t offset = 12;
+    while (offset + 8 <= fileSize && dataSize < 0)
+    {
+        const uint8_t* chunk = base + offset;
+        const int64_t size = static_cast<int64_t>(juce::ByteOrder::littleEndianInt(chunk + 4));
+        const uint8_t* body = chunk + 8;
+
+        if (hasTag(chunk, "ds64") && size >= 16)
+        {
+            ds64DataSize = static_cast<int64_t>(juce::ByteOrder::littleEndianInt64(body + 8));
+        }
+        else if (hasTag(chunk, "fmt ") && size >= 16)
+        {
+            formatTag = juce::ByteOrder::littleEndianShort(body);
+            numChannels = juce::ByteOrder::littleEndianShort(body + 2);
+            sampleRate = static_cast<double>(juce::ByteOrder::littleEndianInt(body + 4));
+            frameBytes = juce::ByteOrder::littleEndianShort(body + 12);
+            bitsPerSample = juce::ByteOrder::littleEndianShort(body + 14);
+
+            // Extensible: the real format tag leads the subformat GUID
+            if (formatTag == formatExtensible && size >= 40)
+                formatTag = juce::ByteOrder::littleEndianShort(body + 24);
+        }
+        else if (hasTag(chunk, "data"))
+        {
+            dataOffset = offset + 8;
+            dataSize = (size == 0xFFFFFFFF && ds64DataSize >= 0) ? ds64DataSize : size;
+        }
+
+        offset += 8 + size + (size & 1);
+    }
+
+    if (dataSize < 0 || numChannels <= 0 || frameBytes <= 0 || sampleRate <= 0.0)
+        throw std::runtime_error("WAV file has no fmt or data chunk");
+
+    if (formatTag == formatPcm && bitsPerSample == 16)
+        encoding = Encoding::Int16;
+    else if (formatTag == formatPcm && bitsPerSample == 24)
+        encoding = Encoding::Int24;
+    else if (formatTag == formatPcm && bitsPerSample == 32)
+        encoding = Encoding::Int32;
+    else if (formatTag == formatFloat && bitsPerSample == 32)
+        encoding = Encoding::Float32;
+    else
+        throw std::runtime_error("Unsupported WAV sample format (use 16/24/32-bit PCM or 32-bit float)");
+
+    if (frameBytes != numChannels * bitsPerSample / 8)
+        throw std::runtime_error("WAV block alignment does not match the channel count");
+
+    dataSize = juce::jmin(dataSize, fileSize - dataOffset);
+    lengthInSamples = dataSize / frameBytes;
+}
+
+/**
+ * @brief Converts the next frames straight from the mapping.
+ */
+int MappedWavReader::read(juce::AudioBuffer<float>& destination, int numSamples)
+{
+    const int count = static_cast<int>(juce::jmin<int64_t>(numSamples, getRemainingSamples()));
+    if (count <= 0)
+        return 0;
+
+    const uint8_t* source = base + dataOffset + position * frameBytes;
+    float* const* channels = destination.getArrayOfWritePointers();
+    const int numDest = juce::jmin(numChannels, destination.getNumChannels());
+
+    // Extra file channels are skipped; the interleaved stride stays numChannels
+    switch (encoding)
+    {
+        case Encoding::Int16:   deinterleave<juce::AudioData::Int16>(source, numChannels, channels, numDest, count); break;
+        case Encoding::Int24:   deinterleave<juce::AudioData::Int24>(source, numChannels, channels, numDest, count); break;
+        case Encoding::Int32:   deinterleave<juce::AudioData::Int32>(source, numChannels, channels, numDest, count); break;
+        case Encoding::Float32: deinterleave<juce::AudioData::Float32>(source, numChannels, channels, numDest, count); break;
+    }
+
+    position += count;
+    adviseWindow();
+    return count;
+}
+
+/**
+ * @brief Advances the position; the skipped pages are never touched.
+ */
+void MappedWavReader::skip(int64_t numSamples)
+{
+    position += juce::jlimit<int64_t>(0, getRemainingSamples(), numSamples);
+    adviseWindow();
+}
+
+/**
+ * @brief Keeps one window prefetched ahead and drops whole windows behind.
+ *
+ * Released pages belong to a read-only file mapping, so dropping them only
+ * discards the process's reference; the page cache decides what to keep.
+ */
+void MappedWavReader::adviseWindow()
+{
+#if UMBRA_HAS_MADVISE
+    static const int64_t pageSize = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+
+    const int64_t consumed = dataOffset + position * frameBytes;
+    const int64_t ahead = juce::jmin(adviceWindowBytes, fileSize - consumed);
+    if (ahead > 0)
+    {
+        const int64_t start = consumed - consumed % pageSize;
+        madvise(const_cast<uint8_t*>(base + start), static_cast<size_t>(consumed - start + ahead), MADV_WILLNEED);
+    }
+
+    const int64_t releasable = consumed - consumed % pageSize;
+    if (releasable - releasedBytes >= adviceWindowBytes)
+    {
+        madvise(const_cast<uint8_t*>(base + releasedBytes), static_cast<size_t>(releasable - releasedBytes), MADV_DONTNEED);
+        releasedBytes = releasable;
+    }
+#endif
+}
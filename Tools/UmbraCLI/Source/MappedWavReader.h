@@ -0,0 +1,108 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <memory>
+
+// JUCE
+#include <JuceHeader.h>
+
+/**
+ * @class MappedWavReader
+ * @brief Sequential reader for uncompressed WAV / RF64 files through a memory map.
+ *
+ * The whole file is mapped once (address space only). Reads walk the data
+ * chunk front to back:
+ * - the mapping is advised sequential, so the kernel reads ahead while the
+ *   caller runs DSP on the previous chunk;
+ * - the next window is prefetched as each chunk is read;
+ * - pages already consumed are released, so resident memory stays at a few
+ *   windows regardless of file length.
+ *
+ * Supported sample formats: 16/24/32-bit PCM and 32-bit float, plain or
+ * WAVE_FORMAT_EXTENSIBLE. The advice calls are POSIX only; elsewhere the
+ * reader relies on the OS default read-ahead.
+ */
+class MappedWavReader
+{
+public:
+    /**
+     * @brief Maps a file and parses its header.
+     * @param file WAV, RF64 or BW64 file.
+     * @throws std::runtime_error if the file cannot be mapped or is not a
+     *         supported uncompressed WAV.
+     */
+    explicit MappedWavReader(const juce::File& file);
+
+    /** @brief Destructor. Unmaps the file. */
+    ~MappedWavReader() = default;
+
+    // Copy operations: deleted, the reader owns the mapping
+    MappedWavReader(const MappedWavReader&) = delete;
+    MappedWavReader& operator=(const MappedWavReader&) = delete;
+
+    /** @brief Sample rate in Hz. */
+    double getSampleRate() const { return sampleRate; }
+
+    /** @brief Number of channels in the file. */
+    int getNumChannels() const { return numChannels; }
+
+    /** @brief Total length in sample frames. */
+    int64_t getLengthInSamples() const { return lengthInSamples; }
+
+    /** @brief Sample frames not yet read. */
+    int64_t getRemainingSamples() const { return lengthInSamples - position; }
+
+    /**
+     * @brief Reads the next frames, deinterleaved and converted to float.
+     * @param destination Receives min(numSamples, remaining) frames starting at
+     *        sample 0; channels beyond the file's count are left untouched.
+     * @param numSamples Frames requested (must fit in destination).
+     * @return Frames actually read (0 at the end of the file).
+     */
+    int read(juce::AudioBuffer<float>& destination, int numSamples);
+
+    /**
+     * @brief Moves the read position forward without converting anything.
+     * @param numSamples Frames to skip (clamped to the remaining frames).
+     */
+    void skip(int64_t numSamples);
+
+private:
+    /**
+     * @brief Sample encoding of the data chunk.
+     */
+    enum class Encoding
+    {
+        Int16,
+        Int24,
+        Int32,
+        Float32
+    };
+
+    /**
+     * @brief Walks the RIFF / RF64 chunk list and fills in the format fields.
+     * @throws std::runtime_error on a malformed or unsupported file.
+     */
+    void parseHeader();
+
+    /**
+     * @brief Prefetches the window ahead of the read position and releases
+     *        the pages behind it (POSIX only).
+     */
+    void adviseWindow();
+
+    std::unique_ptr<juce::MemoryMappedFile> map; ///< Whole-file read-only mapping
+    const uint8_t* base = nullptr;               ///< Start of the mapping
+    int64_t fileSize = 0;                        ///< Mapped length in bytes
+
+    int64_t dataOffset = 0;      ///< Byte offset of the first sample frame
+    int64_t lengthInSamples = 0; ///< Number of sample frames
+    int64_t position = 0;        ///< Next frame to read
+    int64_t releasedBytes = 0;   ///< Bytes from the start already released
+
+    double sampleRate = 0.0; ///< Sample rate in Hz
+    int numChannels = 0;     ///< Interleaved channel count
+    int frameBytes = 0;      ///< Bytes per sample frame
+    Encoding encoding = Encoding::Int16; ///< Sample encoding
+};
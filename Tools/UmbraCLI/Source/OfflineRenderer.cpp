@@ -0,0 +1,223 @@
+#include "OfflineRenderer.h"
+#include "MappedWavReader.h"
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr char checkpointMagic[4] = { 'U', 'M', 'B', 'C' }; ///< Checkpoint file tag
+
+    /**
+     * @struct CheckpointHeader
+     * @brief Render position and settings stored in front of the engine state.
+     */
+    struct CheckpointHeader
+    {
+        char magic[4] = {};       ///< "UMBC"
+        uint32_t seed = 0;        ///< Topology seed (the resumed engine is built with it)
+        int32_t blockSize = 0;    ///< Reverb block size
+        int32_t chunkSize = 0;    ///< Chunk size (sets where process() calls start)
+        int64_t inputSamples = 0; ///< Length of the input file in frames
+        int64_t position = 0;     ///< Frames rendered so far (input, then tail)
+    };
+}
+
+/**
+ * @brief Streams the input through the reverb.
+ *
+ * Steps:
+ * 1. Load the resume checkpoint, if any (its seed replaces a seed of 0),
+ *    map the input and open the output writer behind a two-chunk FIFO.
+ *    In frozen mode, wait for the reverb's IR grid. When resuming, restore
+ *    the engine state and skip the input to the checkpoint position.
+ * 2. Per chunk: read (mono is duplicated) or, past the input, use silence
+ *    for the tail; Reverb::process, or with automation, evaluate the curves
+ *    for the chunk's control blocks and Reverb::processAutomation; queue
+ *    for writing. Chunks stay on the
+ *    same grid as an uninterrupted job, so every process() call sees the
+ *    same blocks.
+ * 3. Every checkpointSeconds of rendered time, and when the job ends, the
+ *    position and engine state are written to the checkpoint file (replaced
+ *    atomically, so a crash leaves the previous checkpoint intact).
+ * 4. Leaving the scope destroys the threaded writer, which flushes the FIFO
+ *    and finalizes the header before the job time is taken.
+ *
+ * @param config Files and settings.
+ * @return Sample counts and timings.
+ * @throws std::runtime_error if the input cannot be read, the output or a
+ *         checkpoint cannot be written, or the resume checkpoint cannot be
+ *         read or belongs to another input, block or chunk size.
+ * @throws std::invalid_argument if the chunk size, block size or bit depth is
+ *         invalid, or the checkpoint's engine state does not match the options.
+ */
+OfflineRenderer::Stats OfflineRenderer::render(const Config& config)
+{
+    if (config.chunkSize < 1 || config.blockSize < 1)
+        throw std::invalid_argument("Chunk and block size must be positive.");
+    if (config.bitDepth != 16 && config.bitDepth != 24 && config.bitDepth != 32)
+        throw std::invalid_argument("Bit depth must be 16, 24 or 32.");
+
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    Stats stats;
+
+    // Step 1: resume checkpoint, input mapping and output writer
+    ReverbOptions options = config.options;
+    juce::MemoryBlock resumed;
+    CheckpointHeader resumeHeader;
+    if (config.resume != juce::File())
+    {
+        if (!config.resume.loadFileAsData(resumed) || resumed.getSize() < sizeof(CheckpointHeader))
+            throw std::runtime_error("Cannot read checkpoint " + config.resume.getFullPathName().toStdString());
+
+        std::memcpy(&resumeHeader, resumed.getData(), sizeof(CheckpointHeader));
+        if (std::memcmp(resumeHeader.magic, checkpointMagic, sizeof(checkpointMagic)) != 0)
+            throw std::runtime_error(config.resume.getFullPathName().toStdString() + " is not a render checkpoint");
+        if (resumeHeader.blockSize != config.blockSize || resumeHeader.chunkSize != config.chunkSize)
+            throw std::runtime_error("Checkpoint was written with --block=" + std::to_string(resumeHeader.blockSize)
+                + " --chunk=" + std::to_string(resumeHeader.chunkSize));
+
+        if (options.seed == 0)
+            options.seed = resumeHeader.seed;
+    }
+
+    MappedWavReader reader(config.input);
+    stats.sampleRate = reader.getSampleRate();
+
+    const int64_t inputLength = reader.getLengthInSamples();
+    const int64_t total = inputLength + static_cast<int64_t>(config.tailSeconds * stats.sampleRate);
+    const int64_t end = config.stopSeconds > 0.0
+        ? juce::jmin(total, static_cast<int64_t>(config.stopSeconds * stats.sampleRate))
+        : total;
+
+    if (config.resume != juce::File() && resumeHeader.inputSamples != inputLength)
+        throw std::runtime_error("Checkpoint was written for an input of " + std::to_string(resumeHeader.inputSamples) + " frames");
+
+    auto stream = config.output.createOutputStream();
+    if (stream == nullptr || !stream->openedOk())
+        throw std::runtime_error("Cannot open " + config.output.getFullPathName().toStdString());
+    stream->setPosition(0);
+    stream->truncate();
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(stream.get(), stats.sampleRate, 2, config.bitDepth, {}, 0));
+    if (writer == nullptr)
+        throw std::runtime_error("Cannot create a WAV writer for " + config.output.getFullPathName().toStdString());
+    stream.release(); // now owned by the writer
+
+    {
+        // Declared before the threaded writer so it outlives the final flush
+        juce::TimeSliceThread writerThread("Umbra writer");
+        writerThread.startThread();
+        juce::AudioFormatWriter::ThreadedWriter output(writer.release(), writerThread, 2 * config.chunkSize);
+
+        Reverb reverb(static_cast<float>(stats.sampleRate), config.blockSize, options);
+
+        // Frozen mode: finish the IR grid first, so the output does not depend on thread timing
+        const double gridStart = juce::Time::getMillisecondCounterHiRes();
+        reverb.waitForFrozenGrid();
+        stats.gridSeconds = (juce::Time::getMillisecondCounterHiRes() - gridStart) * 0.001;
+        juce::AudioBuffer<float> chunk(2, config.chunkSize);
+
+        // Automation: one parameter set per control block of a chunk, allocated once
+        const bool automated = !config.automation.isEmpty();
+        const int controlStep = reverb.getMicroBlockSize();
+        std::vector<ReverbParameters> points;
+        if (automated)
+            points.resize(static_cast<size_t>((config.chunkSize + controlStep - 1) / controlStep));
+
+        int64_t position = 0;
+        if (config.resume != juce::File())
+        {
+            reverb.restoreState(static_cast<const char*>(resumed.getData()) + sizeof(CheckpointHeader),
+                resumed.getSize() - sizeof(CheckpointHeader));
+            position = resumeHeader.position;
+            reader.skip(juce::jmin(position, inputLength));
+        }
+        stats.startSample = position;
+
+        // Checkpoint buffer, allocated once
+        const bool checkpointing = config.checkpoint != juce::File();
+        juce::MemoryBlock checkpoint;
+        if (checkpointing)
+            checkpoint.setSize(sizeof(CheckpointHeader) + reverb.getStateSize());
+
+        const auto interval = juce::jmax<int64_t>(1, static_cast<int64_t>(config.checkpointSeconds * stats.sampleRate));
+        int64_t nextCheckpoint = position + interval;
+
+        auto saveCheckpoint = [&]()
+        {
+            CheckpointHeader header;
+            std::memcpy(header.magic, checkpointMagic, sizeof(checkpointMagic));
+            header.seed = reverb.getSeed();
+            header.blockSize = config.blockSize;
+            header.chunkSize = config.chunkSize;
+            header.inputSamples = inputLength;
+            header.position = position;
+
+            std::memcpy(checkpoint.getData(), &header, sizeof(CheckpointHeader));
+            reverb.saveState(static_cast<char*>(checkpoint.getData()) + sizeof(CheckpointHeader),
+                checkpoint.getSize() - sizeof(CheckpointHeader));
+
+            if (!config.checkpoint.replaceWithData(checkpoint.getData(), checkpoint.getSize()))
+                throw std::runtime_error("Cannot write checkpoint " + config.checkpoint.getFullPathName().toStdString());
+            ++stats.checkpoints;
+        };
+
+        auto queue = [&](int numSamples)
+        {
+            const double waitStart = juce::Time::getMillisecondCounterHiRes();
+            while (!output.write(chunk.getArrayOfReadPointers(), numSamples))
+                juce::Thread::sleep(1);
+            stats.writerWaitSeconds += (juce::Time::getMillisecondCounterHiRes() - waitStart) * 0.001;
+            stats.outputSamples += numSamples;
+        };
+
+        // Step 2: input, then tail
+        while (position < end)
+        {
+            int numSamples = 0;
+            if (position < inputLength)
+            {
+                numSamples = reader.read(chunk, config.chunkSize);
+                if (reader.getNumChannels() == 1)
+                    chunk.copyFrom(1, 0, chunk, 0, 0, numSamples);
+                stats.inputSamples += numSamples;
+            }
+            else
+            {
+                numSamples = static_cast<int>(juce::jmin<int64_t>(total - position, config.chunkSize));
+                chunk.clear();
+            }
+
+            juce::AudioBuffer<float> view(chunk.getArrayOfWritePointers(), 2, numSamples);
+            if (automated)
+            {
+                config.automation.evaluateBlocks(config.parameters, stats.sampleRate, position,
+                    numSamples, controlStep, points.data());
+                reverb.processAutomation(view, points.data(), static_cast<int>(points.size()));
+            }
+            else
+            {
+                reverb.process(view, config.parameters);
+            }
+            queue(numSamples);
+            position += numSamples;
+
+            if (checkpointing && position >= nextCheckpoint && position < end)
+            {
+                saveCheckpoint();
+                nextCheckpoint = position + interval;
+            }
+        }
+
+        if (checkpointing)
+            saveCheckpoint();
+        stats.endSample = position;
+    }
+
+    stats.seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+    return stats;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+#include "Automation.h"
+
+/**
+ * @class OfflineRenderer
+ * @brief Streams a WAV file through the reverb into another WAV file.
+ *
+ * Memory per job is constant in the file length:
+ * - input is read through MappedWavReader (sequential mmap, consumed pages
+ *   released);
+ * - audio is processed in fixed chunks with Reverb::process, or with
+ *   Reverb::processAutomation when parameters follow breakpoint curves
+ *   (evaluated per control block, chunk by chunk);
+ * - output goes through a juce::AudioFormatWriter::ThreadedWriter whose
+ *   FIFO holds two chunks, so encoding and disk writes of one chunk overlap
+ *   the DSP of the next.
+ *
+ * The output is stereo at the input's sample rate; mono input feeds both
+ * channels, extra input channels are ignored. The WAV writer switches to
+ * RF64 by itself once the output passes 4 GB.
+ *
+ * Long jobs can write checkpoints: the render position followed by the
+ * engine state (Reverb::saveState). A job resumed from a checkpoint renders
+ * from that position on into its own output file, bit for bit what the
+ * original job would have written there. Stopping a job early with a final
+ * checkpoint hands a render over to another machine in segments.
+ * Automation curves are evaluated from the absolute render position, so a
+ * resumed job continues them where the checkpoint left off.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class OfflineRenderer
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    OfflineRenderer() = delete;
+
+    /**
+     * @struct Config
+     * @brief One render job.
+     */
+    struct Config
+    {
+        juce::File input;            ///< Uncompressed WAV / RF64 input
+        juce::File output;           ///< WAV output (overwritten)
+        int blockSize = 512;         ///< Reverb block size
+        int chunkSize = 16384;       ///< Samples read, processed and queued per step
+        int bitDepth = 24;           ///< Output bit depth (16, 24 or 32)
+        double tailSeconds = 0.0;    ///< Silence rendered after the input ends
+        ReverbOptions options;       ///< Engine options
+        ReverbParameters parameters; ///< Constant parameter values
+        Automation automation;       ///< Curves over render time for some parameters (empty = all constant)
+
+        juce::File checkpoint;           ///< Written every checkpointSeconds and when the job ends (none if unset)
+        double checkpointSeconds = 60.0; ///< Rendered time between checkpoints
+        juce::File resume;               ///< Checkpoint to continue from (start at frame 0 if unset)
+        double stopSeconds = 0.0;        ///< Stop at the first chunk boundary past this render time (0 = run to the end)
+    };
+
+    /**
+     * @struct Stats
+     * @brief Outcome of one render.
+     */
+    struct Stats
+    {
+        double sampleRate = 0.0;     ///< Input (and output) sample rate
+        int64_t inputSamples = 0;    ///< Frames read from the input
+        int64_t outputSamples = 0;   ///< Frames written, tail included
+        double seconds = 0.0;        ///< Wall-clock time of the job
+        double writerWaitSeconds = 0.0; ///< Time spent waiting for FIFO space (I/O bound)
+        double gridSeconds = 0.0;    ///< Time spent rendering the frozen IR grid (frozen mode)
+        int64_t startSample = 0;     ///< Render position the job started at (non-zero when resumed)
+        int64_t endSample = 0;       ///< Render position the job stopped at
+        int checkpoints = 0;         ///< Checkpoints written
+    };
+
+    /**
+     * @brief Runs one job.
+     * @param config Files and settings.
+     * @return Sample counts and timings.
+     * @throws std::runtime_error if the input cannot be read, the output or
+     *         a checkpoint cannot be written, or the resume checkpoint cannot
+     *         be read or belongs to another input, block or chunk size.
+     * @throws std::invalid_argument if the chunk size, block size or bit depth
+     *         is invalid, or the checkpoint's engine state does not match the options.
+     */
+    static Stats render(const Config& config);
+};
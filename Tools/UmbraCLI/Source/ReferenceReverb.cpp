@@ -0,0 +1,307 @@
+#include "ReferenceReverb.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    // Frozen copies of the engine's construction constants
+    constexpr int numChannels = 8;
+    constexpr int dvnPulses = 200;
+    constexpr int dvnDensity = 2000;
+    constexpr double rrsEpsilon = 1.0 / 4096.0;
+}
+
+/**
+ * @brief Regenerates every stage's topology from the seed.
+ *
+ * Uses the same generators, in the same order, as Diffuser/DVNConvolver and
+ * FDN, with stage seeds from Reverb::stageSeed.
+ *
+ * @param fs Sample rate in Hz.
+ * @param seed Topology seed.
+ * @throws std::invalid_argument if fs <= 0 or seed == 0.
+ */
+ReferenceReverb::ReferenceReverb(double fs, uint32_t seed)
+    : fs(fs)
+{
+    if (fs <= 0.0)
+        throw std::invalid_argument("Sample rate must be positive");
+    if (seed == 0)
+        throw std::invalid_argument("The reference needs an explicit (non-zero) topology seed");
+
+    for (uint32_t stage = 1; stage <= 3; ++stage)
+    {
+        std::mt19937 channelSeeds(Reverb::stageSeed(seed, stage));
+        std::vector<DVNTopology> channels;
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels.push_back(makeDVN(channelSeeds(), dvnPulses, dvnDensity, fs));
+        diffusers.push_back(std::move(channels));
+    }
+
+    const int m = static_cast<int>(0.1f * static_cast<float>(fs));
+    for (uint32_t stage = 4; stage <= 5; ++stage)
+        fdns.push_back(makeFDN(Reverb::stageSeed(seed, stage), numChannels, m));
+}
+
+/**
+ * @brief Same draw sequence as DVNConvolver's constructor.
+ */
+ReferenceReverb::DVNTopology ReferenceReverb::makeDVN(uint32_t seed, int M, int p, double fs)
+{
+    DVNTopology t;
+    const int Td = static_cast<int>(fs / static_cast<double>(p));
+    t.wmin = Td / 2;
+    t.wmax = Td;
+    t.k.resize(M);
+    t.w.resize(M);
+    t.s.resize(M);
+
+    juce::Random rng(static_cast<juce::int64>(seed));
+    for (int m = 0; m < M; ++m)
+    {
+        const float r1 = rng.nextFloat();
+        const float r2 = rng.nextFloat();
+        const float r3 = rng.nextFloat();
+
+        t.w[m] = static_cast<int>(std::round(r1 * (t.wmax - t.wmin) + t.wmin));
+        t.k[m] = static_cast<int>(std::round(m * Td + r2 * (Td - t.w[m])));
+        t.s[m] = 2 * static_cast<int>(std::round(r3)) - 1;
+    }
+
+    t.norm = 1.0 / std::pow(static_cast<double>(M * (t.wmax - t.wmin + 1)), 19.0 / 30.0);
+    return t;
+}
+
+/**
+ * @brief Same draw sequence as FDN's constructor.
+ */
+ReferenceReverb::FDNTopology ReferenceReverb::makeFDN(uint32_t seed, int N, int m)
+{
+    FDNTopology t;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> jitter(1.0f, 2.0f);
+    std::uniform_real_distribution<float> gain(0.8f, 0.9f);
+
+    t.M.assign(N, 0);
+    for (int i = 1; i < N; ++i)
+        t.M[i] = static_cast<int>(std::round(m * jitter(gen)));
+
+    t.g.resize(N);
+    for (int i = 0; i < N; ++i)
+        t.g[i] = gain(gen);
+
+    return t;
+}
+
+/**
+ * @brief Butterworth biquad, coefficients as in juce::IIRCoefficients.
+ */
+void ReferenceReverb::butterworth(Signal& x, double fs, double cutoff, bool highPass)
+{
+    const double root2 = std::sqrt(2.0);
+    const double n = highPass ? std::tan(juce::MathConstants<double>::pi * cutoff / fs)
+                              : 1.0 / std::tan(juce::MathConstants<double>::pi * cutoff / fs);
+    const double nSquared = n * n;
+    const double c1 = 1.0 / (1.0 + root2 * n + nSquared);
+
+    const double b0 = c1;
+    const double b1 = highPass ? -2.0 * c1 : 2.0 * c1;
+    const double b2 = c1;
+    const double a1 = highPass ? c1 * 2.0 * (nSquared - 1.0) : c1 * 2.0 * (1.0 - nSquared);
+    const double a2 = c1 * (1.0 - root2 * n + nSquared);
+
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    for (double& sample : x)
+    {
+        const double y = b0 * sample + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = sample;
+        y2 = y1;
+        y1 = y;
+        sample = y;
+    }
+}
+
+/**
+ * @brief DVN convolution: pulses grouped by width, each group through its RRS filter.
+ *
+ * Per group of width W:
+ *   u[n] = sum of s_m * x[n - k_m]
+ *   v[n] = u[n] - (1 - eps)^W * u[n - W - 1] + (1 - eps) * v[n - 2]
+ * and y[n] = norm * sum over groups of v[n].
+ */
+ReferenceReverb::Signal ReferenceReverb::dvn(const Signal& x, const DVNTopology& topology)
+{
+    const int length = static_cast<int>(x.size());
+    Signal y(length, 0.0);
+    Signal u(length), v(length);
+
+    for (int W = topology.wmin; W <= topology.wmax; ++W)
+    {
+        const double epsilonM = std::pow(1.0 - rrsEpsilon, static_cast<double>(W));
+
+        std::vector<size_t> group;
+        for (size_t m = 0; m < topology.k.size(); ++m)
+            if (topology.w[m] == W)
+                group.push_back(m);
+
+        for (int n = 0; n < length; ++n)
+        {
+            double sum = 0.0;
+            for (size_t m : group)
+                if (n - topology.k[m] >= 0)
+                    sum += topology.s[m] * x[n - topology.k[m]];
+            u[n] = sum;
+
+            const double uM = n - W - 1 >= 0 ? u[n - W - 1] : 0.0;
+            const double v2 = n - 2 >= 0 ? v[n - 2] : 0.0;
+            v[n] = u[n] - epsilonM * uM + (1.0 - rrsEpsilon) * v2;
+            y[n] += v[n];
+        }
+    }
+
+    for (double& sample : y)
+        sample *= topology.norm;
+
+    return y;
+}
+
+/**
+ * @brief FDN recursion over whole signals.
+ *
+ * For every sample:
+ * 1. out[i] = w_i[n - 1 - tau_i], tau_i = int(M_i * roomSize), where w_i is
+ *    everything written to line i so far; out is the FDN output.
+ * 2. Normalized Hadamard transform of out.
+ * 3. w_i[n] = x_i[n] + g_i * H_i(out_i), H = Butterworth low-pass at the damping cutoff.
+ */
+void ReferenceReverb::fdn(std::vector<Signal>& x, const FDNTopology& topology, double fs,
+    double dampening, float roomSize)
+{
+    const int N = static_cast<int>(x.size());
+    const int length = static_cast<int>(x[0].size());
+
+    const double n0 = 1.0 / std::tan(juce::MathConstants<double>::pi * dampening / fs);
+    const double nSquared = n0 * n0;
+    const double root2 = std::sqrt(2.0);
+    const double c1 = 1.0 / (1.0 + root2 * n0 + nSquared);
+    const double b0 = c1, b1 = 2.0 * c1, b2 = c1;
+    const double a1 = c1 * 2.0 * (1.0 - nSquared);
+    const double a2 = c1 * (1.0 - root2 * n0 + nSquared);
+
+    std::vector<Signal> written(N, Signal(length, 0.0));
+    std::vector<int> tau(N);
+    for (int i = 0; i < N; ++i)
+        tau[i] = static_cast<int>(topology.M[i] * roomSize);
+
+    std::vector<double> in(N), out(N), x1(N, 0.0), x2(N, 0.0), y1(N, 0.0), y2(N, 0.0);
+    const double scale = 1.0 / std::sqrt(static_cast<double>(N));
+
+    for (int n = 0; n < length; ++n)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            const int read = n - 1 - tau[i];
+            out[i] = read >= 0 ? written[i][read] : 0.0;
+        }
+
+        for (int i = 0; i < N; ++i)
+        {
+            in[i] = x[i][n];
+            x[i][n] = out[i];
+        }
+
+        // Hadamard (Sylvester order), normalized
+        for (int len = 1; len < N; len <<= 1)
+            for (int i = 0; i < N; i += len << 1)
+                for (int j = 0; j < len; ++j)
+                {
+                    const double a = out[i + j];
+                    const double b = out[i + j + len];
+                    out[i + j] = a + b;
+                    out[i + j + len] = a - b;
+                }
+
+        for (int i = 0; i < N; ++i)
+        {
+            const double mixed = out[i] * scale;
+            const double damped = b0 * mixed + b1 * x1[i] + b2 * x2[i] - a1 * y1[i] - a2 * y2[i];
+            x2[i] = x1[i];
+            x1[i] = mixed;
+            y2[i] = y1[i];
+            y1[i] = damped;
+
+            written[i][n] = in[i] + topology.g[i] * damped;
+        }
+    }
+}
+
+/**
+ * @brief Renders the full chain.
+ *
+ * input filters -> pre-delay -> upmix to 8 -> d1 -> fdn1 -> d2 -> fdn2 -> d3
+ * -> width (M/S) -> mix with the unfiltered dry input -> output gain.
+ *
+ * @param input Input signal (1 or 2 channels).
+ * @param output Receives the output.
+ * @param params Constant parameter values.
+ */
+void ReferenceReverb::render(const juce::AudioBuffer<float>& input,
+    juce::AudioBuffer<float>& output,
+    const ReverbParameters& params) const
+{
+    const int inputChannels = juce::jmin(input.getNumChannels(), 2);
+    const int length = input.getNumSamples();
+    output.setSize(input.getNumChannels(), length);
+    if (inputChannels < 1 || length == 0)
+        return;
+
+    // Input filters and pre-delay (x[n - 1 - tau], as the shipped per-sample loop)
+    std::vector<Signal> wet;
+    const int tau = juce::jlimit(0, static_cast<int>(0.1 * fs), static_cast<int>(params.initialDelay * static_cast<float>(fs)));
+    for (int ch = 0; ch < inputChannels; ++ch)
+    {
+        Signal x(input.getReadPointer(ch), input.getReadPointer(ch) + length);
+        butterworth(x, fs, params.highPass, true);
+        butterworth(x, fs, params.lowPass, false);
+
+        Signal delayed(length, 0.0);
+        for (int n = tau + 1; n < length; ++n)
+            delayed[n] = x[n - tau - 1];
+        wet.push_back(std::move(delayed));
+    }
+
+    // Upmix: extra channels repeat the last input channel
+    while (static_cast<int>(wet.size()) < numChannels)
+        wet.push_back(wet.back());
+
+    // Chain
+    for (int ch = 0; ch < numChannels; ++ch)
+        wet[ch] = dvn(wet[ch], diffusers[0][ch]);
+    fdn(wet, fdns[0], fs, params.dampening, params.roomSize);
+    for (int ch = 0; ch < numChannels; ++ch)
+        wet[ch] = dvn(wet[ch], diffusers[1][ch]);
+    fdn(wet, fdns[1], fs, params.dampening, params.roomSize);
+    for (int ch = 0; ch < numChannels; ++ch)
+        wet[ch] = dvn(wet[ch], diffusers[2][ch]);
+
+    // Width, mix and gain
+    const double wetGain = params.outputGain * params.mix;
+    const double dryGain = params.outputGain * (1.0 - params.mix);
+    for (int n = 0; n < length; ++n)
+    {
+        if (input.getNumChannels() >= 2)
+        {
+            const double mid = 0.5 * (wet[0][n] + wet[1][n]);
+            const double side = 0.5 * params.stereoWidth * (wet[0][n] - wet[1][n]);
+            output.setSample(0, n, static_cast<float>(wetGain * (mid + side) + dryGain * input.getSample(0, n)));
+            output.setSample(1, n, static_cast<float>(wetGain * (mid - side) + dryGain * input.getSample(1, n)));
+        }
+        else
+        {
+            output.setSample(0, n, static_cast<float>(wetGain * wet[0][n] + dryGain * input.getSample(0, n)));
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class ReferenceReverb
+ * @brief Frozen scalar reference of the default Reverb chain, in double precision.
+ *
+ * Renders the same algorithm as Reverb with its default options (DVN
+ * diffusers, 8-line Hadamard FDNs, float32 delay lines) for a given topology
+ * seed, written as plainly as possible: every stage runs over the whole
+ * signal, one sample at a time, with no block reads, no SIMD and no shared
+ * code with the optimized engine beyond the topology generation.
+ *
+ * Indexing follows the shipped DelayLine sample API: readSample(tau) before
+ * writeSample() returns x[n - tau - 1]. This is what the engine does today,
+ * so the reference matches it rather than an idealized textbook form.
+ *
+ * This file must not change when kernels are optimized; it is the baseline
+ * the equivalence bench compares against. Parameters are constant for the
+ * whole render.
+ */
+class ReferenceReverb
+{
+public:
+    /**
+     * @brief Constructs the reference for one topology.
+     * @param fs Sample rate in Hz.
+     * @param seed Topology seed (as passed in ReverbOptions::seed).
+     * @throws std::invalid_argument if fs <= 0 or seed == 0.
+     */
+    ReferenceReverb(double fs, uint32_t seed);
+
+    /**
+     * @brief Renders a whole signal through the reference chain.
+     * @param input Input signal (1 or 2 channels).
+     * @param output Receives the output (same channel count and length as input).
+     * @param params Parameter values, constant for the whole render.
+     */
+    void render(const juce::AudioBuffer<float>& input,
+        juce::AudioBuffer<float>& output,
+        const ReverbParameters& params) const;
+
+private:
+    using Signal = std::vector<double>;
+
+    /**
+     * @struct DVNTopology
+     * @brief Pulse sequence of one DVN convolver.
+     */
+    struct DVNTopology
+    {
+        int wmin = 0;           ///< Minimum pulse width
+        int wmax = 0;           ///< Maximum pulse width
+        double norm = 1.0;      ///< Output normalization
+        std::vector<int> k;     ///< Pulse positions
+        std::vector<int> w;     ///< Pulse widths
+        std::vector<int> s;     ///< Pulse signs
+    };
+
+    /**
+     * @struct FDNTopology
+     * @brief Delay lengths and gains of one FDN.
+     */
+    struct FDNTopology
+    {
+        std::vector<int> M;      ///< Base delay lengths (line 0 is the zero-length dummy)
+        std::vector<double> g;   ///< Feedback gains
+    };
+
+    /** @brief Regenerates the DVN pulse sequence for one seed. */
+    static DVNTopology makeDVN(uint32_t seed, int M, int p, double fs);
+
+    /** @brief Regenerates the FDN delays and gains for one seed. */
+    static FDNTopology makeFDN(uint32_t seed, int N, int m);
+
+    /** @brief 2nd-order Butterworth (Q = 1/sqrt 2) biquad filter in direct form I. */
+    static void butterworth(Signal& x, double fs, double cutoff, bool highPass);
+
+    /** @brief DVN convolution of one channel. */
+    static Signal dvn(const Signal& x, const DVNTopology& topology);
+
+    /** @brief Per-sample FDN recursion over all channels. */
+    static void fdn(std::vector<Signal>& x, const FDNTopology& topology, double fs,
+        double dampening, float roomSize);
+
+    double fs = 0.0;                               ///< Sample rate in Hz
+    std::vector<std::vector<DVNTopology>> diffusers; ///< [stage][channel] pulse sequences
+    std::vector<FDNTopology> fdns;                 ///< FDN topologies
+};
@@ -0,0 +1,800 @@
+#include "ReverbService.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <signal.h>
+ #include <sys/mman.h>
+ #include <sys/socket.h>
+ #include <sys/stat.h>
+ #include <sys/un.h>
+ #include <unistd.h>
+ #define UMBRA_HAS_SERVICE 1
+#else
+ #define UMBRA_HAS_SERVICE 0
+#endif
+
+namespace
+{
+    std::atomic<bool> stopRequested { false }; ///< Set by requestStop()
+    std::atomic<int> stopPipe { -1 };          ///< Write end of the dispatcher's self-pipe (-1 when not running)
+
+    /**
+     * @brief Clamps a client value to a range; non-finite values take the default.
+     */
+    float sanitize(float value, float lo, float hi, float fallback)
+    {
+        return std::isfinite(value) ? juce::jlimit(lo, hi, value) : fallback;
+    }
+
+    /**
+     * @brief True if every value of a client's settings is finite.
+     */
+    bool isFinite(const ServiceSettings& settings)
+    {
+        for (const float value : { settings.mix, settings.stereoWidth, settings.lowPass, settings.highPass,
+                 settings.dampening, settings.roomSize, settings.initialDelay, settings.outputGain })
+            if (!std::isfinite(value))
+                return false;
+        return true;
+    }
+}
+
+/**
+ * @brief Clamps every field to the plugin's parameter ranges (gain to +12 dB).
+ */
+ReverbParameters ReverbService::toParameters(const ServiceSettings& settings)
+{
+    const ReverbParameters defaults;
+    ReverbParameters p;
+    p.mix = sanitize(settings.mix, 0.0f, 1.0f, defaults.mix);
+    p.stereoWidth = sanitize(settings.stereoWidth, 0.0f, 2.0f, defaults.stereoWidth);
+    p.lowPass = sanitize(settings.lowPass, 20.0f, 20000.0f, defaults.lowPass);
+    p.highPass = sanitize(settings.highPass, 20.0f, 20000.0f, defaults.highPass);
+    p.dampening = sanitize(settings.dampening, 20.0f, 20000.0f, defaults.dampening);
+    p.roomSize = sanitize(settings.roomSize, 0.1f, 2.0f, defaults.roomSize);
+    p.initialDelay = sanitize(settings.initialDelay, 0.0f, 0.1f, defaults.initialDelay);
+    p.outputGain = sanitize(settings.outputGain, 0.0f, 4.0f, defaults.outputGain);
+    return p;
+}
+
+/**
+ * @brief Sets the stop flag and wakes the dispatcher through its self-pipe.
+ */
+void ReverbService::requestStop()
+{
+    stopRequested.store(true);
+#if UMBRA_HAS_SERVICE
+    const int fd = stopPipe.load();
+    if (fd >= 0)
+    {
+        const char byte = 1;
+        (void) !::write(fd, &byte, 1);
+    }
+#endif
+}
+
+#if UMBRA_HAS_SERVICE
+namespace
+{
+    /**
+     * @brief Closes a descriptor if it is open and marks it closed.
+     */
+    void closeDescriptor(int& fd)
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    /**
+     * @brief Reads and discards everything pending on a non-blocking descriptor.
+     */
+    void drain(int fd)
+    {
+        char bytes[64];
+        while (::read(fd, bytes, sizeof(bytes)) > 0)
+        {
+        }
+    }
+
+    /**
+     * @brief One byte on a wake pipe; a full pipe already holds a pending wake-up.
+     */
+    void wake(int fd)
+    {
+        const char byte = 1;
+        (void) !::write(fd, &byte, 1);
+    }
+
+    void signalHandler(int)
+    {
+        ReverbService::requestStop();
+    }
+
+    /**
+     * @struct Session
+     * @brief One pool slot: an engine and, while a client holds it, the client's
+     *        descriptors, mapping and scheduling state.
+     *
+     * The dispatcher owns the descriptors and the mapping and only releases
+     * them when no job is queued or running. Fields marked "scheduler" are
+     * only touched under the scheduler lock.
+     */
+    struct Session
+    {
+        std::unique_ptr<Reverb> engine; ///< Pool engine (built once)
+        bool active = false;            ///< Held by a client (dispatcher)
+        bool welcomed = false;          ///< Hello accepted (dispatcher)
+
+        int socket = -1;                ///< Control connection
+        int wakeIn = -1;                ///< Read end of the client's wake pipe
+        int wakeOut = -1;               ///< Write end of the pipe that wakes the client
+        void* shared = nullptr;         ///< Mapped region
+        size_t sharedBytes = 0;         ///< Size of the mapping
+        int numChannels = 0;            ///< Ring channels (1 or 2)
+        ServiceRing input;              ///< Client to service
+        ServiceRing output;             ///< Service to client
+        int64_t budgetTicks = 0;        ///< Deadline budget in high-resolution ticks
+
+        ServiceProtocol::Message message; ///< Record being received (dispatcher)
+        size_t received = 0;              ///< Bytes of message so far (dispatcher)
+        int descriptors[3] = { -1, -1, -1 }; ///< Descriptors attached to the Hello (dispatcher)
+        int numDescriptors = 0;              ///< Entries in descriptors
+
+        // Scheduler
+        ReverbParameters current;       ///< Values at the end of the last job
+        ReverbParameters target;        ///< Values the next job ramps to
+        bool resetPending = false;      ///< Clear the engine before the next job
+        bool queued = false;            ///< In the job heap
+        bool running = false;           ///< Being processed by a worker
+        bool closing = false;           ///< Client gone; release when idle
+        int64_t deadline = 0;           ///< Deadline of the queued job (ticks)
+    };
+
+    /**
+     * @class Scheduler
+     * @brief Earliest-deadline-first job heap shared by the dispatcher and the workers.
+     *
+     * Every session is in the heap at most once, so reserving one entry per
+     * engine keeps pushes allocation-free.
+     */
+    class Scheduler
+    {
+    public:
+        explicit Scheduler(int capacity) { heap.reserve(static_cast<size_t>(capacity)); }
+
+        std::mutex lock;                   ///< Guards the heap and the scheduler fields of every session
+        std::condition_variable available; ///< Signalled on push and stop
+
+        /**
+         * @brief Queues a session unless it is already queued or running (caller holds lock).
+         *
+         * A running session is not queued twice: its worker checks the rings
+         * under the lock when it finishes and requeues it itself.
+         */
+        void push(Session& session, int64_t deadline)
+        {
+            if (session.queued || session.running || session.closing)
+                return;
+            session.queued = true;
+            session.deadline = deadline;
+            heap.push_back(&session);
+            std::push_heap(heap.begin(), heap.end(), later);
+            available.notify_one();
+        }
+
+        /**
+         * @brief Waits for the most urgent session and marks it running.
+         * @return The session, or nullptr once stopping.
+         */
+        Session* pop(std::unique_lock<std::mutex>& held)
+        {
+            available.wait(held, [this] { return stopping || !heap.empty(); });
+            if (stopping)
+                return nullptr;
+
+            std::pop_heap(heap.begin(), heap.end(), later);
+            Session* session = heap.back();
+            heap.pop_back();
+            session->queued = false;
+            session->running = true;
+            return session;
+        }
+
+        /**
+         * @brief Wakes every worker and makes pop() return nullptr.
+         */
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> held(lock);
+                stopping = true;
+            }
+            available.notify_all();
+        }
+
+    private:
+        static bool later(const Session* a, const Session* b) { return a->deadline > b->deadline; }
+
+        std::vector<Session*> heap; ///< Min-heap on deadline
+        bool stopping = false;      ///< Set by stop()
+    };
+
+    /**
+     * @struct Counters
+     * @brief Totals the workers add to (under the scheduler lock).
+     */
+    struct Counters
+    {
+        int64_t jobs = 0;
+        int64_t frames = 0;
+        int64_t deadlineMisses = 0;
+        int64_t worstLatenessTicks = 0;
+    };
+
+    /**
+     * @class Worker
+     * @brief Processing thread: runs the most urgent job, one block at a time.
+     *
+     * Its scratch buffer is allocated once; a job only copies between the
+     * rings and that buffer and runs the engine.
+     */
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(int index, Scheduler& scheduler, Counters& counters, double fs, int blockSize, int notify)
+            : juce::Thread("Umbra service " + juce::String(index)),
+            scheduler(scheduler), counters(counters), blockSize(blockSize), notify(notify),
+            ticksPerFrame(static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / fs),
+            scratch(2, blockSize)
+        {
+        }
+
+        ~Worker() override { stopThread(-1); }
+
+        void run() override
+        {
+            std::unique_lock<std::mutex> held(scheduler.lock);
+            while (Session* session = scheduler.pop(held))
+            {
+                // Take the pending settings and reset with the job
+                const ReverbParameters start = session->current;
+                const ReverbParameters end = session->target;
+                const bool reset = session->resetPending;
+                const bool closing = session->closing;
+                const int64_t deadline = session->deadline;
+                session->current = end;
+                session->resetPending = false;
+                held.unlock();
+
+                const int frames = closing ? 0 : process(*session, start, end, reset);
+                const int64_t now = juce::Time::getHighResolutionTicks();
+
+                held.lock();
+                session->running = false;
+                if (frames > 0)
+                {
+                    ++counters.jobs;
+                    counters.frames += frames;
+                    if (now > deadline)
+                    {
+                        ++counters.deadlineMisses;
+                        counters.worstLatenessTicks = juce::jmax(counters.worstLatenessTicks, now - deadline);
+                    }
+                }
+
+                if (session->closing)
+                    wake(notify); // Dispatcher releases the session
+                else if (session->input.getNumReady() > 0 && session->output.getNumFree() > 0)
+                    scheduler.push(*session, deadline + static_cast<int64_t>(frames * ticksPerFrame)); // Backlog: due one block later
+            }
+        }
+
+    private:
+        /**
+         * @brief Runs one block of a session through its engine.
+         * @return Frames processed.
+         */
+        int process(Session& session, const ReverbParameters& start, const ReverbParameters& end, bool reset)
+        {
+            if (reset)
+                session.engine->reset();
+
+            const int frames = juce::jmin(blockSize, session.input.getNumReady(), session.output.getNumFree());
+            if (frames <= 0)
+                return 0;
+
+            session.input.read(scratch.getArrayOfWritePointers(), frames);
+            if (session.numChannels == 1)
+                scratch.copyFrom(1, 0, scratch, 0, 0, frames);
+
+            juce::AudioBuffer<float> block(scratch.getArrayOfWritePointers(), 2, frames);
+            session.engine->processRamp(block, start, end);
+
+            session.output.write(scratch.getArrayOfReadPointers(), frames); // Mono clients get the left channel
+            wake(session.wakeOut);
+            return frames;
+        }
+
+        Scheduler& scheduler;
+        Counters& counters;
+        const int blockSize;
+        const int notify;                  ///< Dispatcher self-pipe
+        const double ticksPerFrame;        ///< Real-time duration of one frame
+        juce::AudioBuffer<float> scratch;  ///< Stereo block
+    };
+
+    /**
+     * @brief Sends one record (short control messages; a failed send closes the session later).
+     */
+    void sendMessage(int socket, const ServiceProtocol::Message& message)
+    {
+        size_t sent = 0;
+        while (sent < sizeof(message))
+        {
+            const ssize_t n = ::send(socket, reinterpret_cast<const char*>(&message) + sent, sizeof(message) - sent, 0);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return;
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    /**
+     * @brief Sends an Error record with a reason.
+     */
+    void sendError(int socket, const char* reason)
+    {
+        ServiceProtocol::Message message;
+        message.type = ServiceProtocol::Message::Type::Error;
+        std::strncpy(message.error, reason, sizeof(message.error) - 1);
+        sendMessage(socket, message);
+    }
+
+    /**
+     * @brief Validates a Hello and attaches the client's region and pipes.
+     * @return Null on success, otherwise the reason to send back.
+     */
+    const char* accept(Session& session, const ReverbService::Config& config)
+    {
+        const auto& hello = session.message;
+        if (hello.type != ServiceProtocol::Message::Type::Hello)
+            return "Expected Hello";
+        if (hello.version != ServiceProtocol::version)
+            return "Protocol version mismatch";
+        if (session.numDescriptors != 3)
+            return "Hello must carry three descriptors";
+        if (hello.numChannels < 1 || hello.numChannels > static_cast<uint32_t>(ServiceProtocol::maxChannels))
+            return "Channel count must be 1 or 2";
+        if (!juce::isPowerOfTwo(hello.capacity) || hello.capacity < static_cast<uint32_t>(config.blockSize)
+            || hello.capacity > static_cast<uint32_t>(ServiceProtocol::maxCapacity))
+            return "Ring capacity must be a power of two between the block size and the maximum";
+        if (hello.sampleRate != config.fs)
+            return "Sample rate does not match the service";
+        if (!isFinite(hello.settings))
+            return "Settings must be finite";
+
+        const int memory = session.descriptors[0];
+        const int numChannels = static_cast<int>(hello.numChannels);
+        const int capacity = static_cast<int>(hello.capacity);
+        const size_t bytes = ServiceProtocol::getSharedBytes(numChannels, capacity);
+
+        struct stat info {};
+        if (::fstat(memory, &info) != 0 || static_cast<size_t>(info.st_size) != bytes)
+            return "Shared region has the wrong size";
+
+        void* shared = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+        if (shared == MAP_FAILED)
+            return "Cannot map the shared region";
+
+        const auto* layout = static_cast<const ServiceProtocol::Layout*>(shared);
+        if (layout->magic != ServiceProtocol::magic || layout->version != ServiceProtocol::version
+            || layout->numChannels != hello.numChannels || layout->capacity != hello.capacity)
+        {
+            ::munmap(shared, bytes);
+            return "Shared region layout does not match the Hello";
+        }
+
+        session.shared = shared;
+        session.sharedBytes = bytes;
+        session.numChannels = numChannels;
+        session.input = ServiceProtocol::getInput(shared);
+        session.output = ServiceProtocol::getOutput(shared);
+        session.budgetTicks = static_cast<int64_t>(hello.deadlineMicroseconds * 1.0e-6
+            * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()));
+
+        closeDescriptor(session.descriptors[0]);
+        session.wakeIn = session.descriptors[1];
+        session.wakeOut = session.descriptors[2];
+        session.descriptors[1] = session.descriptors[2] = -1;
+        session.numDescriptors = 0;
+        ::fcntl(session.wakeIn, F_SETFL, O_NONBLOCK);
+        ::fcntl(session.wakeOut, F_SETFL, O_NONBLOCK);
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns an idle session's engine to the pool (dispatcher only).
+     */
+    void release(Session& session)
+    {
+        closeDescriptor(session.socket);
+        closeDescriptor(session.wakeIn);
+        closeDescriptor(session.wakeOut);
+        for (auto& fd : session.descriptors)
+            closeDescriptor(fd);
+        if (session.shared != nullptr)
+            ::munmap(session.shared, session.sharedBytes);
+
+        session.engine->reset();
+        session.shared = nullptr;
+        session.sharedBytes = 0;
+        session.input = {};
+        session.output = {};
+        session.numDescriptors = 0;
+        session.received = 0;
+        session.active = false;
+        session.welcomed = false;
+        session.closing = false;
+        session.resetPending = false;
+    }
+
+    /**
+     * @brief Reads from a session socket, collecting attached descriptors.
+     * @return False if the client closed the connection or sent garbage.
+     */
+    bool receive(Session& session)
+    {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 3)];
+        iovec vector { reinterpret_cast<char*>(&session.message) + session.received,
+            sizeof(session.message) - session.received };
+        msghdr header {};
+        header.msg_iov = &vector;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        const ssize_t n = ::recvmsg(session.socket, &header, 0);
+        if (n < 0 && errno == EINTR)
+            return true;
+        if (n <= 0)
+            return false;
+
+        for (cmsghdr* c = CMSG_FIRSTHDR(&header); c != nullptr; c = CMSG_NXTHDR(&header, c))
+        {
+            if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_RIGHTS)
+                continue;
+            const int count = static_cast<int>((c->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+            for (int i = 0; i < count; ++i)
+            {
+                int fd;
+                std::memcpy(&fd, CMSG_DATA(c) + sizeof(int) * static_cast<size_t>(i), sizeof(int));
+                if (session.numDescriptors < 3 && !session.welcomed)
+                    session.descriptors[session.numDescriptors++] = fd;
+                else
+                    ::close(fd);
+            }
+        }
+
+        session.received += static_cast<size_t>(n);
+        return (header.msg_flags & MSG_CTRUNC) == 0 || session.welcomed;
+    }
+
+    /**
+     * @brief Creates, binds and listens on the service socket.
+     * @throws std::runtime_error on failure.
+     */
+    int listenOn(const juce::File& path, int backlog)
+    {
+        const auto name = path.getFullPathName().toStdString();
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (name.size() >= sizeof(address.sun_path))
+            throw std::runtime_error("Socket path is too long: " + name);
+        std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            throw std::runtime_error(std::string("Cannot create a socket: ") + std::strerror(errno));
+
+        // A socket file left by a previous run that was killed
+        struct stat info {};
+        if (::lstat(name.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+            ::unlink(name.c_str());
+
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, backlog) != 0)
+        {
+            const std::string reason = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("Cannot listen on " + name + ": " + reason);
+        }
+        ::fcntl(fd, F_SETFL, O_NONBLOCK);
+        return fd;
+    }
+}
+#endif
+
+/**
+ * @brief Builds the pool and runs the dispatcher on the calling thread.
+ *
+ * Steps:
+ * 1. Build every engine (memory prefaulted, frozen grids finished), the
+ *    self-pipe, the listening socket and the workers.
+ * 2. Poll the self-pipe, the listener, every session socket and every
+ *    welcomed session's wake pipe:
+ *    - listener: accept into a free slot, or answer Error and close;
+ *    - socket: complete a record; Hello is validated and answered with
+ *      Welcome or Error (also for non-finite settings), Settings and
+ *      Reset are handed to the scheduler (Settings with a non-finite
+ *      value are dropped);
+ *      a hang-up marks the session closing;
+ *    - wake pipe: queue a job with a deadline of now plus the session's budget;
+ *    - self-pipe: stop requests and workers reporting closed sessions.
+ *    Closing sessions are released as soon as no job holds them.
+ * 3. On stop: stop the workers, release every session, remove the socket file.
+ *
+ * @param config Service setup.
+ * @return Counters for the whole run.
+ * @throws std::invalid_argument if a pool size, the block size or the sample rate is invalid.
+ * @throws std::runtime_error if the socket cannot be created, or on platforms without Unix sockets.
+ */
+ReverbService::Stats ReverbService::run(const Config& config)
+{
+    if (config.engines < 1 || config.workers < 1)
+        throw std::invalid_argument("The service needs at least one engine and one worker.");
+    if (config.blockSize < 1 || config.blockSize > ServiceProtocol::maxCapacity || config.fs <= 0.0)
+        throw std::invalid_argument("Invalid block size or sample rate.");
+
+#if UMBRA_HAS_SERVICE
+    Stats stats;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // Step 1: pool, pipes, socket, workers
+    std::vector<Session> sessions(static_cast<size_t>(config.engines));
+    for (auto& session : sessions)
+    {
+        session.engine = std::make_unique<Reverb>(static_cast<float>(config.fs), config.blockSize, config.options);
+        session.engine->waitForFrozenGrid();
+    }
+
+    int selfPipe[2];
+    if (::pipe(selfPipe) != 0)
+        throw std::runtime_error(std::string("Cannot create a pipe: ") + std::strerror(errno));
+    ::fcntl(selfPipe[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(selfPipe[1], F_SETFL, O_NONBLOCK);
+
+    int listener = -1;
+    try
+    {
+        listener = listenOn(config.socket, config.engines);
+    }
+    catch (...)
+    {
+        ::close(selfPipe[0]);
+        ::close(selfPipe[1]);
+        throw;
+    }
+
+    stopRequested.store(false);
+    stopPipe.store(selfPipe[1]);
+    struct sigaction action {}, ignore {}, previousInt {}, previousTerm {}, previousPipe {};
+    action.sa_handler = signalHandler;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, &previousInt);
+    ::sigaction(SIGTERM, &action, &previousTerm);
+
+    // A client that dies leaves broken pipes and sockets behind; that must not end the service
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    ::sigaction(SIGPIPE, &ignore, &previousPipe);
+
+    Scheduler scheduler(config.engines);
+    Counters counters;
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int w = 0; w < config.workers; ++w)
+    {
+        workers.push_back(std::make_unique<Worker>(w, scheduler, counters, config.fs, config.blockSize, selfPipe[1]));
+        workers.back()->startThread(juce::Thread::Priority::highest);
+    }
+
+    // Step 2: dispatch
+    std::vector<pollfd> polled;
+    std::vector<std::pair<Session*, bool>> owners; // Session and whether the entry is its wake pipe
+    polled.reserve(2 + 2 * sessions.size());
+    owners.reserve(polled.capacity());
+
+    const auto endTicks = config.seconds > 0.0
+        ? startTicks + static_cast<int64_t>(config.seconds * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()))
+        : 0;
+
+    while (!stopRequested.load())
+    {
+        int timeout = -1;
+        if (endTicks != 0)
+        {
+            const auto now = juce::Time::getHighResolutionTicks();
+            if (now >= endTicks)
+                break;
+            timeout = juce::jmax(1, static_cast<int>(juce::Time::highResolutionTicksToSeconds(endTicks - now) * 1000.0));
+        }
+
+        polled.clear();
+        owners.clear();
+        polled.push_back({ selfPipe[0], POLLIN, 0 });
+        polled.push_back({ listener, POLLIN, 0 });
+        owners.resize(2, { nullptr, false });
+        for (auto& session : sessions)
+        {
+            if (!session.active || session.socket < 0)
+                continue;
+            polled.push_back({ session.socket, POLLIN, 0 });
+            owners.push_back({ &session, false });
+            if (session.welcomed)
+            {
+                polled.push_back({ session.wakeIn, POLLIN, 0 });
+                owners.push_back({ &session, true });
+            }
+        }
+
+        if (::poll(polled.data(), static_cast<nfds_t>(polled.size()), timeout) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (polled[0].revents & POLLIN)
+            drain(selfPipe[0]);
+
+        // New clients
+        if (polled[1].revents & POLLIN)
+        {
+            for (int client; (client = ::accept(listener, nullptr, nullptr)) >= 0;)
+            {
+                auto slot = std::find_if(sessions.begin(), sessions.end(), [](const Session& s) { return !s.active; });
+                if (slot == sessions.end())
+                {
+                    sendError(client, "No free engine");
+                    ::close(client);
+                    ++stats.refused;
+                    continue;
+                }
+                slot->active = true;
+                slot->socket = client;
+            }
+        }
+
+        // Control records and wake-ups
+        for (size_t i = 2; i < polled.size(); ++i)
+        {
+            Session& session = *owners[i].first;
+            if (polled[i].revents == 0 || session.socket < 0)
+                continue;
+
+            if (owners[i].second)
+            {
+                drain(session.wakeIn);
+                std::lock_guard<std::mutex> held(scheduler.lock);
+                if (session.input.getNumReady() > 0 && session.output.getNumFree() > 0)
+                    scheduler.push(session, juce::Time::getHighResolutionTicks() + session.budgetTicks);
+                continue;
+            }
+
+            bool open = receive(session);
+            if (open && session.received == sizeof(session.message))
+            {
+                session.received = 0;
+                const auto& message = session.message;
+
+                if (!session.welcomed)
+                {
+                    if (const char* reason = accept(session, config))
+                    {
+                        sendError(session.socket, reason);
+                        ++stats.refused;
+                        open = false;
+                    }
+                    else
+                    {
+                        {
+                            std::lock_guard<std::mutex> held(scheduler.lock);
+                            session.current = session.target = ReverbService::toParameters(message.settings);
+                        }
+                        session.welcomed = true;
+                        ++stats.sessions;
+
+                        ServiceProtocol::Message welcome;
+                        welcome.type = ServiceProtocol::Message::Type::Welcome;
+                        welcome.blockSize = config.blockSize;
+                        welcome.sampleRate = config.fs;
+                        sendMessage(session.socket, welcome);
+                    }
+                }
+                else if (message.type == ServiceProtocol::Message::Type::Settings)
+                {
+                    // Non-finite settings are dropped; the previous target stays
+                    if (isFinite(message.settings))
+                    {
+                        std::lock_guard<std::mutex> held(scheduler.lock);
+                        session.target = ReverbService::toParameters(message.settings);
+                    }
+                    else
+                    {
+                        ++stats.rejectedSettings;
+                    }
+                }
+                else if (message.type == ServiceProtocol::Message::Type::Reset)
+                {
+                    std::lock_guard<std::mutex> held(scheduler.lock);
+                    session.resetPending = true;
+                }
+                else
+                {
+                    open = false;
+                }
+            }
+
+            if (!open)
+            {
+                // Stop polling it; the engine is returned once no job holds it
+                std::lock_guard<std::mutex> held(scheduler.lock);
+                session.closing = true;
+                closeDescriptor(session.socket);
+            }
+        }
+
+        // Release closed sessions nobody is processing
+        for (auto& session : sessions)
+        {
+            if (!session.active || !session.closing)
+                continue;
+            bool idle;
+            {
+                std::lock_guard<std::mutex> held(scheduler.lock);
+                idle = !session.queued && !session.running;
+            }
+            if (idle)
+                release(session);
+        }
+    }
+
+    // Step 3: shut down
+    scheduler.stop();
+    workers.clear();
+
+    for (auto& session : sessions)
+        if (session.active)
+            release(session);
+
+    ::sigaction(SIGINT, &previousInt, nullptr);
+    ::sigaction(SIGTERM, &previousTerm, nullptr);
+    ::sigaction(SIGPIPE, &previousPipe, nullptr);
+    stopPipe.store(-1);
+    ::close(listener);
+    ::close(selfPipe[0]);
+    ::close(selfPipe[1]);
+    ::unlink(config.socket.getFullPathName().toRawUTF8());
+
+    stats.jobs = counters.jobs;
+    stats.frames = counters.frames;
+    stats.deadlineMisses = counters.deadlineMisses;
+    stats.worstLatenessMs = 1000.0 * juce::Time::highResolutionTicksToSeconds(counters.worstLatenessTicks);
+    stats.seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return stats;
+#else
+    throw std::runtime_error("The reverb service needs Unix sockets (Linux, macOS or BSD).");
+#endif
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+#include "ServiceProtocol.h"
+
+/**
+ * @class ReverbService
+ * @brief Local reverb daemon for multi-process pipelines (UmbraCLI serve).
+ *
+ * Other processes (transcoders, cleaners) open a session through ServiceClient
+ * instead of linking the engine. The service builds a fixed pool of Reverb
+ * engines up front, all with the same options and sample rate, and hands
+ * one to each session for its lifetime; a session that finds the pool empty
+ * is refused. Closing a session resets its engine in place and returns it.
+ *
+ * Audio never crosses the socket: each client shares one memory region
+ * holding an input and an output ServiceRing, and a byte on a pipe tells the
+ * service that there is new input (or new output space). One dispatcher
+ * thread polls the listener, the session sockets and those pipes; a wake-up
+ * turns into a job with a deadline (arrival time plus the session's budget).
+ * A fixed pool of worker threads takes jobs earliest deadline first, runs at
+ * most one block through the session's engine, wakes the client and
+ * requeues the job while input and output space remain, due one block
+ * period after the last deadline as for a real-time stream. A session with
+ * a backlog therefore cannot starve a more urgent one for longer than a block.
+ *
+ * Settings and resets from the client are recorded under the scheduler lock
+ * and picked up by the next job: parameters ramp from the old to the new
+ * values across that block (Reverb::processRamp), with nothing rebuilt or
+ * allocated. Settings with a NaN or infinite value are refused (Hello) or
+ * dropped (Settings). Engine options (diffuser engine, storage, frozen mode) belong
+ * to the pool and cannot change per session.
+ *
+ * Linux, macOS and BSD only (Unix sockets and descriptor passing).
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class ReverbService
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    ReverbService() = delete;
+
+    /**
+     * @struct Config
+     * @brief Service setup.
+     */
+    struct Config
+    {
+        juce::File socket;           ///< Listening socket (a stale socket file is replaced)
+        int engines = 4;             ///< Engines in the pool (= most concurrent sessions)
+        int workers = 2;             ///< Processing threads
+        double fs = 48000.0;         ///< Sample rate of every engine (clients must match)
+        int blockSize = 512;         ///< Engine block size (largest step of one job)
+        double seconds = 0.0;        ///< Run time limit (0 = until SIGINT / SIGTERM)
+        ReverbOptions options;       ///< Engine options shared by the pool
+    };
+
+    /**
+     * @struct Stats
+     * @brief What the service did while it ran.
+     */
+    struct Stats
+    {
+        int sessions = 0;             ///< Sessions opened
+        int refused = 0;              ///< Hellos rejected (pool empty or invalid request)
+        int rejectedSettings = 0;     ///< Settings records dropped for a non-finite value
+        int64_t jobs = 0;             ///< Blocks processed
+        int64_t frames = 0;           ///< Frames processed
+        int64_t deadlineMisses = 0;   ///< Jobs finished after their deadline
+        double worstLatenessMs = 0.0; ///< Largest overshoot of a deadline
+        double seconds = 0.0;         ///< Wall-clock run time
+    };
+
+    /**
+     * @brief Builds the pool, listens and serves until stopped.
+     * @param config Service setup.
+     * @return Counters for the whole run.
+     * @throws std::invalid_argument if a pool size, the block size or the sample rate is invalid.
+     * @throws std::runtime_error if the socket cannot be created, or on platforms without Unix sockets.
+     */
+    static Stats run(const Config& config);
+
+    /**
+     * @brief Stops a running service (async-signal-safe; also used for SIGINT / SIGTERM).
+     */
+    static void requestStop();
+
+    /**
+     * @brief Converts client settings to engine parameters.
+     * @param settings Values from a Hello or Settings record.
+     * @return Parameters with every value clamped to the plugin's ranges.
+     */
+    static ReverbParameters toParameters(const ServiceSettings& settings);
+};
@@ -0,0 +1,392 @@
+#include "ScalingBench.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #define UMBRA_HAS_PERF_EVENTS 1
+#else
+ #define UMBRA_HAS_PERF_EVENTS 0
+#endif
+
+namespace
+{
+    /**
+     * @class Barrier
+     * @brief Spinning barrier for a fixed number of workers.
+     *
+     * Workers spin with a yield instead of sleeping, so waking up does not
+     * add scheduler latency to the next round.
+     */
+    class Barrier
+    {
+    public:
+        explicit Barrier(int count) : count(count) {}
+
+        /** @brief Blocks until all workers have arrived. */
+        void arriveAndWait()
+        {
+            const int phase = generation.load(std::memory_order_acquire);
+            if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+            {
+                arrived.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+                return;
+            }
+
+            while (generation.load(std::memory_order_acquire) == phase)
+                juce::Thread::yield();
+        }
+
+    private:
+        const int count;
+        std::atomic<int> arrived { 0 };
+        std::atomic<int> generation { 0 };
+    };
+
+    /**
+     * @class CacheCounters
+     * @brief Last-level cache references and misses of the calling thread.
+     *
+     * Uses the generic perf_event cache events, which map to the LLC on
+     * x86. Unavailable (valid() is false) on other platforms, in containers
+     * without perf access, or with perf_event_paranoid too high.
+     */
+    class CacheCounters
+    {
+    public:
+        CacheCounters()
+        {
+#if UMBRA_HAS_PERF_EVENTS
+            references = open(PERF_COUNT_HW_CACHE_REFERENCES, -1);
+            if (references >= 0)
+                misses = open(PERF_COUNT_HW_CACHE_MISSES, references);
+#endif
+        }
+
+        ~CacheCounters()
+        {
+#if UMBRA_HAS_PERF_EVENTS
+            if (misses >= 0)
+                close(misses);
+            if (references >= 0)
+                close(references);
+#endif
+        }
+
+        CacheCounters(const CacheCounters&) = delete;
+        CacheCounters& operator=(const CacheCounters&) = delete;
+
+        bool valid() const { return references >= 0 && misses >= 0; }
+
+        /** @brief Zeroes and enables both counters. */
+        void start()
+        {
+#if UMBRA_HAS_PERF_EVENTS
+            if (!valid())
+                return;
+            ioctl(references, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(references, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        /** @brief Disables both counters and reads them. */
+        void stop(uint64_t& referenceCount, uint64_t& missCount)
+        {
+            referenceCount = missCount = 0;
+#if UMBRA_HAS_PERF_EVENTS
+            if (!valid())
+                return;
+            ioctl(references, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            if (read(references, &referenceCount, sizeof(referenceCount)) != sizeof(referenceCount)
+                || read(misses, &missCount, sizeof(missCount)) != sizeof(missCount))
+                referenceCount = missCount = 0;
+#endif
+        }
+
+    private:
+#if UMBRA_HAS_PERF_EVENTS
+        static int open(uint64_t event, int group)
+        {
+            perf_event_attr attr {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = event;
+            attr.disabled = group < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+        int references = -1; ///< Group leader
+        int misses = -1;     ///< Group member
+    };
+
+    /**
+     * @class Worker
+     * @brief Runs one function on a thread pinned to one core.
+     */
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(int index, std::function<void()> body)
+            : juce::Thread("Umbra scale " + juce::String(index)), body(std::move(body))
+        {
+            const int core = index % juce::jmax(1, juce::SystemStats::getNumCpus());
+            if (core < 32)
+                setAffinityMask(1u << core);
+        }
+
+        ~Worker() override { stopThread(-1); }
+
+        void run() override { body(); }
+
+    private:
+        std::function<void()> body;
+    };
+
+    /**
+     * @struct WorkerResult
+     * @brief What one worker measured.
+     */
+    struct WorkerResult
+    {
+        std::vector<double> callbackSeconds; ///< One entry per timed callback
+        uint64_t references = 0;             ///< LLC references while timed
+        uint64_t misses = 0;                 ///< LLC misses while timed
+        bool countersValid = false;          ///< Counters could be opened
+    };
+}
+
+/**
+ * @brief Three diffuser engines times three storage formats.
+ */
+std::vector<ScalingBench::Variant> ScalingBench::allVariants(const ReverbOptions& base)
+{
+    const std::pair<Diffuser::Engine, const char*> engines[] = {
+        { Diffuser::Engine::DVN, "dvn" },
+        { Diffuser::Engine::SharedDVN, "shared" },
+        { Diffuser::Engine::Allpass, "allpass" }
+    };
+    const std::pair<DelayLine::Storage, const char*> storages[] = {
+        { DelayLine::Storage::Float32, "float" },
+        { DelayLine::Storage::Float16, "fp16" },
+        { DelayLine::Storage::BFloat16, "bf16" }
+    };
+
+    std::vector<Variant> variants;
+    for (const auto& [engine, engineName] : engines)
+    {
+        for (const auto& [storage, storageName] : storages)
+        {
+            Variant variant;
+            variant.name = juce::String(engineName) + " / " + storageName;
+            variant.options = base;
+            variant.options.d1Engine = variant.options.d2Engine = variant.options.d3Engine = engine;
+            variant.options.fdnStorage = storage;
+            variants.push_back(variant);
+        }
+    }
+    return variants;
+}
+
+/**
+ * @brief Runs the instances in lockstep and collects the figures.
+ *
+ * Steps:
+ * 1. Build the instances (distinct seeds, so no two share a topology) and
+ *    one second of stereo noise they all read from.
+ * 2. Assign instance i to worker i % T. Each worker copies the next noise
+ *    block into each of its instances' buffers (untimed) and times
+ *    Reverb::process; all workers meet at a barrier after every round.
+ * 3. After the warm-up rounds, worker 0 takes the wall clock and every
+ *    worker counts LLC events until the last round.
+ * 4. Throughput is instances x audio seconds / wall seconds; the callback
+ *    percentiles are taken over all instances.
+ *
+ * @param config Bench settings.
+ * @param variant Configuration to run.
+ * @param instances Number of engines.
+ * @return Throughput, latency and cache figures.
+ * @throws std::invalid_argument if instances, the block size or the length is not positive.
+ */
+ScalingBench::Point ScalingBench::measure(const Config& config, const Variant& variant, int instances)
+{
+    const int rounds = static_cast<int>(config.seconds * config.fs / config.blockSize);
+    if (instances < 1 || config.blockSize < 1 || rounds < 1)
+        throw std::invalid_argument("Instances, block size and length must be positive.");
+
+    const int maxThreads = config.threads > 0 ? config.threads : juce::SystemStats::getNumCpus();
+    const int threads = juce::jlimit(1, instances, maxThreads);
+
+    // Step 1: instances and source noise
+    std::vector<std::unique_ptr<Reverb>> reverbs;
+    std::vector<juce::AudioBuffer<float>> buffers;
+    for (int i = 0; i < instances; ++i)
+    {
+        ReverbOptions options = variant.options;
+        options.seed = static_cast<uint32_t>(i + 1);
+        reverbs.push_back(std::make_unique<Reverb>(static_cast<float>(config.fs), config.blockSize, options));
+        reverbs.back()->waitForFrozenGrid();
+        buffers.emplace_back(2, config.blockSize);
+    }
+
+    const int noiseBlocks = juce::jmax(1, static_cast<int>(config.fs) / config.blockSize);
+    juce::AudioBuffer<float> noise(2, noiseBlocks * config.blockSize);
+    juce::Random random(1);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int n = 0; n < noise.getNumSamples(); ++n)
+            noise.setSample(ch, n, random.nextFloat() * 0.5f - 0.25f);
+
+    // Step 2: workers
+    Barrier barrier(threads);
+    std::vector<WorkerResult> results(static_cast<size_t>(threads));
+    int64_t startTicks = 0, endTicks = 0;
+
+    auto body = [&](int w)
+    {
+        auto& result = results[static_cast<size_t>(w)];
+        const int mine = (instances - w + threads - 1) / threads;
+        result.callbackSeconds.reserve(static_cast<size_t>(rounds) * mine);
+        CacheCounters counters;
+        result.countersValid = counters.valid();
+
+        for (int round = -config.warmupBlocks; round < rounds; ++round)
+        {
+            // Step 3: start timing once every worker is warm
+            if (round == 0)
+            {
+                barrier.arriveAndWait();
+                if (w == 0)
+                    startTicks = juce::Time::getHighResolutionTicks();
+                counters.start();
+            }
+
+            const int offset = ((round + config.warmupBlocks) % noiseBlocks) * config.blockSize;
+            for (int i = w; i < instances; i += threads)
+            {
+                auto& buffer = buffers[static_cast<size_t>(i)];
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.copyFrom(ch, 0, noise, ch, offset, config.blockSize);
+
+                const auto before = juce::Time::getHighResolutionTicks();
+                reverbs[static_cast<size_t>(i)]->process(buffer, config.parameters);
+                const auto after = juce::Time::getHighResolutionTicks();
+
+                if (round >= 0)
+                    result.callbackSeconds.push_back(juce::Time::highResolutionTicksToSeconds(after - before));
+            }
+
+            barrier.arriveAndWait();
+        }
+
+        counters.stop(result.references, result.misses);
+        if (w == 0)
+            endTicks = juce::Time::getHighResolutionTicks();
+    };
+
+    {
+        std::vector<std::unique_ptr<Worker>> workers;
+        for (int w = 0; w < threads; ++w)
+            workers.push_back(std::make_unique<Worker>(w, [&body, w] { body(w); }));
+        for (auto& worker : workers)
+            worker->startThread();
+        for (auto& worker : workers)
+            worker->waitForThreadToExit(-1);
+    }
+
+    // Step 4: figures
+    Point point;
+    point.instances = instances;
+    point.threads = threads;
+    point.budgetMicros = 1.0e6 * config.blockSize / config.fs;
+
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
+    const double audioSeconds = static_cast<double>(rounds) * config.blockSize / config.fs;
+    point.realtime = instances * audioSeconds / juce::jmax(1.0e-9, wallSeconds);
+
+    std::vector<double> times;
+    uint64_t references = 0, misses = 0;
+    bool countersValid = true;
+    for (const auto& result : results)
+    {
+        times.insert(times.end(), result.callbackSeconds.begin(), result.callbackSeconds.end());
+        references += result.references;
+        misses += result.misses;
+        countersValid = countersValid && result.countersValid;
+    }
+
+    if (!times.empty())
+    {
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+        point.meanMicros = 1.0e6 * sum / static_cast<double>(times.size());
+
+        const auto p99 = times.begin() + static_cast<std::ptrdiff_t>((times.size() - 1) * 99 / 100);
+        std::nth_element(times.begin(), p99, times.end());
+        point.p99Micros = 1.0e6 * *p99;
+    }
+
+    if (countersValid && references > 0)
+    {
+        point.llcMissRate = static_cast<double>(misses) / static_cast<double>(references);
+        point.llcMissesPerSample = static_cast<double>(misses) / (static_cast<double>(instances) * rounds * config.blockSize);
+    }
+
+    return point;
+}
+
+/**
+ * @brief Runs measure() for every variant and instance count.
+ */
+std::vector<ScalingBench::Series> ScalingBench::run(const Config& config)
+{
+    std::vector<Series> results;
+    for (const auto& variant : config.variants)
+    {
+        Series series;
+        series.variant = variant;
+        for (int instances : config.instances)
+            series.points.push_back(measure(config, variant, instances));
+        results.push_back(std::move(series));
+    }
+    return results;
+}
+
+/**
+ * @brief One table per variant; LLC columns read "n/a" without counters.
+ */
+juce::String ScalingBench::format(const Config& config, const std::vector<Series>& results)
+{
+    juce::String report;
+    report << "block " << config.blockSize << " at " << config.fs << " Hz, "
+           << config.seconds << " s per instance, " << juce::SystemStats::getNumCpus() << " CPUs\n";
+
+    for (const auto& series : results)
+    {
+        report << "\n" << series.variant.name << "\n";
+        report << "  instances threads  realtime   mean us    p99 us  p99/budget  LLC miss  misses/frame\n";
+
+        for (const auto& p : series.points)
+        {
+            report << juce::String(p.instances).paddedLeft(' ', 11)
+                   << juce::String(p.threads).paddedLeft(' ', 8)
+                   << (juce::String(p.realtime, 1) + "x").paddedLeft(' ', 10)
+                   << juce::String(p.meanMicros, 1).paddedLeft(' ', 10)
+                   << juce::String(p.p99Micros, 1).paddedLeft(' ', 10)
+                   << (juce::String(100.0 * p.p99Micros / p.budgetMicros, 1) + "%").paddedLeft(' ', 12)
+                   << (p.llcMissRate < 0.0 ? juce::String("n/a") : juce::String(100.0 * p.llcMissRate, 1) + "%").paddedLeft(' ', 10)
+                   << (p.llcMissesPerSample < 0.0 ? juce::String("n/a") : juce::String(p.llcMissesPerSample, 3)).paddedLeft(' ', 14)
+                   << "\n";
+        }
+    }
+    return report;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class ScalingBench
+ * @brief Measures how the engine scales when many instances share the caches.
+ *
+ * A single instance fits in the last-level cache far better than a session
+ * of dozens of them, whose delay-line traffic evicts each other. This bench
+ * builds N Reverb instances, spreads them over T worker threads pinned to
+ * separate cores, and processes them in lockstep: in every round each worker
+ * runs one callback of each of its instances, then all workers meet at a
+ * barrier, as a host's audio graph does.
+ *
+ * Per instance count it reports the aggregate throughput, the mean and 99th
+ * percentile callback time against the block's real-time budget, and (where
+ * hardware counters are readable, Linux perf_event) the last-level cache
+ * miss rate of the workers. Every storage format and diffuser engine can be
+ * run, so memory-layout changes are judged under contention. The DVN
+ * engine's OpenMP regions start a team per worker, so its figures include
+ * the oversubscription a host would see as well.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class ScalingBench
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    ScalingBench() = delete;
+
+    /**
+     * @struct Variant
+     * @brief One engine configuration to scale.
+     */
+    struct Variant
+    {
+        juce::String name;     ///< Label, e.g. "shared / fp16"
+        ReverbOptions options; ///< Engine options (seed is set per instance)
+    };
+
+    /**
+     * @struct Config
+     * @brief What to run and how.
+     */
+    struct Config
+    {
+        double fs = 48000.0;         ///< Sample rate in Hz
+        int blockSize = 256;         ///< Callback size
+        double seconds = 2.0;        ///< Audio processed per instance and measurement
+        int warmupBlocks = 32;       ///< Untimed rounds before measuring
+        int threads = 0;             ///< Worker threads (0 = one per CPU, capped at the instance count)
+        std::vector<int> instances { 1, 2, 4, 8, 16, 32, 50 }; ///< Instance counts to measure
+        std::vector<Variant> variants; ///< Configurations to measure (see allVariants())
+        ReverbParameters parameters; ///< Constant parameter values
+    };
+
+    /**
+     * @struct Point
+     * @brief Measurement for one instance count.
+     */
+    struct Point
+    {
+        int instances = 0;         ///< Engines processed per round
+        int threads = 0;           ///< Workers used
+        double realtime = 0.0;     ///< Aggregate audio seconds per wall-clock second
+        double meanMicros = 0.0;   ///< Mean callback time
+        double p99Micros = 0.0;    ///< 99th percentile callback time
+        double budgetMicros = 0.0; ///< Real-time budget of one callback
+        double llcMissRate = -1.0; ///< LLC misses / LLC references (-1 = counters unavailable)
+        double llcMissesPerSample = -1.0; ///< LLC misses per processed stereo frame (-1 = unavailable)
+    };
+
+    /**
+     * @struct Series
+     * @brief All instance counts of one variant.
+     */
+    struct Series
+    {
+        Variant variant;           ///< Configuration measured
+        std::vector<Point> points; ///< One entry per instance count
+    };
+
+    /**
+     * @brief Every diffuser engine combined with every FDN storage format.
+     * @param base Options the variants start from.
+     * @return Variants in a stable order.
+     */
+    static std::vector<Variant> allVariants(const ReverbOptions& base);
+
+    /**
+     * @brief Measures one variant at one instance count.
+     * @param config Bench settings.
+     * @param variant Configuration to run.
+     * @param instances Number of engines.
+     * @return Throughput, latency and cache figures.
+     * @throws std::invalid_argument if instances, the block size or the length is not positive.
+     */
+    static Point measure(const Config& config, const Variant& variant, int instances);
+
+    /**
+     * @brief Measures every variant at every instance count.
+     * @param config Bench settings.
+     * @return One series per variant.
+     */
+    static std::vector<Series> run(const Config& config);
+
+    /**
+     * @brief Formats the results as one table per variant.
+     * @param config Settings the results were produced with.
+     * @param results Bench outcome.
+     * @return Multi-line report.
+     */
+    static juce::String format(const Config& config, const std::vector<Series>& results);
+};
@@ -0,0 +1,636 @@
+#include "SelfCheck.h"
+#include "../../../Source/Hadamard.h"
+#include "../../../Source/HalfFloat.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Appends one check; non-finite measurements fail.
+     */
+    void addCheck(SelfCheck::Result& result, const std::string& group, const std::string& name,
+        double measured, double limit)
+    {
+        SelfCheck::Check check;
+        check.group = group;
+        check.name = name;
+        check.measured = measured;
+        check.limit = limit;
+        check.passed = std::isfinite(measured) && measured <= limit;
+        result.checks.push_back(check);
+    }
+
+    const char* matrixName(FeedbackMatrixType type)
+    {
+        switch (type)
+        {
+        case FeedbackMatrixType::Householder: return "householder";
+        case FeedbackMatrixType::Velvet: return "velvet";
+        default: return "hadamard";
+        }
+    }
+
+    /**
+     * @brief Applies one matrix policy to a frame, specialized for N lines or generic.
+     */
+    void mix(FeedbackMatrixType type, VelvetMatrix& velvet, float* frame, int N, bool specialized)
+    {
+        const auto apply = [&](auto& matrix)
+        {
+            if (!specialized)
+                matrix.template process<0>(frame, N);
+            else if (N == 8)
+                matrix.template process<8>(frame, N);
+            else if (N == 16)
+                matrix.template process<16>(frame, N);
+            else
+                matrix.template process<32>(frame, N);
+        };
+
+        HadamardMatrix hadamard;
+        HouseholderMatrix householder;
+        switch (type)
+        {
+        case FeedbackMatrixType::Householder: apply(householder); break;
+        case FeedbackMatrixType::Velvet: apply(velvet); break;
+        default: apply(hadamard); break;
+        }
+    }
+
+    /**
+     * @brief Feedback matrices: orthogonality, kernel agreement, FDN decay.
+     *
+     * - Orthogonality: the columns (the generic kernel applied to unit
+     *   vectors) must satisfy |A^T A - I| <= 1e-5 elementwise.
+     * - Kernels: the 8/16/32-line specializations must agree with the
+     *   generic path on a fixed random frame within 1e-6.
+     * - FDN: an 8-line network on each matrix must give a finite impulse
+     *   response whose energy in its last half second is below half that
+     *   of its first half second (the loop is contractive).
+     * - Hadamard::process on a non-power-of-two vector leaves it unchanged.
+     */
+    void checkMatrices(SelfCheck::Result& result)
+    {
+        const std::string group = "matrix";
+        const FeedbackMatrixType types[] = { FeedbackMatrixType::Hadamard,
+            FeedbackMatrixType::Householder, FeedbackMatrixType::Velvet };
+
+        for (const auto type : types)
+        {
+            for (int N : { 6, 8, 12, 16, 32 })
+            {
+                if (type == FeedbackMatrixType::Hadamard && (N & (N - 1)) != 0)
+                    continue;
+
+                std::mt19937 gen(1);
+                VelvetMatrix velvet(N, gen);
+
+                // Columns of A
+                std::vector<float> columns(static_cast<size_t>(N * N), 0.0f);
+                for (int j = 0; j < N; ++j)
+                {
+                    float* column = columns.data() + j * N;
+                    column[j] = 1.0f;
+                    mix(type, velvet, column, N, false);
+                }
+
+                double orthogonality = 0.0;
+                for (int a = 0; a < N; ++a)
+                    for (int b = 0; b < N; ++b)
+                    {
+                        double dot = 0.0;
+                        for (int i = 0; i < N; ++i)
+                            dot += static_cast<double>(columns[a * N + i]) * columns[b * N + i];
+                        orthogonality = std::max(orthogonality, std::abs(dot - (a == b ? 1.0 : 0.0)));
+                    }
+
+                const std::string name = std::string(matrixName(type)) + " " + std::to_string(N);
+                addCheck(result, group, name + " orthogonal", orthogonality, 1.0e-5);
+
+                if ((N & (N - 1)) != 0)
+                    continue;
+
+                std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+                std::vector<float> generic(static_cast<size_t>(N));
+                for (auto& v : generic)
+                    v = value(gen);
+                std::vector<float> specialized = generic;
+
+                mix(type, velvet, generic.data(), N, false);
+                mix(type, velvet, specialized.data(), N, true);
+
+                double difference = 0.0;
+                for (int i = 0; i < N; ++i)
+                    difference = std::max(difference, static_cast<double>(std::abs(generic[i] - specialized[i])));
+                addCheck(result, group, name + " kernel", difference, 1.0e-6);
+            }
+
+            // Impulse response of an 8-line FDN on this matrix
+            const double fs = 48000.0;
+            const int blockSize = 512;
+            const int window = static_cast<int>(fs / 2);
+            const int length = 4 * window;
+            const CoefficientTable coefficients(fs);
+            FDN fdn(8, static_cast<int>(0.05 * fs), blockSize, type, DelayLine::Storage::Float32, 1);
+
+            juce::AudioBuffer<float> block(8, blockSize);
+            double first = 0.0, last = 0.0;
+            for (int start = 0; start < length; start += blockSize)
+            {
+                const int n = juce::jmin(blockSize, length - start);
+                block.setSize(8, n, false, false, true);
+                block.clear();
+                if (start == 0)
+                    for (int ch = 0; ch < 8; ++ch)
+                        block.setSample(ch, 0, 1.0f);
+
+                fdn.process(block, 8000.0f, coefficients, 1.0f);
+
+                for (int ch = 0; ch < 8; ++ch)
+                    for (int i = 0; i < n; ++i)
+                    {
+                        const double x = block.getSample(ch, i);
+                        if (start + i < window)
+                            first += x * x;
+                        else if (start + i >= length - window)
+                            last += x * x;
+                    }
+            }
+            addCheck(result, group, std::string(matrixName(type)) + " fdn decay", last / first, 0.5);
+        }
+
+        std::vector<float> odd { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+        const auto before = odd;
+        Hadamard::process(odd);
+        addCheck(result, group, "hadamard size 6 untouched", odd == before ? 0.0 : 1.0, 0.0);
+    }
+
+    /**
+     * @brief Bit pattern of a float (NaN-safe comparison).
+     */
+    uint32_t bitsOf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /**
+     * @brief Values from low to high, 64 per octave, with both signs.
+     */
+    std::vector<float> sweep(double low, double high)
+    {
+        std::vector<float> values;
+        const double step = std::pow(2.0, 1.0 / 64.0);
+        for (double v = low; v <= high; v *= step)
+        {
+            values.push_back(static_cast<float>(v));
+            values.push_back(-static_cast<float>(v));
+        }
+        return values;
+    }
+
+    /**
+     * @brief Compact delay line storage: conversion accuracy and the sample API.
+     *
+     * - Round trip: FP16 must stay within 2^-11 relative error over its
+     *   normal range (2^-14 to 65504) and BF16 within 2^-8 over 1e-30 to
+     *   1e30; zero must encode to 0 in both.
+     * - FP16 paths: the F16C and software conversions must give the same
+     *   bits for every non-NaN FP16 pattern and for floats from the
+     *   subnormal range to overflow (trivially equal without F16C).
+     * - Sample API: a compact line must return exactly the round-tripped
+     *   input at every tested delay, report that it does not support
+     *   blocks, and throw std::logic_error from its block API.
+     */
+    void checkStorage(SelfCheck::Result& result)
+    {
+        const std::string group = "storage";
+
+        double halfError = 0.0;
+        for (const float x : sweep(std::ldexp(1.0, -14), 65504.0))
+            halfError = std::max(halfError,
+                std::abs(static_cast<double>(HalfFloat::halfToFloat(HalfFloat::floatToHalf(x))) - x) / std::abs(x));
+        addCheck(result, group, "fp16 round trip", halfError, std::ldexp(1.0, -11));
+
+        double bfloatError = 0.0;
+        for (const float x : sweep(1.0e-30, 1.0e30))
+            bfloatError = std::max(bfloatError,
+                std::abs(static_cast<double>(HalfFloat::bfloatToFloat(HalfFloat::floatToBFloat(x))) - x) / std::abs(x));
+        addCheck(result, group, "bf16 round trip", bfloatError, std::ldexp(1.0, -8));
+
+        addCheck(result, group, "zero encodes to 0",
+            HalfFloat::floatToHalf(0.0f) == 0 && HalfFloat::floatToBFloat(0.0f) == 0 ? 0.0 : 1.0, 0.0);
+
+        int mismatches = 0;
+        for (uint32_t h = 0; h <= 0xFFFFu; ++h)
+        {
+            const auto bits = static_cast<uint16_t>(h);
+            if ((bits & 0x7C00u) == 0x7C00u && (bits & 0x03FFu) != 0)
+                continue; // NaN payloads may be quieted differently
+            mismatches += bitsOf(HalfFloat::halfToFloat(bits)) != bitsOf(HalfFloat::halfToFloatSoftware(bits)) ? 1 : 0;
+        }
+        for (const float x : sweep(std::ldexp(1.0, -30), 1.0e6))
+            mismatches += HalfFloat::floatToHalf(x) != HalfFloat::floatToHalfSoftware(x) ? 1 : 0;
+        addCheck(result, group, "fp16 f16c = software", mismatches, 0.0);
+
+        for (const auto storage : { DelayLine::Storage::Float16, DelayLine::Storage::BFloat16 })
+        {
+            const bool half = storage == DelayLine::Storage::Float16;
+            const std::string name = half ? "fp16" : "bf16";
+            const auto roundTrip = [half](float x)
+            {
+                return half ? HalfFloat::halfToFloat(HalfFloat::floatToHalf(x))
+                            : HalfFloat::bfloatToFloat(HalfFloat::floatToBFloat(x));
+            };
+
+            const int maxDelay = 100;
+            DelayLine line(maxDelay, 0.0f, 64, storage);
+
+            std::mt19937 gen(2);
+            std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+            std::vector<float> input(1000);
+            for (auto& x : input)
+                x = value(gen);
+
+            double difference = 0.0;
+            for (int n = 0; n < static_cast<int>(input.size()); ++n)
+            {
+                line.writeSample(input[n]);
+                for (int tau : { 0, 1, 37, maxDelay })
+                {
+                    const float expected = n >= tau ? roundTrip(input[n - tau]) : 0.0f;
+                    difference = std::max(difference, static_cast<double>(std::abs(line.readSample(tau) - expected)));
+                }
+            }
+            addCheck(result, group, name + " line samples", difference, 0.0);
+
+            int refused = 0;
+            try { line.readBlock(0, 16); } catch (const std::logic_error&) { ++refused; }
+            try { line.writeBlock(input.data(), 16); } catch (const std::logic_error&) { ++refused; }
+            addCheck(result, group, name + " line refuses blocks",
+                refused == 2 && !line.supportsBlocks() ? 0.0 : 1.0, 0.0);
+        }
+    }
+
+    /**
+     * @brief Parameter targets of callback i: a slow sweep of room size,
+     *        dampening, pre-delay and mix, so snapshots land mid-ramp.
+     */
+    ReverbParameters stateTarget(int i)
+    {
+        const float t = 0.5f + 0.5f * std::sin(0.05f * static_cast<float>(i));
+        ReverbParameters params;
+        params.mix = 0.5f + 0.5f * t;
+        params.roomSize = 0.6f + 0.6f * t;
+        params.dampening = 2000.0f + 6000.0f * t;
+        params.initialDelay = 0.01f * t;
+        return params;
+    }
+
+    /**
+     * @brief Renders callbacks [first, last) of a buffer in place, ramping between targets.
+     */
+    void renderCallbacks(Reverb& reverb, juce::AudioBuffer<float>& buffer, int first, int last, int blockSize)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            const int start = i * blockSize;
+            const int numSamples = juce::jmin(blockSize, buffer.getNumSamples() - start);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples);
+            reverb.processRamp(block, stateTarget(i - 1), stateTarget(i));
+        }
+    }
+
+    /**
+     * @brief Samples from frame start on whose bits differ between two buffers.
+     */
+    int countMismatches(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start)
+    {
+        int count = 0;
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int n = start; n < a.getNumSamples(); ++n)
+                count += std::memcmp(a.getReadPointer(ch, n), b.getReadPointer(ch, n), sizeof(float)) != 0 ? 1 : 0;
+        return count;
+    }
+
+    /**
+     * @brief Engine state snapshots: a restored engine continues bit for bit.
+     *
+     * Seeded stereo noise is rendered in deterministic mode with ramping
+     * parameters through three configurations (DVN; allpass and shared-grid
+     * diffusers with an FP16 Householder FDN; early reflections with the
+     * 16-line absorbing BF16 velvet FDN). A snapshot is taken mid-render and
+     * mid-ramp:
+     * - restored into a new engine, the rest of the render must match the
+     *   uninterrupted one in every bit;
+     * - restored into the saved engine after it rendered on, it must rewind
+     *   it and repeat the same bits;
+     * - an engine with another seed must refuse the snapshot.
+     */
+    void checkState(SelfCheck::Result& result)
+    {
+        const std::string group = "state";
+        const float fs = 48000.0f;
+        const int blockSize = 512;
+        const int length = static_cast<int>(fs);
+        const int numCallbacks = (length + blockSize - 1) / blockSize;
+        const int cut = numCallbacks / 2 - 6; // Mid-ramp, not on a power-of-two boundary
+
+        juce::AudioBuffer<float> input(2, length);
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> noise(-0.3f, 0.3f);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int n = 0; n < length; ++n)
+                input.setSample(ch, n, noise(gen));
+
+        ReverbOptions dvn;
+        dvn.seed = 11;
+        dvn.deterministic = true;
+
+        ReverbOptions compact = dvn;
+        compact.d1Engine = Diffuser::Engine::Allpass;
+        compact.d2Engine = Diffuser::Engine::SharedDVN;
+        compact.d3Engine = Diffuser::Engine::Allpass;
+        compact.fdnStorage = DelayLine::Storage::Float16;
+        compact.feedbackMatrix = FeedbackMatrixType::Householder;
+
+        ReverbOptions highOrder = dvn;
+        highOrder.earlyReflections = true;
+        highOrder.highOrderFDN = true;
+        highOrder.decayLow = 3.0f;
+        highOrder.decayHigh = 1.0f;
+        highOrder.fdnStorage = DelayLine::Storage::BFloat16;
+        highOrder.feedbackMatrix = FeedbackMatrixType::Velvet;
+
+        const std::pair<const char*, ReverbOptions> configs[] = {
+            { "dvn", dvn }, { "allpass fp16", compact }, { "fdn16 bf16", highOrder }
+        };
+
+        for (const auto& config : configs)
+        {
+            const std::string name = config.first;
+
+            juce::AudioBuffer<float> reference;
+            reference.makeCopyOf(input);
+            {
+                Reverb reverb(fs, blockSize, config.second);
+                renderCallbacks(reverb, reference, 0, numCallbacks, blockSize);
+            }
+
+            juce::AudioBuffer<float> saved;
+            saved.makeCopyOf(input);
+            Reverb reverb(fs, blockSize, config.second);
+            renderCallbacks(reverb, saved, 0, cut, blockSize);
+            const juce::MemoryBlock snapshot = reverb.saveState();
+            renderCallbacks(reverb, saved, cut, numCallbacks, blockSize);
+
+            juce::AudioBuffer<float> resumed;
+            resumed.makeCopyOf(input);
+            Reverb restored(fs, blockSize, config.second);
+            restored.restoreState(snapshot.getData(), snapshot.getSize());
+            renderCallbacks(restored, resumed, cut, numCallbacks, blockSize);
+            addCheck(result, group, name + " resume", countMismatches(reference, resumed, cut * blockSize), 0.0);
+
+            juce::AudioBuffer<float> rewound;
+            rewound.makeCopyOf(input);
+            reverb.restoreState(snapshot.getData(), snapshot.getSize());
+            renderCallbacks(reverb, rewound, cut, numCallbacks, blockSize);
+            addCheck(result, group, name + " rewind", countMismatches(reference, rewound, cut * blockSize), 0.0);
+
+            ReverbOptions otherSeed = config.second;
+            otherSeed.seed = config.second.seed + 1;
+            Reverb other(fs, blockSize, otherSeed);
+            bool refused = false;
+            try { other.restoreState(snapshot.getData(), snapshot.getSize()); }
+            catch (const std::invalid_argument&) { refused = true; }
+            addCheck(result, group, name + " other seed refused", refused ? 0.0 : 1.0, 0.0);
+        }
+    }
+
+    using Coefficients = std::array<double, 5>; ///< b0, b1, b2, a1, a2 (a0 = 1)
+
+    /**
+     * @brief Butterworth low-pass or high-pass designed directly in double
+     *        (bilinear transform, K = tan(pi f / fs)).
+     */
+    Coefficients butterworth(double fs, double frequency, bool highPass)
+    {
+        const double K = std::tan(juce::MathConstants<double>::pi * frequency / fs);
+        const double sqrt2 = juce::MathConstants<double>::sqrt2;
+        const double a0 = 1.0 + sqrt2 * K + K * K;
+        const double a1 = 2.0 * (K * K - 1.0) / a0;
+        const double a2 = (1.0 - sqrt2 * K + K * K) / a0;
+        if (highPass)
+            return { 1.0 / a0, -2.0 / a0, 1.0 / a0, a1, a2 };
+        return { K * K / a0, 2.0 * K * K / a0, K * K / a0, a1, a2 };
+    }
+
+    Coefficients toCoefficients(const CoefficientTable::Biquad& biquad)
+    {
+        return { biquad.b0, biquad.b1, biquad.b2, biquad.a1, biquad.a2 };
+    }
+
+    /**
+     * @brief |H(e^jw)| of a biquad at w = 2 pi frequency / fs.
+     */
+    double magnitude(const Coefficients& c, double fs, double frequency)
+    {
+        const auto z = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency / fs);
+        const auto z2 = z * z;
+        return std::abs((c[0] + c[1] * z + c[2] * z2) / (1.0 + c[3] * z + c[4] * z2));
+    }
+
+    /**
+     * @brief True if a float is more than one ulp away from the rounded exact value.
+     */
+    bool beyondUlp(float value, double exact)
+    {
+        const float rounded = static_cast<float>(exact);
+        return value != rounded && std::nextafter(rounded, value) != value;
+    }
+
+    /**
+     * @brief Grid frequency i of CoefficientTable (bit pattern of minFrequency plus i steps).
+     */
+    float gridFrequency(int i)
+    {
+        const uint32_t bits = bitsOf(CoefficientTable::minFrequency)
+            + (static_cast<uint32_t>(i) << (23 - CoefficientTable::octaveBits));
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /**
+     * @brief Coefficient table: grid exactness, interpolation error, stability, clamps.
+     *
+     * At 44.1, 48 and 96 kHz:
+     * - Grid: at every grid frequency the low-pass, high-pass and one-pole
+     *   lookups must be within one float ulp of the direct double design.
+     * - Stability: every interpolated biquad on a sweep of 256 cutoffs per
+     *   octave over the whole table must satisfy |a2| < 1 and |a1| < 1 + a2,
+     *   and every one-pole coefficient |a1| < 1.
+     * - Clamps: cutoffs below minFrequency and above getMaxFrequency() must
+     *   give the same bits as the limits themselves; NaN and -inf must give
+     *   minFrequency and +inf getMaxFrequency().
+     * At 48 kHz, for cutoffs from 20 Hz to 20 kHz (64 per octave), the
+     * interpolated low-pass and high-pass magnitudes must stay within 0.1 dB
+     * of the exact double design wherever that is above -20 dB. The error
+     * includes rounding the coefficients to float, which dominates at the
+     * lowest cutoffs (just under 0.05 dB there, about what a direct float
+     * design gives).
+     */
+    void checkCoefficients(SelfCheck::Result& result)
+    {
+        const std::string group = "coefficients";
+
+        for (const double fs : { 44100.0, 48000.0, 96000.0 })
+        {
+            const CoefficientTable table(fs);
+            const std::string rate = std::to_string(static_cast<int>(fs));
+
+            int offGrid = 0;
+            for (int i = 0; gridFrequency(i) <= table.getMaxFrequency(); ++i)
+            {
+                const float f = gridFrequency(i);
+                for (const bool highPass : { false, true })
+                {
+                    const auto biquad = highPass ? table.highPass(f) : table.lowPass(f);
+                    const float values[] = { biquad.b0, biquad.b1, biquad.b2, biquad.a1, biquad.a2 };
+                    const Coefficients exact = butterworth(fs, f, highPass);
+                    for (int k = 0; k < 5; ++k)
+                        offGrid += beyondUlp(values[k], exact[k]) ? 1 : 0;
+                }
+                const double K = std::tan(juce::MathConstants<double>::pi * f / fs);
+                offGrid += beyondUlp(table.onePole(f), (K - 1.0) / (K + 1.0)) ? 1 : 0;
+            }
+            addCheck(result, group, rate + " grid exact", offGrid, 0.0);
+
+            int unstable = 0;
+            const double step = std::pow(2.0, 1.0 / 256.0);
+            for (double f = CoefficientTable::minFrequency; f <= table.getMaxFrequency(); f *= step)
+            {
+                for (const auto& biquad : { table.lowPass(static_cast<float>(f)), table.highPass(static_cast<float>(f)) })
+                    unstable += std::abs(biquad.a2) < 1.0f && std::abs(biquad.a1) < 1.0f + biquad.a2 ? 0 : 1;
+                unstable += std::abs(table.onePole(static_cast<float>(f))) < 1.0f ? 0 : 1;
+            }
+            addCheck(result, group, rate + " stable", unstable, 0.0);
+
+            int unclamped = 0;
+            const auto sameBits = [](const CoefficientTable::Biquad& a, const CoefficientTable::Biquad& b)
+            {
+                return std::memcmp(&a, &b, sizeof(a)) == 0;
+            };
+            const float low = CoefficientTable::minFrequency;
+            const float high = table.getMaxFrequency();
+            const float infinity = std::numeric_limits<float>::infinity();
+            for (const float outside : { 0.0f, 1.0f, low * 0.5f, std::numeric_limits<float>::quiet_NaN(), -infinity })
+                unclamped += sameBits(table.lowPass(outside), table.lowPass(low)) && sameBits(table.highPass(outside), table.highPass(low))
+                    && table.onePole(outside) == table.onePole(low) ? 0 : 1;
+            for (const float outside : { high * 1.01f, static_cast<float>(fs), 1.0e9f, infinity })
+                unclamped += sameBits(table.lowPass(outside), table.lowPass(high)) && sameBits(table.highPass(outside), table.highPass(high))
+                    && table.onePole(outside) == table.onePole(high) ? 0 : 1;
+            addCheck(result, group, rate + " clamped", unclamped, 0.0);
+
+            if (fs != 48000.0)
+                continue;
+
+            for (const bool highPass : { false, true })
+            {
+                double error = 0.0;
+                for (double cutoff = 20.0; cutoff <= 20000.0; cutoff *= std::pow(2.0, 1.0 / 64.0))
+                {
+                    const float f = static_cast<float>(cutoff);
+                    const Coefficients exact = butterworth(fs, f, highPass);
+                    const Coefficients looked = toCoefficients(highPass ? table.highPass(f) : table.lowPass(f));
+                    for (double probe = 10.0; probe < 0.49 * fs; probe *= std::pow(2.0, 1.0 / 16.0))
+                    {
+                        const double reference = magnitude(exact, fs, probe);
+                        if (reference >= 0.1)
+                            error = std::max(error, std::abs(20.0 * std::log10(magnitude(looked, fs, probe) / reference)));
+                    }
+                }
+                addCheck(result, group, rate + (highPass ? " highpass dB" : " lowpass dB"), error, 0.1);
+            }
+        }
+    }
+
+    /**
+     * @struct Group
+     * @brief A named set of checks.
+     */
+    struct Group
+    {
+        const char* name;
+        void (*run)(SelfCheck::Result&);
+    };
+
+    const Group groups[] = {
+        { "matrix", checkMatrices },
+        { "storage", checkStorage },
+        { "state", checkState },
+        { "coefficients", checkCoefficients }
+    };
+}
+
+/**
+ * @brief Group names in run order.
+ */
+juce::StringArray SelfCheck::getGroups()
+{
+    juce::StringArray names;
+    for (const auto& group : groups)
+        names.add(group.name);
+    return names;
+}
+
+/**
+ * @brief Runs the requested groups in their fixed order.
+ *
+ * @param selected Group names (empty = all).
+ * @return Every check with its measurement.
+ * @throws std::invalid_argument for an unknown group name.
+ */
+SelfCheck::Result SelfCheck::run(const juce::StringArray& selected)
+{
+    for (const auto& name : selected)
+        if (!getGroups().contains(name))
+            throw std::invalid_argument("Unknown check group \"" + name.toStdString() + "\"");
+
+    Result result;
+    for (const auto& group : groups)
+        if (selected.isEmpty() || selected.contains(group.name))
+            group.run(result);
+
+    result.passed = true;
+    for (const auto& check : result.checks)
+        result.passed = result.passed && check.passed;
+    return result;
+}
+
+/**
+ * @brief One line per check, then PASS or FAIL.
+ */
+juce::String SelfCheck::format(const Result& result)
+{
+    juce::String report;
+    for (const auto& check : result.checks)
+    {
+        report << (check.passed ? "  ok    " : "  FAIL  ")
+               << juce::String(check.group).paddedRight(' ', 14)
+               << juce::String(check.name).paddedRight(' ', 30)
+               << juce::String(check.measured, 9).paddedLeft(' ', 14)
+               << " (limit " << juce::String(check.limit, 9) << ")\n";
+    }
+    report << (result.passed ? "PASS" : "FAIL") << "\n";
+    return report;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// Standard library
+#include <string>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class SelfCheck
+ * @brief Deterministic pass/fail checks of engine building blocks.
+ *
+ * Each group exercises one component with fixed inputs and seeds and
+ * compares the outcome against a fixed limit, so a run gives the same
+ * verdict on every machine:
+ * - "matrix": every FeedbackMatrix policy is orthogonal, its specialized
+ *   kernels match the generic one, and an FDN built on it decays.
+ * - "storage": FP16 / BF16 conversions stay within their rounding error and
+ *   the F16C and software paths agree; a compact delay line returns the
+ *   round-tripped samples and refuses the block API.
+ * - "state": a snapshot taken mid-render continues bit for bit in a new
+ *   engine and rewinds the saved one; another seed is refused.
+ * - "coefficients": CoefficientTable lookups are exact at grid points,
+ *   stable everywhere, clamped at both ends (NaN and infinities included),
+ *   and within 0.1 dB of the direct designs between grid points.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class SelfCheck
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    SelfCheck() = delete;
+
+    /**
+     * @struct Check
+     * @brief One measured quantity against its limit.
+     */
+    struct Check
+    {
+        std::string group;    ///< Check group ("matrix", ...)
+        std::string name;     ///< What was measured
+        double measured = 0;  ///< Measured error or ratio
+        double limit = 0;     ///< Largest accepted value
+        bool passed = false;  ///< measured <= limit (and finite)
+    };
+
+    /**
+     * @struct Result
+     * @brief Outcome of a run.
+     */
+    struct Result
+    {
+        std::vector<Check> checks; ///< All checks in run order
+        bool passed = false;       ///< Every check passed
+    };
+
+    /**
+     * @brief Names of all check groups, in run order.
+     */
+    static juce::StringArray getGroups();
+
+    /**
+     * @brief Runs the selected groups.
+     * @param groups Group names (empty = all).
+     * @return Every check with its measurement.
+     * @throws std::invalid_argument for an unknown group name.
+     */
+    static Result run(const juce::StringArray& groups);
+
+    /**
+     * @brief Formats a result as a plain-text report.
+     * @param result Check outcome.
+     * @return Multi-line report.
+     */
+    static juce::String format(const Result& result);
+};
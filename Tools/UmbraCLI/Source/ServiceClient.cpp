@@ -0,0 +1,337 @@
+#include "ServiceClient.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <sys/mman.h>
+ #include <sys/socket.h>
+ #include <sys/stat.h>
+ #include <sys/un.h>
+ #include <unistd.h>
+ #define UMBRA_HAS_SERVICE 1
+#else
+ #define UMBRA_HAS_SERVICE 0
+#endif
+
+#if UMBRA_HAS_SERVICE
+namespace
+{
+    /**
+     * @brief Closes a descriptor if it is open and marks it closed.
+     */
+    void closeDescriptor(int& fd)
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    /**
+     * @brief Throws a runtime_error with the current errno text appended.
+     */
+    [[noreturn]] void fail(const std::string& what)
+    {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+}
+#endif
+
+/**
+ * @brief Opens a session with the service.
+ *
+ * Steps:
+ * 1. Create the shared region: a uniquely named POSIX shared memory object,
+ *    unlinked as soon as it is open, sized and mapped; write the layout.
+ * 2. Create the two wake-up pipes (write ends non-blocking).
+ * 3. Connect to the socket and send Hello with the region, the read end of
+ *    the service's wake pipe and the write end of ours (SCM_RIGHTS), then
+ *    close our copies of the descriptors we handed over.
+ * 4. Wait for Welcome; an Error record becomes a runtime_error (also when
+ *    the Hello could not be sent because the service refused and closed first).
+ *
+ * @param socketPath Path of the service socket.
+ * @param numChannels Channels per direction (1 or 2).
+ * @param sampleRate Sample rate of the audio.
+ * @param capacity Ring length in frames per channel.
+ * @param deadlineMilliseconds Time the service may take from data arrival to output.
+ * @param settings Initial parameter values.
+ * @throws std::invalid_argument if numChannels or capacity is out of range.
+ * @throws std::runtime_error if the service cannot be reached or refuses the session.
+ */
+ServiceClient::ServiceClient(const std::string& socketPath, int numChannels, double sampleRate,
+    int capacity, double deadlineMilliseconds, const ServiceSettings& settings)
+    : numChannels(numChannels)
+{
+    if (numChannels < 1 || numChannels > ServiceProtocol::maxChannels)
+        throw std::invalid_argument("Service clients have 1 or 2 channels.");
+    if (capacity < 1 || capacity > ServiceProtocol::maxCapacity)
+        throw std::invalid_argument("Ring capacity is out of range.");
+
+#if UMBRA_HAS_SERVICE
+    int frames = 1;
+    while (frames < capacity)
+        frames <<= 1;
+
+    int pending[2] = { -1, -1 }; // Descriptors handed to the service (closed here after sending)
+    int memory = -1;
+    const auto cleanUp = [&]()
+    {
+        closeDescriptor(pending[0]);
+        closeDescriptor(pending[1]);
+        closeDescriptor(memory);
+        if (shared != nullptr)
+            ::munmap(shared, sharedBytes);
+        shared = nullptr;
+        closeDescriptor(socket);
+        closeDescriptor(wakeServiceFd);
+        closeDescriptor(wakeClientFd);
+    };
+
+    try
+    {
+        // Step 1: shared region
+        static std::atomic<int> counter { 0 };
+        const std::string name = "/umbra-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+        memory = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (memory < 0)
+            fail("Cannot create shared memory");
+        ::shm_unlink(name.c_str());
+
+        sharedBytes = ServiceProtocol::getSharedBytes(numChannels, frames);
+        if (::ftruncate(memory, static_cast<off_t>(sharedBytes)) != 0)
+            fail("Cannot size shared memory");
+
+        shared = ::mmap(nullptr, sharedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+        if (shared == MAP_FAILED)
+        {
+            shared = nullptr;
+            fail("Cannot map shared memory");
+        }
+
+        auto* layout = new (shared) ServiceProtocol::Layout();
+        layout->magic = ServiceProtocol::magic;
+        layout->version = ServiceProtocol::version;
+        layout->numChannels = static_cast<uint32_t>(numChannels);
+        layout->capacity = static_cast<uint32_t>(frames);
+        input = ServiceProtocol::getInput(shared);
+        output = ServiceProtocol::getOutput(shared);
+
+        // Step 2: wake-up pipes
+        int toService[2], toClient[2];
+        if (::pipe(toService) != 0)
+            fail("Cannot create a pipe");
+        wakeServiceFd = toService[1];
+        pending[0] = toService[0];
+        if (::pipe(toClient) != 0)
+            fail("Cannot create a pipe");
+        wakeClientFd = toClient[0];
+        pending[1] = toClient[1];
+        ::fcntl(wakeServiceFd, F_SETFL, O_NONBLOCK);
+        ::fcntl(pending[1], F_SETFL, O_NONBLOCK);
+
+        // Step 3: connect and say hello
+        socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket < 0)
+            fail("Cannot create a socket");
+
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path))
+            throw std::runtime_error("Socket path is too long: " + socketPath);
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+        if (::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            fail("Cannot connect to " + socketPath);
+
+        ServiceProtocol::Message hello;
+        hello.type = ServiceProtocol::Message::Type::Hello;
+        hello.numChannels = static_cast<uint32_t>(numChannels);
+        hello.capacity = static_cast<uint32_t>(frames);
+        hello.deadlineMicroseconds = static_cast<uint32_t>(deadlineMilliseconds * 1000.0);
+        hello.sampleRate = sampleRate;
+        hello.settings = settings;
+
+        const int descriptors[3] = { memory, pending[0], pending[1] };
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(descriptors))] = {};
+        iovec vector { &hello, sizeof(hello) };
+        msghdr header {};
+        header.msg_iov = &vector;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        cmsghdr* rights = CMSG_FIRSTHDR(&header);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(sizeof(descriptors));
+        std::memcpy(CMSG_DATA(rights), descriptors, sizeof(descriptors));
+
+        // A full service answers Error and closes before reading the Hello; fall through to read it
+        const bool sent = ::sendmsg(socket, &header, 0) == static_cast<ssize_t>(sizeof(hello));
+        const int sendError = errno;
+
+        // The service holds its own copies now
+        closeDescriptor(memory);
+        closeDescriptor(pending[0]);
+        closeDescriptor(pending[1]);
+
+        // Step 4: answer
+        ServiceProtocol::Message answer;
+        size_t received = 0;
+        while (received < sizeof(answer))
+        {
+            const ssize_t n = ::recv(socket, reinterpret_cast<char*>(&answer) + received, sizeof(answer) - received, 0);
+            if (n <= 0)
+            {
+                if (!sent)
+                    errno = sendError;
+                fail(sent ? "Reverb service closed the connection" : "Cannot send Hello");
+            }
+            received += static_cast<size_t>(n);
+        }
+
+        if (answer.type == ServiceProtocol::Message::Type::Error)
+        {
+            answer.error[sizeof(answer.error) - 1] = '\0';
+            throw std::runtime_error(std::string("Reverb service refused the session: ") + answer.error);
+        }
+        if (answer.type != ServiceProtocol::Message::Type::Welcome)
+            throw std::runtime_error("Unexpected answer from the reverb service");
+
+        blockSize = answer.blockSize;
+    }
+    catch (...)
+    {
+        cleanUp();
+        throw;
+    }
+#else
+    (void) socketPath; (void) sampleRate; (void) deadlineMilliseconds; (void) settings;
+    throw std::runtime_error("The reverb service needs POSIX shared memory and Unix sockets.");
+#endif
+}
+
+/**
+ * @brief Closes the socket (ending the session), the pipes and the mapping.
+ */
+ServiceClient::~ServiceClient()
+{
+#if UMBRA_HAS_SERVICE
+    closeDescriptor(socket);
+    closeDescriptor(wakeServiceFd);
+    closeDescriptor(wakeClientFd);
+    if (shared != nullptr)
+        ::munmap(shared, sharedBytes);
+#endif
+}
+
+/**
+ * @brief Copies frames into the input ring and wakes the service.
+ */
+int ServiceClient::write(const float* const* channels, int numSamples)
+{
+    const int written = input.write(channels, numSamples);
+    if (written > 0)
+        wakeService();
+    return written;
+}
+
+/**
+ * @brief Copies frames out of the output ring; the freed space may let a
+ *        stalled service continue, so it is woken as well.
+ */
+int ServiceClient::read(float* const* channels, int numSamples)
+{
+    const int count = output.read(channels, numSamples);
+    if (count > 0)
+        wakeService();
+    return count;
+}
+
+/**
+ * @brief Polls the wake pipe and the socket until output is ready.
+ *
+ * The pipe is drained on every wake-up; a hang-up on the socket means the
+ * service went away.
+ */
+bool ServiceClient::waitForOutput(int timeoutMilliseconds)
+{
+#if UMBRA_HAS_SERVICE
+    if (output.getNumReady() > 0)
+        return true;
+
+    pollfd descriptors[2] = { { wakeClientFd, POLLIN, 0 }, { socket, POLLIN, 0 } };
+    if (::poll(descriptors, 2, timeoutMilliseconds) < 0 && errno != EINTR)
+        fail("Cannot wait for the reverb service");
+
+    if (descriptors[1].revents & (POLLIN | POLLHUP | POLLERR))
+        throw std::runtime_error("Reverb service closed the session");
+
+    if (descriptors[0].revents & POLLIN)
+    {
+        char drain[64];
+        while (::read(wakeClientFd, drain, sizeof(drain)) == static_cast<ssize_t>(sizeof(drain)))
+        {
+        }
+    }
+#else
+    (void) timeoutMilliseconds;
+#endif
+    return output.getNumReady() > 0;
+}
+
+/**
+ * @brief Sends a Settings record.
+ */
+void ServiceClient::setSettings(const ServiceSettings& settings)
+{
+    ServiceProtocol::Message message;
+    message.type = ServiceProtocol::Message::Type::Settings;
+    message.settings = settings;
+    send(message);
+}
+
+/**
+ * @brief Sends a Reset record.
+ */
+void ServiceClient::reset()
+{
+    ServiceProtocol::Message message;
+    message.type = ServiceProtocol::Message::Type::Reset;
+    send(message);
+}
+
+/**
+ * @brief Writes one record completely (records are small; a short write is retried).
+ */
+void ServiceClient::send(const ServiceProtocol::Message& message)
+{
+#if UMBRA_HAS_SERVICE
+    size_t sent = 0;
+    while (sent < sizeof(message))
+    {
+        const ssize_t n = ::send(socket, reinterpret_cast<const char*>(&message) + sent, sizeof(message) - sent, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            fail("Cannot send to the reverb service");
+        sent += static_cast<size_t>(n);
+    }
+#else
+    (void) message;
+#endif
+}
+
+/**
+ * @brief One byte on the wake pipe; a full pipe already holds a pending wake-up.
+ */
+void ServiceClient::wakeService()
+{
+#if UMBRA_HAS_SERVICE
+    const char byte = 1;
+    (void) !::write(wakeServiceFd, &byte, 1);
+#endif
+}
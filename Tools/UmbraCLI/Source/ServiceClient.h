@@ -0,0 +1,117 @@
+#pragma once
+
+// Standard library
+#include <cstddef>
+#include <string>
+
+// Project headers
+#include "ServiceProtocol.h"
+
+/**
+ * @class ServiceClient
+ * @brief One session with a running reverb service (UmbraCLI serve).
+ *
+ * Meant to be compiled into other processes (transcoders, cleaners): it
+ * only needs POSIX and ServiceProtocol.h, not JUCE or the engine.
+ *
+ * The constructor creates the shared region (anonymous POSIX shared memory,
+ * unlinked right away) and two wake-up pipes, connects to the service
+ * socket and hands them over with Hello. The service assigns one engine
+ * from its pool for the lifetime of the session.
+ *
+ * Audio is pushed with write() and pulled with read(); both only touch the
+ * shared rings and send a one-byte wake-up, so they never block. The output
+ * lags the input by whatever the service has not processed yet; waitForOutput()
+ * sleeps until the service reports progress. Settings are applied by the
+ * next processing step with a ramp, without rebuilding anything.
+ *
+ * Wake-ups to a service that has gone away raise SIGPIPE; processes that
+ * must survive that should ignore the signal (UmbraCLI remote does).
+ */
+class ServiceClient
+{
+public:
+    /**
+     * @brief Opens a session.
+     * @param socketPath Path of the service socket.
+     * @param numChannels Channels per direction (1 or 2).
+     * @param sampleRate Sample rate of the audio (must match the service).
+     * @param capacity Ring length in frames per channel (rounded up to a power of two).
+     * @param deadlineMilliseconds Time the service may take from data arrival to output.
+     * @param settings Initial parameter values.
+     * @throws std::invalid_argument if numChannels or capacity is out of range.
+     * @throws std::runtime_error if the service cannot be reached or refuses the session.
+     */
+    ServiceClient(const std::string& socketPath, int numChannels, double sampleRate,
+        int capacity = 16384, double deadlineMilliseconds = 20.0,
+        const ServiceSettings& settings = {});
+
+    /** @brief Closes the session (the service returns the engine to its pool). */
+    ~ServiceClient();
+
+    // Copy and move operations are deleted (the client owns descriptors and a mapping)
+    ServiceClient(const ServiceClient&) = delete;
+    ServiceClient& operator=(const ServiceClient&) = delete;
+    ServiceClient(ServiceClient&&) = delete;
+    ServiceClient& operator=(ServiceClient&&) = delete;
+
+    /**
+     * @brief Queues input frames for the service.
+     * @param channels numChannels source pointers.
+     * @param numSamples Frames offered.
+     * @return Frames accepted (less than offered when the input ring is full).
+     */
+    int write(const float* const* channels, int numSamples);
+
+    /**
+     * @brief Takes processed frames.
+     * @param channels numChannels destination pointers.
+     * @param numSamples Frames wanted.
+     * @return Frames delivered (what the service has produced so far, at most numSamples).
+     */
+    int read(float* const* channels, int numSamples);
+
+    /**
+     * @brief Sleeps until processed frames are available.
+     * @param timeoutMilliseconds Longest wait (-1 = no limit).
+     * @return True if output is ready.
+     * @throws std::runtime_error if the service closed the session.
+     */
+    bool waitForOutput(int timeoutMilliseconds);
+
+    /**
+     * @brief Sends new parameter values (ramped in by the next processing step).
+     * @param settings Parameter values.
+     * @throws std::runtime_error if the message cannot be sent.
+     */
+    void setSettings(const ServiceSettings& settings);
+
+    /**
+     * @brief Asks the service to clear the engine state before the next step.
+     * @throws std::runtime_error if the message cannot be sent.
+     */
+    void reset();
+
+    /** @brief Largest number of frames the service processes per step. */
+    int getBlockSize() const { return blockSize; }
+
+    /** @brief Frames processed and not read yet. */
+    int getNumReady() const { return output.getNumReady(); }
+
+private:
+    /** @brief Sends one control record. */
+    void send(const ServiceProtocol::Message& message);
+
+    /** @brief Writes a wake-up byte to the service (never blocks). */
+    void wakeService();
+
+    int numChannels = 0;       ///< Channels per direction
+    int blockSize = 0;         ///< Service block size (from Welcome)
+    int socket = -1;           ///< Control connection
+    int wakeServiceFd = -1;    ///< Write end of the client-to-service wake pipe
+    int wakeClientFd = -1;     ///< Read end of the service-to-client wake pipe
+    void* shared = nullptr;    ///< Mapped region
+    size_t sharedBytes = 0;    ///< Size of the mapping
+    ServiceRing input;         ///< Client to service
+    ServiceRing output;        ///< Service to client
+};
@@ -0,0 +1,271 @@
+#pragma once
+
+// Standard library
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @struct ServiceSettings
+ * @brief Reverb parameter values a service client asks for.
+ *
+ * Same fields and defaults as ReverbParameters, kept free of JUCE so that
+ * client processes only need this header and ServiceClient.
+ */
+struct ServiceSettings
+{
+    float mix = 1.0f;            ///< Dry/wet mix (0.0 = dry, 1.0 = fully wet)
+    float stereoWidth = 1.0f;    ///< Stereo width factor
+    float lowPass = 20000.0f;    ///< Low-pass cutoff (Hz)
+    float highPass = 20.0f;      ///< High-pass cutoff (Hz)
+    float dampening = 8000.0f;   ///< FDN damping cutoff (Hz)
+    float roomSize = 1.0f;       ///< FDN delay scaling
+    float initialDelay = 0.0f;   ///< Pre-delay (seconds)
+    float outputGain = 1.0f;     ///< Linear output gain
+};
+
+/**
+ * @class ServiceRing
+ * @brief Single-producer, single-consumer planar audio ring in shared memory.
+ *
+ * The positions are free-running 64-bit frame counters in a Header that
+ * lives in the shared region, each on its own cache line; the producer only
+ * stores write and the consumer only stores read (release), each loading the
+ * other's counter with acquire. No locks and no system calls, so client and
+ * service exchange audio through the mapping without any copy through the
+ * kernel. Samples are planar (capacity frames per channel) so every transfer
+ * is at most two memcpy calls per channel.
+ */
+class ServiceRing
+{
+public:
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+        "Ring positions must be lock-free to be shared between processes");
+
+    /**
+     * @struct Header
+     * @brief Positions shared by producer and consumer.
+     */
+    struct Header
+    {
+        alignas(64) std::atomic<uint64_t> write { 0 }; ///< Frames written so far (producer)
+        alignas(64) std::atomic<uint64_t> read { 0 };  ///< Frames read so far (consumer)
+    };
+
+    /** @brief Default constructor (produces an empty, unusable ring). */
+    ServiceRing() = default;
+
+    /**
+     * @brief Attaches to a ring laid out in shared memory.
+     * @param header Positions.
+     * @param data numChannels x capacity samples.
+     * @param numChannels Channel count.
+     * @param capacity Frames per channel (a power of two).
+     */
+    ServiceRing(Header* header, float* data, int numChannels, int capacity)
+        : header(header), data(data), numChannels(numChannels), capacity(capacity)
+    {
+    }
+
+    /** @brief Frames the consumer can read. */
+    int getNumReady() const
+    {
+        return static_cast<int>(header->write.load(std::memory_order_acquire)
+            - header->read.load(std::memory_order_relaxed));
+    }
+
+    /** @brief Frames the producer can write. */
+    int getNumFree() const
+    {
+        return capacity - static_cast<int>(header->write.load(std::memory_order_relaxed)
+            - header->read.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Appends up to numSamples frames (producer side).
+     * @param channels numChannels source pointers.
+     * @param numSamples Frames offered.
+     * @return Frames written (limited by the free space).
+     */
+    int write(const float* const* channels, int numSamples)
+    {
+        const int count = std::min(numSamples, getNumFree());
+        if (count <= 0)
+            return 0;
+
+        const uint64_t position = header->write.load(std::memory_order_relaxed);
+        for (int ch = 0; ch < numChannels; ++ch)
+            store(data + static_cast<size_t>(ch) * capacity, position, channels[ch], count);
+
+        header->write.store(position + static_cast<uint64_t>(count), std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Removes up to numSamples frames (consumer side).
+     * @param channels numChannels destination pointers.
+     * @param numSamples Frames wanted.
+     * @return Frames read (limited by what is ready).
+     */
+    int read(float* const* channels, int numSamples)
+    {
+        const int count = std::min(numSamples, getNumReady());
+        if (count <= 0)
+            return 0;
+
+        const uint64_t position = header->read.load(std::memory_order_relaxed);
+        for (int ch = 0; ch < numChannels; ++ch)
+            load(data + static_cast<size_t>(ch) * capacity, position, channels[ch], count);
+
+        header->read.store(position + static_cast<uint64_t>(count), std::memory_order_release);
+        return count;
+    }
+
+private:
+    /** @brief Ring index of a position. */
+    int wrap(uint64_t position) const
+    {
+        return static_cast<int>(position & static_cast<uint64_t>(capacity - 1));
+    }
+
+    /** @brief Copies count frames into one ring channel at position, wrapping once if needed. */
+    void store(float* ring, uint64_t position, const float* source, int count) const
+    {
+        const int start = wrap(position);
+        const int first = std::min(count, capacity - start);
+        std::memcpy(ring + start, source, sizeof(float) * static_cast<size_t>(first));
+        std::memcpy(ring, source + first, sizeof(float) * static_cast<size_t>(count - first));
+    }
+
+    /** @brief Copies count frames out of one ring channel at position, wrapping once if needed. */
+    void load(const float* ring, uint64_t position, float* destination, int count) const
+    {
+        const int start = wrap(position);
+        const int first = std::min(count, capacity - start);
+        std::memcpy(destination, ring + start, sizeof(float) * static_cast<size_t>(first));
+        std::memcpy(destination + first, ring, sizeof(float) * static_cast<size_t>(count - first));
+    }
+
+    Header* header = nullptr; ///< Shared positions
+    float* data = nullptr;    ///< Shared samples, planar
+    int numChannels = 0;      ///< Channel count
+    int capacity = 0;         ///< Frames per channel (power of two)
+};
+
+/**
+ * @class ServiceProtocol
+ * @brief Wire format between the reverb service and its clients.
+ *
+ * Control runs over a Unix stream socket as fixed-size Message records.
+ * A client opens with Hello and passes three descriptors with it
+ * (SCM_RIGHTS): its shared memory region, the read end of the pipe it uses
+ * to wake the service, and the write end of the pipe the service uses to
+ * wake it. The service answers with Welcome (or Error and closes). After
+ * that the client may send Settings and Reset at any time; closing the
+ * socket ends the session. Wake-ups are single bytes; audio never goes
+ * through the socket or the pipes.
+ *
+ * The shared region starts with a Layout, followed by the input ring
+ * (client to service) and the output ring (service to client), each
+ * numChannels x capacity floats.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class ServiceProtocol
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    ServiceProtocol() = delete;
+
+    static constexpr uint32_t magic = 0x56534d55; ///< "UMSV" at the start of the shared region
+    static constexpr uint32_t version = 1;        ///< Bumped on any layout or message change
+    static constexpr int maxChannels = 2;         ///< Reverb inputs are mono or stereo
+    static constexpr int maxCapacity = 1 << 22;   ///< Largest ring (frames per channel)
+
+    /**
+     * @struct Layout
+     * @brief Start of the shared region.
+     */
+    struct Layout
+    {
+        uint32_t magic = 0;        ///< ServiceProtocol::magic
+        uint32_t version = 0;      ///< ServiceProtocol::version
+        uint32_t numChannels = 0;  ///< Channels in both rings
+        uint32_t capacity = 0;     ///< Frames per channel in each ring
+        ServiceRing::Header input;  ///< Client to service
+        ServiceRing::Header output; ///< Service to client
+    };
+
+    /**
+     * @struct Message
+     * @brief One control record (both directions).
+     */
+    struct Message
+    {
+        /**
+         * @enum Type
+         * @brief Meaning of a record.
+         */
+        enum class Type : uint32_t
+        {
+            Hello = 1, ///< Client: open a session (descriptors attached)
+            Welcome,   ///< Service: session open, engine assigned
+            Settings,  ///< Client: new parameter values (ramped in by the next job)
+            Reset,     ///< Client: clear the engine state (tail, delays)
+            Error      ///< Service: request refused (text in error)
+        };
+
+        Type type = Type::Hello;          ///< Record type
+        uint32_t version = ServiceProtocol::version; ///< Sender's protocol version
+        uint32_t numChannels = 0;         ///< Hello: channels per ring
+        uint32_t capacity = 0;            ///< Hello: frames per ring channel
+        uint32_t deadlineMicroseconds = 0; ///< Hello: time budget from data arrival to output
+        int32_t blockSize = 0;            ///< Welcome: engine block size (largest job step)
+        double sampleRate = 0.0;          ///< Hello: client rate; Welcome: service rate
+        ServiceSettings settings;         ///< Hello, Settings: parameter values
+        char error[96] = {};              ///< Error: reason
+    };
+
+    /**
+     * @brief Size of the shared region for a ring shape.
+     * @param numChannels Channels per ring.
+     * @param capacity Frames per ring channel.
+     * @return Bytes (layout plus both rings).
+     */
+    static size_t getSharedBytes(int numChannels, int capacity)
+    {
+        return sizeof(Layout) + 2 * sizeof(float) * static_cast<size_t>(numChannels) * static_cast<size_t>(capacity);
+    }
+
+    /**
+     * @brief Input ring (client to service) inside a mapped region.
+     */
+    static ServiceRing getInput(void* shared)
+    {
+        auto* layout = static_cast<Layout*>(shared);
+        return ServiceRing(&layout->input, samples(shared), static_cast<int>(layout->numChannels),
+            static_cast<int>(layout->capacity));
+    }
+
+    /**
+     * @brief Output ring (service to client) inside a mapped region.
+     */
+    static ServiceRing getOutput(void* shared)
+    {
+        auto* layout = static_cast<Layout*>(shared);
+        return ServiceRing(&layout->output,
+            samples(shared) + static_cast<size_t>(layout->numChannels) * layout->capacity,
+            static_cast<int>(layout->numChannels), static_cast<int>(layout->capacity));
+    }
+
+private:
+    /** @brief First sample after the layout. */
+    static float* samples(void* shared)
+    {
+        return reinterpret_cast<float*>(static_cast<char*>(shared) + sizeof(Layout));
+    }
+};
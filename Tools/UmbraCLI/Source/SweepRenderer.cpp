@@ -0,0 +1,328 @@
+#include "SweepRenderer.h"
+#include "AcousticMetrics.h"
+#include "MappedWavReader.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <time.h>
+ #define UMBRA_HAS_THREAD_CPU_TIME 1
+#else
+ #define UMBRA_HAS_THREAD_CPU_TIME 0
+#endif
+
+namespace
+{
+    constexpr int chunkSize = 16384; ///< Frames processed and written per step (multiple of any block size used)
+
+    /**
+     * @brief CPU time consumed by the calling thread (wall time where unavailable).
+     */
+    double threadCpuSeconds()
+    {
+#if UMBRA_HAS_THREAD_CPU_TIME
+        timespec ts {};
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+            return static_cast<double>(ts.tv_sec) + 1.0e-9 * static_cast<double>(ts.tv_nsec);
+#endif
+        return juce::Time::getMillisecondCounterHiRes() * 0.001;
+    }
+
+    double toDb(double power)
+    {
+        return power > 0.0 ? 10.0 * std::log10(power) : -std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @class Worker
+     * @brief Engine and buffers of one pool thread, reused for all its points.
+     */
+    class Worker
+    {
+    public:
+        Worker(const SweepRenderer::Config& config, double fs, const juce::AudioBuffer<float>& source)
+            : config(config), fs(fs), source(source),
+            reverb(static_cast<float>(fs), config.blockSize, config.options),
+            chunk(2, chunkSize),
+            ir(2, juce::jmax(1, static_cast<int>(config.rt60Seconds * fs)))
+        {
+            // Frozen mode: every engine finishes its grid before its first point
+            reverb.waitForFrozenGrid();
+        }
+
+        /**
+         * @brief Renders one grid point.
+         * @throws std::runtime_error if the output file cannot be written.
+         */
+        SweepRenderer::Render render(int index, const ReverbParameters& parameters, double inputEnergy)
+        {
+            SweepRenderer::Render result;
+            result.index = index;
+            result.parameters = parameters;
+
+            // RT60 of the wet response: impulse on both inputs, fully wet
+            if (config.rt60Seconds > 0.0)
+            {
+                ReverbParameters wet = parameters;
+                wet.mix = 1.0f;
+                wet.outputGain = 1.0f;
+
+                reverb.reset();
+                ir.clear();
+                ir.setSample(0, 0, 1.0f);
+                ir.setSample(1, 0, 1.0f);
+                reverb.process(ir, wet);
+
+                double rt60 = 0.0;
+                for (int ch = 0; ch < 2; ++ch)
+                    rt60 += 0.5 * AcousticMetrics::decayTime(
+                        AcousticMetrics::energyDecayCurve(ir.getReadPointer(ch), ir.getNumSamples()), fs);
+                result.rt60 = rt60;
+            }
+
+            // Input plus tail, from a clean engine
+            reverb.reset();
+
+            std::unique_ptr<juce::AudioFormatWriter> writer;
+            if (config.writeAudio)
+            {
+                result.output = config.outputDirectory.getChildFile(
+                    config.input.getFileNameWithoutExtension() + "_" + juce::String(index).paddedLeft('0', 4) + ".wav");
+                writer = createWriter(result.output);
+            }
+
+            const int64_t inputSamples = source.getNumSamples();
+            const int64_t total = inputSamples + static_cast<int64_t>(config.tailSeconds * fs);
+            double energy = 0.0;
+            float peak = 0.0f;
+
+            for (int64_t done = 0; done < total;)
+            {
+                const int numSamples = static_cast<int>(juce::jmin<int64_t>(total - done, chunkSize));
+                const int fromInput = static_cast<int>(juce::jlimit<int64_t>(0, numSamples, inputSamples - done));
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    if (fromInput > 0)
+                        chunk.copyFrom(ch, 0, source, ch, static_cast<int>(done), fromInput);
+                    if (fromInput < numSamples)
+                        chunk.clear(ch, fromInput, numSamples - fromInput);
+                }
+
+                juce::AudioBuffer<float> view(chunk.getArrayOfWritePointers(), 2, numSamples);
+                const double cpuStart = threadCpuSeconds();
+                reverb.process(view, parameters);
+                result.cpuSeconds += threadCpuSeconds() - cpuStart;
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    const float* data = view.getReadPointer(ch);
+                    for (int n = 0; n < numSamples; ++n)
+                    {
+                        energy += static_cast<double>(data[n]) * data[n];
+                        peak = juce::jmax(peak, std::abs(data[n]));
+                    }
+                }
+
+                if (writer != nullptr && !writer->writeFromFloatArrays(view.getArrayOfReadPointers(), 2, numSamples))
+                    throw std::runtime_error("Cannot write " + result.output.getFullPathName().toStdString());
+                done += numSamples;
+            }
+
+            result.energyDb = toDb(energy) - toDb(inputEnergy);
+            result.peakDb = toDb(static_cast<double>(peak) * peak);
+            result.realtime = result.cpuSeconds > 0.0 ? static_cast<double>(total) / fs / result.cpuSeconds : 0.0;
+            return result;
+        }
+
+    private:
+        std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file) const
+        {
+            auto stream = file.createOutputStream();
+            if (stream == nullptr || !stream->openedOk())
+                throw std::runtime_error("Cannot open " + file.getFullPathName().toStdString());
+            stream->setPosition(0);
+            stream->truncate();
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wav.createWriterFor(stream.get(), fs, 2, config.bitDepth, {}, 0));
+            if (writer == nullptr)
+                throw std::runtime_error("Cannot create a WAV writer for " + file.getFullPathName().toStdString());
+            stream.release(); // now owned by the writer
+            return writer;
+        }
+
+        const SweepRenderer::Config& config;      ///< Sweep settings
+        double fs = 0.0;                          ///< Sample rate
+        const juce::AudioBuffer<float>& source;   ///< Decoded input (shared, read-only)
+        Reverb reverb;                            ///< Engine reused for every point
+        juce::AudioBuffer<float> chunk;           ///< Processing block
+        juce::AudioBuffer<float> ir;              ///< Impulse response for RT60
+    };
+}
+
+/**
+ * @brief Cartesian product, room size outermost.
+ */
+std::vector<ReverbParameters> SweepRenderer::expand(const ReverbParameters& base, const Grid& grid)
+{
+    std::vector<ReverbParameters> points;
+    for (float roomSize : grid.roomSize)
+        for (float dampening : grid.dampening)
+            for (float lowPass : grid.lowPass)
+                for (float highPass : grid.highPass)
+                    for (float initialDelay : grid.initialDelay)
+                    {
+                        ReverbParameters p = base;
+                        p.roomSize = roomSize;
+                        p.dampening = dampening;
+                        p.lowPass = lowPass;
+                        p.highPass = highPass;
+                        p.initialDelay = initialDelay;
+                        points.push_back(p);
+                    }
+    return points;
+}
+
+/**
+ * @brief Decodes the input, renders all points on a thread pool, writes sweep.csv.
+ *
+ * Steps:
+ * 1. Decode the whole input once (mono is duplicated) into a buffer that
+ *    the workers only read from. Fix the topology seed for all engines.
+ * 2. Start one pool job per worker. A job builds its Worker (engine and
+ *    buffers), then takes point indices from a shared counter until none
+ *    are left, resetting the engine between points.
+ * 3. Wait for the jobs, rethrow the first error, and write sweep.csv.
+ *
+ * @param config Files and settings.
+ * @return Metrics per grid point.
+ */
+SweepRenderer::Summary SweepRenderer::run(const Config& config)
+{
+    if (config.blockSize < 1 || chunkSize % config.blockSize != 0)
+        throw std::invalid_argument("Block size must divide " + std::to_string(chunkSize) + ".");
+    if (config.bitDepth != 16 && config.bitDepth != 24 && config.bitDepth != 32)
+        throw std::invalid_argument("Bit depth must be 16, 24 or 32.");
+
+    const auto points = expand(config.base, config.grid);
+    if (points.empty())
+        throw std::invalid_argument("The sweep grid is empty.");
+
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    Summary summary;
+
+    // Step 1: decode once, shared read-only by all workers
+    MappedWavReader reader(config.input);
+    if (reader.getLengthInSamples() > std::numeric_limits<int>::max() - chunkSize)
+        throw std::runtime_error("Input is too long to decode for a sweep; use render per preset instead.");
+
+    summary.sampleRate = reader.getSampleRate();
+    summary.inputSamples = reader.getLengthInSamples();
+
+    juce::AudioBuffer<float> decoded(2, static_cast<int>(summary.inputSamples));
+    for (int done = 0; reader.getRemainingSamples() > 0;)
+    {
+        juce::AudioBuffer<float> view(decoded.getArrayOfWritePointers(), 2, done, decoded.getNumSamples() - done);
+        done += reader.read(view, view.getNumSamples());
+    }
+    if (reader.getNumChannels() == 1)
+        decoded.copyFrom(1, 0, decoded, 0, 0, decoded.getNumSamples());
+    const juce::AudioBuffer<float>& source = decoded;
+    summary.decodeSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+
+    double inputEnergy = 0.0;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int n = 0; n < source.getNumSamples(); ++n)
+            inputEnergy += static_cast<double>(source.getSample(ch, n)) * source.getSample(ch, n);
+
+    if (!config.outputDirectory.isDirectory() && !config.outputDirectory.createDirectory())
+        throw std::runtime_error("Cannot create " + config.outputDirectory.getFullPathName().toStdString());
+
+    // One topology for the whole sweep
+    Config shared = config;
+    if (shared.options.seed == 0)
+        shared.options.seed = std::random_device{}() | 1u;
+    summary.seed = shared.options.seed;
+
+    // Step 2: workers
+    const int numPoints = static_cast<int>(points.size());
+    const int cpus = juce::jmax(1, juce::SystemStats::getNumCpus());
+    summary.threads = juce::jlimit(1, numPoints, config.threads > 0 ? config.threads : cpus);
+    summary.renders.resize(points.size());
+
+    std::atomic<int> next { 0 };
+    std::atomic<int> running { summary.threads };
+    juce::WaitableEvent finished;
+    std::mutex errorLock;
+    std::string error;
+
+    juce::ThreadPool pool(summary.threads);
+    for (int t = 0; t < summary.threads; ++t)
+    {
+        pool.addJob([&]
+        {
+            try
+            {
+                Worker worker(shared, summary.sampleRate, source);
+                for (int i = next.fetch_add(1); i < numPoints; i = next.fetch_add(1))
+                    summary.renders[static_cast<size_t>(i)] = worker.render(i, points[static_cast<size_t>(i)], inputEnergy);
+            }
+            catch (const std::exception& e)
+            {
+                next.store(numPoints); // stop the other workers after their current point
+                const std::lock_guard<std::mutex> lock(errorLock);
+                if (error.empty())
+                    error = e.what();
+            }
+
+            if (running.fetch_sub(1) == 1)
+                finished.signal();
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+    }
+
+    // Step 3: collect
+    finished.wait();
+    if (!error.empty())
+        throw std::runtime_error(error);
+
+    const auto csv = config.outputDirectory.getChildFile("sweep.csv");
+    if (!csv.replaceWithText(formatCsv(summary)))
+        throw std::runtime_error("Cannot write " + csv.getFullPathName().toStdString());
+
+    summary.seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+    return summary;
+}
+
+/**
+ * @brief One row per point: index, swept values, metrics and file name.
+ */
+juce::String SweepRenderer::formatCsv(const Summary& summary)
+{
+    juce::String csv;
+    csv << "index,roomSize,dampening,lowPass,highPass,initialDelay,rt60,energyDb,peakDb,cpuSeconds,realtime,file\n";
+
+    for (const auto& r : summary.renders)
+    {
+        csv << r.index << ","
+            << juce::String(r.parameters.roomSize, 4) << ","
+            << juce::String(r.parameters.dampening, 1) << ","
+            << juce::String(r.parameters.lowPass, 1) << ","
+            << juce::String(r.parameters.highPass, 1) << ","
+            << juce::String(r.parameters.initialDelay, 4) << ","
+            << juce::String(r.rt60, 3) << ","
+            << juce::String(r.energyDb, 2) << ","
+            << juce::String(r.peakDb, 2) << ","
+            << juce::String(r.cpuSeconds, 3) << ","
+            << juce::String(r.realtime, 1) << ","
+            << r.output.getFileName() << "\n";
+    }
+    return csv;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Standard library
+#include <cstdint>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+/**
+ * @class SweepRenderer
+ * @brief Renders one input through a grid of parameter sets in parallel.
+ *
+ * For preset design: the input is decoded once into a buffer all workers
+ * read from, and the grid points (every combination of the listed room
+ * sizes, damping, low-pass, high-pass and pre-delay values) are shared out
+ * to a juce::ThreadPool. Each worker builds one Reverb and reuses it for
+ * all its points, calling Reverb::reset() in between, so engines are not
+ * rebuilt (nor their memory allocated and prefaulted) per point. With the
+ * same seed a reset engine renders exactly what a new one would.
+ *
+ * Per point the worker optionally renders the wet impulse response and
+ * takes its RT60 (T30 fit of the energy decay curve), then renders the
+ * input plus tail, writes it to its own WAV file and records the output
+ * energy, peak level and the CPU time of its thread.
+ *
+ * This class is non-instantiable; all functions are static.
+ */
+class SweepRenderer
+{
+public:
+    /**
+     * @brief Delete default constructor to prevent instantiation.
+     */
+    SweepRenderer() = delete;
+
+    /**
+     * @struct Grid
+     * @brief Values per parameter; the sweep renders every combination.
+     */
+    struct Grid
+    {
+        std::vector<float> roomSize { 1.0f };        ///< ReverbParameters::roomSize values
+        std::vector<float> dampening { 8000.0f };    ///< ReverbParameters::dampening values (Hz)
+        std::vector<float> lowPass { 20000.0f };     ///< ReverbParameters::lowPass values (Hz)
+        std::vector<float> highPass { 20.0f };       ///< ReverbParameters::highPass values (Hz)
+        std::vector<float> initialDelay { 0.0f };    ///< ReverbParameters::initialDelay values (s)
+    };
+
+    /**
+     * @struct Config
+     * @brief Sweep job.
+     */
+    struct Config
+    {
+        juce::File input;            ///< Uncompressed WAV / RF64 input
+        juce::File outputDirectory;  ///< Receives sweep.csv and one WAV per point (created if missing)
+        int blockSize = 512;         ///< Reverb block size
+        int bitDepth = 24;           ///< Output bit depth (16, 24 or 32)
+        double tailSeconds = 2.0;    ///< Silence rendered after the input
+        double rt60Seconds = 3.0;    ///< Impulse response length for RT60 (0 = skip)
+        int threads = 0;             ///< Worker threads (0 = one per CPU, capped at the point count)
+        bool writeAudio = true;      ///< False: metrics only
+        ReverbOptions options;       ///< Engine options (a random seed is fixed once for all points)
+        ReverbParameters base;       ///< Values of the parameters not swept (mix, width, gain)
+        Grid grid;                   ///< Swept values
+    };
+
+    /**
+     * @struct Render
+     * @brief Outcome of one grid point.
+     */
+    struct Render
+    {
+        int index = 0;                ///< Position in the grid
+        ReverbParameters parameters;  ///< Values rendered
+        juce::File output;            ///< Written file (empty without audio output)
+        double rt60 = 0.0;            ///< Wet RT60 in seconds (0 if skipped or not reached)
+        double energyDb = 0.0;        ///< Output energy relative to the input energy
+        double peakDb = 0.0;          ///< Output peak in dBFS
+        double cpuSeconds = 0.0;      ///< CPU time of the render (thread time, I/O excluded)
+        double realtime = 0.0;        ///< Output seconds per CPU second
+    };
+
+    /**
+     * @struct Summary
+     * @brief Outcome of the whole sweep.
+     */
+    struct Summary
+    {
+        double sampleRate = 0.0;      ///< Input sample rate
+        int64_t inputSamples = 0;     ///< Decoded input frames
+        uint32_t seed = 0;            ///< Topology seed shared by all engines
+        int threads = 0;              ///< Workers (and engines) used
+        double decodeSeconds = 0.0;   ///< Time to decode the input
+        double seconds = 0.0;         ///< Wall-clock time of the sweep
+        std::vector<Render> renders;  ///< One entry per grid point, in grid order
+    };
+
+    /**
+     * @brief Lists every grid combination.
+     * @param base Values of the parameters that are not swept.
+     * @param grid Swept values (room size varies slowest, pre-delay fastest).
+     * @return Parameter sets in grid order.
+     */
+    static std::vector<ReverbParameters> expand(const ReverbParameters& base, const Grid& grid);
+
+    /**
+     * @brief Runs the sweep.
+     * @param config Files and settings.
+     * @return Metrics per grid point; sweep.csv is written as well.
+     * @throws std::runtime_error if the input cannot be read, is too long to
+     *         decode, or an output cannot be written.
+     * @throws std::invalid_argument if the grid is empty or the block size or
+     *         bit depth is invalid.
+     */
+    static Summary run(const Config& config);
+
+    /**
+     * @brief Formats the per-point metrics as CSV (one header line).
+     * @param summary Sweep outcome.
+     * @return CSV text.
+     */
+    static juce::String formatCsv(const Summary& summary);
+};
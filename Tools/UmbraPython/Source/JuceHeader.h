@@ -0,0 +1,16 @@
+/**
+ * @file JuceHeader.h
+ * @brief JUCE modules used by the engine, for builds without the Projucer.
+ *
+ * The engine sources include <JuceHeader.h>; in the plugin and UmbraCLI
+ * the Projucer generates it. setup.py puts this directory first on the
+ * include path and compiles the same modules, with their configuration
+ * passed as preprocessor definitions.
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
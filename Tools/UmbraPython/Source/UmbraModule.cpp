@@ -0,0 +1,712 @@
+/**
+ * @file UmbraModule.cpp
+ * @brief Python extension module "umbra" exposing the Reverb engine.
+ *
+ * Audio is passed as writable float32 arrays (NumPy or anything else with
+ * the buffer protocol) of shape (channels, samples) or (samples,), and is
+ * processed in place: each row becomes one channel pointer of a
+ * non-owning juce::AudioBuffer, so nothing is copied. Rows may be strided
+ * (e.g. x[:, 1000:2000]) as long as the samples of a row are contiguous.
+ *
+ * The GIL is released while the engine runs, so Python threads processing
+ * different Reverb objects run in parallel. process_batch() processes
+ * many arrays in one native call, paying the argument checks and the GIL
+ * round trip once.
+ *
+ * Build with setup.py (see README).
+ */
+
+// Python (must come first, it sets feature macros for the standard headers)
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+// Standard library
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// JUCE
+#include <JuceHeader.h>
+
+// Project headers
+#include "../../../Source/Reverb.h"
+
+namespace
+{
+    /**
+     * @struct Engine
+     * @brief Native state behind one umbra.Reverb object.
+     */
+    struct Engine
+    {
+        Engine(float fs, int blockSize, const ReverbOptions& options)
+            : reverb(fs, blockSize, options), fs(fs), blockSize(blockSize)
+        {
+        }
+
+        /** @brief Claims the engine for one call; false if another thread is processing it. */
+        bool tryAcquire() { return !busy.exchange(true, std::memory_order_acquire); }
+
+        /** @brief Ends a call started with tryAcquire(). */
+        void release() { busy.store(false, std::memory_order_release); }
+
+        /**
+         * @brief Returns the ramp for the next buffer and advances the automation state.
+         *
+         * Like the plugin, each buffer ramps from the values used at the end
+         * of the previous one to the current attribute values.
+         */
+        std::pair<ReverbParameters, ReverbParameters> nextRamp()
+        {
+            const auto start = hasPrevious ? previous : parameters;
+            previous = parameters;
+            hasPrevious = true;
+            return { start, parameters };
+        }
+
+        Reverb reverb;                  ///< The engine
+        float fs = 0.0f;                ///< Sample rate in Hz
+        int blockSize = 0;              ///< Prepared block size
+        ReverbParameters parameters;    ///< Current attribute values
+        ReverbParameters previous;      ///< Values at the end of the last buffer
+        bool hasPrevious = false;       ///< False until the first buffer
+        std::atomic<bool> busy { false }; ///< Set while a call processes the engine without the GIL
+    };
+
+    /**
+     * @struct ReverbObject
+     * @brief Python object layout of umbra.Reverb.
+     */
+    struct ReverbObject
+    {
+        PyObject_HEAD
+        Engine* engine; ///< Null until __init__ succeeds
+    };
+
+    /**
+     * @class ChannelView
+     * @brief Locks a writable float32 array and exposes its rows as channel pointers.
+     *
+     * Holding the buffer view keeps the exporter (e.g. a NumPy array) from
+     * being resized or freed while the GIL is released.
+     */
+    class ChannelView
+    {
+    public:
+        ChannelView() = default;
+
+        /** @brief Releases the view (requires the GIL). */
+        ~ChannelView()
+        {
+            if (acquired)
+                PyBuffer_Release(&view);
+        }
+
+        // Copy and move operations are deleted: the view is released exactly once
+        ChannelView(const ChannelView&) = delete;
+        ChannelView& operator=(const ChannelView&) = delete;
+
+        /**
+         * @brief Locks the array.
+         * @param object Array with the buffer protocol.
+         * @return False with a Python exception set if it is not a writable
+         *         float32 array of 1 or 2 channels with contiguous samples.
+         */
+        bool acquire(PyObject* object)
+        {
+            if (PyObject_GetBuffer(object, &view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) != 0)
+                return false;
+            acquired = true;
+
+            const char* format = view.format != nullptr ? view.format : "B";
+            if (format[0] == '@' || format[0] == '=' || format[0] == (isLittleEndian() ? '<' : '>'))
+                ++format;
+            if (std::strcmp(format, "f") != 0 || view.itemsize != sizeof(float))
+                return fail(PyExc_TypeError, "audio must be a float32 array");
+
+            if (view.ndim != 1 && view.ndim != 2)
+                return fail(PyExc_ValueError, "audio must have shape (channels, samples) or (samples,)");
+
+            const Py_ssize_t numChannels = view.ndim == 2 ? view.shape[0] : 1;
+            const Py_ssize_t length = view.shape[view.ndim - 1];
+            if (numChannels < 1 || numChannels > 2)
+                return fail(PyExc_ValueError, "audio must have 1 or 2 channels");
+            if (length > std::numeric_limits<int>::max())
+                return fail(PyExc_ValueError, "audio is too long for one call");
+            if (length > 1 && view.strides[view.ndim - 1] != static_cast<Py_ssize_t>(sizeof(float)))
+                return fail(PyExc_ValueError,
+                    "samples must be contiguous; pass channel-major audio "
+                    "(e.g. numpy.ascontiguousarray(frames.T) for frame-major data)");
+
+            auto* base = static_cast<char*>(view.buf);
+            for (Py_ssize_t ch = 0; ch < numChannels; ++ch)
+                channels[static_cast<size_t>(ch)] = reinterpret_cast<float*>(base + (view.ndim == 2 ? ch * view.strides[0] : 0));
+            numChannelsInUse = static_cast<int>(numChannels);
+            numSamples = static_cast<int>(length);
+            return true;
+        }
+
+        /** @brief Non-owning buffer over the array rows (no allocation). */
+        juce::AudioBuffer<float> toAudioBuffer()
+        {
+            return juce::AudioBuffer<float>(channels, numChannelsInUse, numSamples);
+        }
+
+    private:
+        static bool isLittleEndian()
+        {
+            const uint16_t probe = 1;
+            return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+        }
+
+        static bool fail(PyObject* type, const char* message)
+        {
+            PyErr_SetString(type, message);
+            return false;
+        }
+
+        Py_buffer view {};          ///< Exported buffer
+        bool acquired = false;      ///< view must be released
+        float* channels[2] {};      ///< Row start pointers
+        int numChannelsInUse = 0;   ///< Rows in use
+        int numSamples = 0;         ///< Row length
+    };
+
+    /**
+     * @brief Returns the engine of an initialized object, or sets an error.
+     */
+    Engine* getEngine(PyObject* self)
+    {
+        auto* engine = reinterpret_cast<ReverbObject*>(self)->engine;
+        if (engine == nullptr)
+            PyErr_SetString(PyExc_RuntimeError, "Reverb.__init__ has not been called");
+        return engine;
+    }
+
+    void setBusyError()
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Reverb is being processed by another thread");
+    }
+
+    //==============================================================================
+    // umbra.Reverb
+
+    void reverbDealloc(PyObject* self)
+    {
+        PyTypeObject* type = Py_TYPE(self);
+        delete reinterpret_cast<ReverbObject*>(self)->engine;
+        type->tp_free(self);
+        Py_DECREF(type); // heap type instances own a type reference
+    }
+
+    PyObject* reverbNew(PyTypeObject* type, PyObject*, PyObject*)
+    {
+        auto* self = reinterpret_cast<ReverbObject*>(type->tp_alloc(type, 0));
+        if (self != nullptr)
+            self->engine = nullptr;
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    int reverbInit(PyObject* object, PyObject* args, PyObject* kwargs)
+    {
+        auto* self = reinterpret_cast<ReverbObject*>(object);
+        static const char* keywords[] = { "sample_rate", "block_size", "seed", "engine", "storage",
+            "early_reflections", "frozen", "frozen_grid", "micro_block_size", "diffuser_threads",
+            "lock_memory", "deterministic", "high_order_fdn", "decay", "matrix", nullptr };
+
+        double fs = 0.0;
+        int blockSize = 512;
+        unsigned long seed = 0;
+        const char* engine = "dvn";
+        const char* storage = "float";
+        const char* matrix = "hadamard";
+        int earlyReflections = 0, frozen = 0, lockMemory = 0, deterministic = 0, highOrderFDN = 0;
+        int roomSizePoints = 0, dampeningPoints = 0;
+        ReverbOptions options;
+
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|iksspp(ii)iipp(ff)s", const_cast<char**>(keywords),
+                &fs, &blockSize, &seed, &engine, &storage, &earlyReflections, &frozen,
+                &roomSizePoints, &dampeningPoints, &options.microBlockSize, &options.diffuserThreads,
+                &lockMemory, &deterministic, &highOrderFDN, &options.decayLow, &options.decayHigh, &matrix))
+            return -1;
+
+        if (fs <= 0.0 || blockSize < 1)
+        {
+            PyErr_SetString(PyExc_ValueError, "sample_rate and block_size must be positive");
+            return -1;
+        }
+
+        if (std::strcmp(engine, "allpass") == 0)
+            options.d1Engine = options.d2Engine = options.d3Engine = Diffuser::Engine::Allpass;
+        else if (std::strcmp(engine, "shared") == 0)
+            options.d1Engine = options.d2Engine = options.d3Engine = Diffuser::Engine::SharedDVN;
+        else if (std::strcmp(engine, "dvn") != 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "engine must be 'dvn', 'shared' or 'allpass'");
+            return -1;
+        }
+
+        if (std::strcmp(storage, "fp16") == 0)
+            options.fdnStorage = DelayLine::Storage::Float16;
+        else if (std::strcmp(storage, "bf16") == 0)
+            options.fdnStorage = DelayLine::Storage::BFloat16;
+        else if (std::strcmp(storage, "float") != 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "storage must be 'float', 'fp16' or 'bf16'");
+            return -1;
+        }
+
+        if (std::strcmp(matrix, "householder") == 0)
+            options.feedbackMatrix = FeedbackMatrixType::Householder;
+        else if (std::strcmp(matrix, "velvet") == 0)
+            options.feedbackMatrix = FeedbackMatrixType::Velvet;
+        else if (std::strcmp(matrix, "hadamard") != 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "matrix must be 'hadamard', 'householder' or 'velvet'");
+            return -1;
+        }
+
+        options.seed = static_cast<uint32_t>(seed);
+        options.earlyReflections = earlyReflections != 0;
+        options.frozen = frozen != 0;
+        options.lockMemory = lockMemory != 0;
+        options.deterministic = deterministic != 0;
+        options.highOrderFDN = highOrderFDN != 0;
+        if (roomSizePoints != 0 || dampeningPoints != 0)
+        {
+            if (roomSizePoints < 1 || dampeningPoints < 1)
+            {
+                PyErr_SetString(PyExc_ValueError, "frozen_grid must be (room size points, damping points), both positive");
+                return -1;
+            }
+            options.frozenGrid.roomSizePoints = roomSizePoints;
+            options.frozenGrid.dampeningPoints = dampeningPoints;
+        }
+
+        // Building the engine allocates and prefaults its memory: no GIL needed
+        Engine* created = nullptr;
+        std::string error;
+        PyObject* errorType = nullptr;
+        Py_BEGIN_ALLOW_THREADS
+        try
+        {
+            created = new Engine(static_cast<float>(fs), blockSize, options);
+        }
+        catch (const std::bad_alloc&)
+        {
+            errorType = PyExc_MemoryError;
+        }
+        catch (const std::invalid_argument& e)
+        {
+            errorType = PyExc_ValueError;
+            error = e.what();
+        }
+        catch (const std::exception& e)
+        {
+            errorType = PyExc_RuntimeError;
+            error = e.what();
+        }
+        Py_END_ALLOW_THREADS
+
+        if (created == nullptr)
+        {
+            if (errorType == PyExc_MemoryError)
+                PyErr_NoMemory();
+            else
+                PyErr_SetString(errorType, error.c_str());
+            return -1;
+        }
+
+        if (self->engine != nullptr && !self->engine->tryAcquire())
+        {
+            delete created;
+            setBusyError();
+            return -1;
+        }
+        delete self->engine;
+        self->engine = created;
+        return 0;
+    }
+
+    PyObject* reverbProcess(PyObject* self, PyObject* audio)
+    {
+        auto* engine = getEngine(self);
+        if (engine == nullptr)
+            return nullptr;
+
+        ChannelView view;
+        if (!view.acquire(audio))
+            return nullptr;
+        if (!engine->tryAcquire())
+        {
+            setBusyError();
+            return nullptr;
+        }
+
+        const auto ramp = engine->nextRamp();
+        auto buffer = view.toAudioBuffer();
+
+        bool failed = false;
+        std::string error;
+        Py_BEGIN_ALLOW_THREADS
+        try
+        {
+            engine->reverb.processRamp(buffer, ramp.first, ramp.second);
+        }
+        catch (const std::exception& e)
+        {
+            failed = true;
+            error = e.what();
+        }
+        Py_END_ALLOW_THREADS
+
+        engine->release();
+        if (failed)
+        {
+            PyErr_SetString(PyExc_RuntimeError, error.c_str());
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyObject* reverbWaitForFrozenGrid(PyObject* self, PyObject* args, PyObject* kwargs)
+    {
+        static const char* keywords[] = { "timeout_ms", nullptr };
+        int timeoutMs = -1;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", const_cast<char**>(keywords), &timeoutMs))
+            return nullptr;
+
+        auto* engine = getEngine(self);
+        if (engine == nullptr)
+            return nullptr;
+        if (!engine->tryAcquire())
+        {
+            setBusyError();
+            return nullptr;
+        }
+
+        bool ready = false;
+        Py_BEGIN_ALLOW_THREADS
+        ready = engine->reverb.waitForFrozenGrid(timeoutMs);
+        Py_END_ALLOW_THREADS
+
+        engine->release();
+        return PyBool_FromLong(ready ? 1 : 0);
+    }
+
+    /**
+     * @struct ParameterField
+     * @brief One ReverbParameters value exposed as a float attribute.
+     */
+    struct ParameterField
+    {
+        float ReverbParameters::*member; ///< Field in ReverbParameters
+    };
+
+    const ParameterField parameterFields[] = {
+        { &ReverbParameters::mix },
+        { &ReverbParameters::stereoWidth },
+        { &ReverbParameters::lowPass },
+        { &ReverbParameters::highPass },
+        { &ReverbParameters::dampening },
+        { &ReverbParameters::roomSize },
+        { &ReverbParameters::initialDelay },
+        { &ReverbParameters::outputGain },
+    };
+
+    void* fieldClosure(int index)
+    {
+        return const_cast<ParameterField*>(&parameterFields[index]);
+    }
+
+    PyObject* getParameter(PyObject* self, void* closure)
+    {
+        auto* engine = getEngine(self);
+        if (engine == nullptr)
+            return nullptr;
+        const auto* field = static_cast<const ParameterField*>(closure);
+        return PyFloat_FromDouble(engine->parameters.*(field->member));
+    }
+
+    int setParameter(PyObject* self, PyObject* value, void* closure)
+    {
+        if (value == nullptr)
+        {
+            PyErr_SetString(PyExc_AttributeError, "Reverb parameters cannot be deleted");
+            return -1;
+        }
+        auto* engine = getEngine(self);
+        if (engine == nullptr)
+            return -1;
+
+        const double number = PyFloat_AsDouble(value);
+        if (number == -1.0 && PyErr_Occurred() != nullptr)
+            return -1;
+        if (!std::isfinite(number))
+        {
+            PyErr_SetString(PyExc_ValueError, "Reverb parameters must be finite");
+            return -1;
+        }
+
+        // Only read under the GIL (process() copies the ramp before releasing it)
+        const auto* field = static_cast<const ParameterField*>(closure);
+        engine->parameters.*(field->member) = static_cast<float>(number);
+        return 0;
+    }
+
+    PyObject* getSeed(PyObject* self, void*)
+    {
+        auto* engine = getEngine(self);
+        return engine != nullptr ? PyLong_FromUnsignedLong(engine->reverb.getSeed()) : nullptr;
+    }
+
+    PyObject* getSampleRate(PyObject* self, void*)
+    {
+        auto* engine = getEngine(self);
+        return engine != nullptr ? PyFloat_FromDouble(engine->fs) : nullptr;
+    }
+
+    PyObject* getBlockSize(PyObject* self, void*)
+    {
+        auto* engine = getEngine(self);
+        return engine != nullptr ? PyLong_FromLong(engine->blockSize) : nullptr;
+    }
+
+    PyMethodDef reverbMethods[] = {
+        { "process", reverbProcess, METH_O,
+          "process(audio)\n--\n\n"
+          "Processes a float32 array of shape (channels, samples) or (samples,) in place.\n"
+          "Parameters ramp from the values used for the previous buffer to the current\n"
+          "attribute values. Releases the GIL while processing." },
+        { "wait_for_frozen_grid", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(reverbWaitForFrozenGrid)),
+          METH_VARARGS | METH_KEYWORDS,
+          "wait_for_frozen_grid(timeout_ms=-1)\n--\n\n"
+          "Waits for the frozen IR grid; True once the tail is convolved (or frozen is off)." },
+        { nullptr, nullptr, 0, nullptr }
+    };
+
+    PyGetSetDef reverbGetSet[] = {
+        { "mix", getParameter, setParameter,
+          "Dry/wet mix (0 = dry, 1 = fully wet)", fieldClosure(0) },
+        { "stereo_width", getParameter, setParameter,
+          "Stereo width factor (1 = original width)", fieldClosure(1) },
+        { "low_pass", getParameter, setParameter,
+          "Low-pass cutoff (Hz)", fieldClosure(2) },
+        { "high_pass", getParameter, setParameter,
+          "High-pass cutoff (Hz)", fieldClosure(3) },
+        { "dampening", getParameter, setParameter,
+          "FDN damping cutoff (Hz)", fieldClosure(4) },
+        { "room_size", getParameter, setParameter,
+          "FDN delay scaling", fieldClosure(5) },
+        { "initial_delay", getParameter, setParameter,
+          "Pre-delay (seconds)", fieldClosure(6) },
+        { "output_gain", getParameter, setParameter,
+          "Linear output gain", fieldClosure(7) },
+        { "seed", getSeed, nullptr,
+          "Topology seed in use (pass it to another Reverb to reproduce the topology)", nullptr },
+        { "sample_rate", getSampleRate, nullptr, "Sample rate in Hz", nullptr },
+        { "block_size", getBlockSize, nullptr, "Prepared block size", nullptr },
+        { nullptr, nullptr, nullptr, nullptr, nullptr }
+    };
+
+    const char* reverbDoc =
+        "Reverb(sample_rate, block_size=512, seed=0, engine='dvn', storage='float',\n"
+        "       early_reflections=False, frozen=False, frozen_grid=(3, 3),\n"
+        "       micro_block_size=0, diffuser_threads=0, lock_memory=False,\n"
+        "       deterministic=False, high_order_fdn=False, decay=(6.0, 2.0),\n"
+        "       matrix='hadamard')\n"
+        "--\n\n"
+        "The Umbra reverb engine. engine is 'dvn', 'shared' or 'allpass'; storage\n"
+        "is 'float', 'fp16' or 'bf16'. deterministic=True (with a non-zero seed)\n"
+        "gives the same output bits for any thread count and on every machine running the same build.\n"
+        "high_order_fdn=True runs one 16-line FDN whose absorption filters give\n"
+        "decay = (T60 below, T60 above the dampening frequency) at room size 1.\n"
+        "matrix is the FDN feedback matrix: 'hadamard', 'householder' or 'velvet'.\n"
+        "Parameters are float attributes (mix, stereo_width, low_pass, high_pass,\n"
+        "dampening, room_size, initial_delay, output_gain) applied by the next\n"
+        "process() call.";
+
+    PyType_Slot reverbSlots[] = {
+        { Py_tp_doc, const_cast<char*>(reverbDoc) },
+        { Py_tp_new, reinterpret_cast<void*>(reverbNew) },
+        { Py_tp_init, reinterpret_cast<void*>(reverbInit) },
+        { Py_tp_dealloc, reinterpret_cast<void*>(reverbDealloc) },
+        { Py_tp_methods, reverbMethods },
+        { Py_tp_getset, reverbGetSet },
+        { 0, nullptr }
+    };
+
+    PyType_Spec reverbSpec = {
+        "umbra.Reverb",
+        static_cast<int>(sizeof(ReverbObject)),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        reverbSlots
+    };
+
+    PyTypeObject* reverbType = nullptr; ///< Created in PyInit_umbra
+
+    //==============================================================================
+    // Module functions
+
+    PyObject* processBatch(PyObject*, PyObject* args)
+    {
+        PyObject* reverbs = nullptr;
+        PyObject* arrays = nullptr;
+        if (!PyArg_ParseTuple(args, "OO", &reverbs, &arrays))
+            return nullptr;
+
+        PyObject* arrayList = PySequence_Fast(arrays, "arrays must be a sequence");
+        if (arrayList == nullptr)
+            return nullptr;
+        std::unique_ptr<PyObject, void (*)(PyObject*)> arrayGuard(arrayList, [](PyObject* o) { Py_DECREF(o); });
+
+        // One Reverb for all arrays (consecutive chunks of one stream) or one per array
+        const bool single = PyObject_TypeCheck(reverbs, reverbType) != 0;
+        PyObject* reverbList = single ? nullptr : PySequence_Fast(reverbs, "reverbs must be a Reverb or a sequence of them");
+        if (!single && reverbList == nullptr)
+            return nullptr;
+        std::unique_ptr<PyObject, void (*)(PyObject*)> reverbGuard(reverbList, [](PyObject* o) { Py_XDECREF(o); });
+
+        const Py_ssize_t count = PySequence_Fast_GET_SIZE(arrayList);
+        if (!single && PySequence_Fast_GET_SIZE(reverbList) != count)
+        {
+            PyErr_SetString(PyExc_ValueError, "reverbs and arrays must have the same length");
+            return nullptr;
+        }
+
+        // Each item keeps its Reverb alive: the caller's list may change while the GIL is released
+        struct Item
+        {
+            std::unique_ptr<PyObject, void (*)(PyObject*)> reverb;
+            Engine* engine;
+            std::unique_ptr<ChannelView> view;
+            ReverbParameters start, end;
+        };
+        std::vector<Item> items;
+        std::vector<Engine*> claimed;
+        items.reserve(static_cast<size_t>(count));
+
+        auto releaseClaimed = [&claimed]
+        {
+            for (auto* engine : claimed)
+                engine->release();
+        };
+
+        for (Py_ssize_t i = 0; i < count; ++i)
+        {
+            PyObject* reverb = single ? reverbs : PySequence_Fast_GET_ITEM(reverbList, i);
+            if (PyObject_TypeCheck(reverb, reverbType) == 0)
+            {
+                releaseClaimed();
+                PyErr_SetString(PyExc_TypeError, "reverbs must contain umbra.Reverb objects");
+                return nullptr;
+            }
+
+            auto* engine = getEngine(reverb);
+            auto view = std::make_unique<ChannelView>();
+            if (engine == nullptr || !view->acquire(PySequence_Fast_GET_ITEM(arrayList, i)))
+            {
+                releaseClaimed();
+                return nullptr;
+            }
+
+            if (std::find(claimed.begin(), claimed.end(), engine) == claimed.end())
+            {
+                if (!engine->tryAcquire())
+                {
+                    releaseClaimed();
+                    setBusyError();
+                    return nullptr;
+                }
+                claimed.push_back(engine);
+            }
+
+            Py_INCREF(reverb);
+            items.push_back({ { reverb, [](PyObject* o) { Py_DECREF(o); } }, engine, std::move(view), {}, {} });
+        }
+
+        // Ramps are taken in order, so repeated engines continue where the last chunk ended
+        for (auto& item : items)
+        {
+            const auto ramp = item.engine->nextRamp();
+            item.start = ramp.first;
+            item.end = ramp.second;
+        }
+
+        bool failed = false;
+        std::string error;
+        Py_BEGIN_ALLOW_THREADS
+        try
+        {
+            for (auto& item : items)
+            {
+                auto buffer = item.view->toAudioBuffer();
+                item.engine->reverb.processRamp(buffer, item.start, item.end);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            failed = true;
+            error = e.what();
+        }
+        Py_END_ALLOW_THREADS
+
+        releaseClaimed();
+        if (failed)
+        {
+            PyErr_SetString(PyExc_RuntimeError, error.c_str());
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyMethodDef moduleMethods[] = {
+        { "process_batch", processBatch, METH_VARARGS,
+          "process_batch(reverbs, arrays)\n--\n\n"
+          "Processes many float32 arrays in place in one native call without the GIL.\n"
+          "reverbs is one Reverb (the arrays are consecutive chunks of one stream) or\n"
+          "a sequence with one Reverb per array." },
+        { nullptr, nullptr, 0, nullptr }
+    };
+
+    PyModuleDef moduleDef = {
+        PyModuleDef_HEAD_INIT,
+        "umbra",
+        "Umbra reverb engine: in-place processing of float32 arrays.",
+        -1,
+        moduleMethods,
+        nullptr, nullptr, nullptr, nullptr
+    };
+}
+
+PyMODINIT_FUNC PyInit_umbra()
+{
+    PyObject* module = PyModule_Create(&moduleDef);
+    if (module == nullptr)
+        return nullptr;
+
+    reverbType = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&reverbSpec));
+    if (reverbType == nullptr)
+    {
+        Py_DECREF(module);
+        return nullptr;
+    }
+
+    Py_INCREF(reverbType);
+    if (PyModule_AddObject(module, "Reverb", reinterpret_cast<PyObject*>(reverbType)) < 0)
+    {
+        Py_DECREF(reverbType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
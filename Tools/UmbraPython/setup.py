@@ -0,0 +1,107 @@
+"""Builds the "umbra" Python extension (the Reverb engine, see Source/UmbraModule.cpp).
+
+The engine and the JUCE modules it uses are compiled straight into the
+extension, so no Projucer export is needed. JUCE is looked up in the JUCE_DIR
+environment variable (the checkout containing "modules"), falling back to the
+location the Projucer projects use:
+
+    JUCE_DIR=~/JUCE pip install ./Tools/UmbraPython
+"""
+
+import os
+import platform
+import sys
+
+from setuptools import Extension, setup
+from setuptools.command.build_ext import build_ext
+
+here = os.path.dirname(os.path.abspath(__file__))
+engine = os.path.abspath(os.path.join(here, "..", "..", "Source"))
+juce = os.path.abspath(os.environ.get("JUCE_DIR", os.path.join(here, "..", "..", "..", "..", "..", "JUCE")))
+modules = os.path.join(juce, "modules")
+
+if not os.path.isdir(os.path.join(modules, "juce_core")):
+    sys.exit("JUCE not found in %s; set JUCE_DIR to your JUCE checkout" % juce)
+
+# Same engine sources as UmbraCLI (no plugin, editor or autotuner code)
+engine_sources = [
+    "AllpassDiffuser.cpp",
+    "CoefficientTable.cpp",
+    "DVNConvolver.cpp",
+    "DelayLine.cpp",
+    "Diffuser.cpp",
+    "EarlyReflections.cpp",
+    "EngineMemory.cpp",
+    "EngineState.cpp",
+    "FDN.cpp",
+    "FeedbackMatrix.cpp",
+    "FrozenTail.cpp",
+    "Hadamard.cpp",
+    "InputConditioner.cpp",
+    "OutputStage.cpp",
+    "RRSFilter.cpp",
+    "Reverb.cpp",
+    "SharedDVNConvolver.cpp",
+]
+
+juce_modules = ["juce_core", "juce_audio_basics", "juce_audio_formats", "juce_dsp"]
+module_suffix = ".mm" if sys.platform == "darwin" else ".cpp"
+
+define_macros = [
+    ("JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED", "1"),
+    ("JUCE_STANDALONE_APPLICATION", "0"),
+    ("JUCE_USE_CURL", "0"),
+    ("JUCE_WEB_BROWSER", "0"),
+    ("JUCE_DISPLAY_SPLASH_SCREEN", "0"),
+    ("NDEBUG", "1"),
+] + [("JUCE_MODULE_AVAILABLE_" + m, "1") for m in juce_modules]
+
+x86 = platform.machine().lower() in ("x86_64", "amd64", "i386", "i686")
+
+if sys.platform == "win32":
+    compile_args = ["/std:c++17", "/O2", "/openmp", "/EHsc", "/bigobj"] + (["/arch:AVX2"] if x86 else [])
+    link_args = []
+    libraries = ["ole32", "shell32", "user32", "advapi32", "ws2_32", "winmm", "version", "shlwapi"]
+elif sys.platform == "darwin":
+    # Apple clang needs libomp (e.g. from Homebrew) for OpenMP
+    compile_args = ["-std=c++17", "-O3", "-ffp-contract=off", "-Xpreprocessor", "-fopenmp"] + (["-mavx2", "-mf16c"] if x86 else [])
+    link_args = ["-lomp", "-framework", "Accelerate", "-framework", "AudioToolbox", "-framework", "CoreAudio",
+                 "-framework", "CoreFoundation", "-framework", "Foundation", "-framework", "IOKit"]
+    libraries = []
+else:
+    # No FMA contraction: deterministic renders must round like every other build
+    compile_args = ["-std=c++17", "-O3", "-ffp-contract=off", "-fopenmp", "-fvisibility=hidden"] + (["-mavx2", "-mf16c"] if x86 else [])
+    link_args = ["-fopenmp"]
+    libraries = ["dl", "pthread", "rt"]
+
+
+class BuildExt(build_ext):
+    """Lets the compiler take the Objective-C++ JUCE modules on macOS."""
+
+    def build_extensions(self):
+        if ".mm" not in self.compiler.src_extensions:
+            self.compiler.src_extensions.append(".mm")
+        super().build_extensions()
+
+
+extension = Extension(
+    "umbra",
+    sources=[os.path.join("Source", "UmbraModule.cpp")]
+    + [os.path.join(engine, s) for s in engine_sources]
+    + [os.path.join(modules, m, m + module_suffix) for m in juce_modules],
+    include_dirs=[os.path.join(here, "Source"), engine, modules],
+    define_macros=define_macros,
+    extra_compile_args=compile_args,
+    extra_link_args=link_args,
+    libraries=libraries,
+    language="c++",
+)
+
+setup(
+    name="umbra",
+    version="1.0.0",
+    description="Python bindings for the Umbra reverb engine",
+    ext_modules=[extension],
+    cmdclass={"build_ext": BuildExt},
+    python_requires=">=3.8",
+)